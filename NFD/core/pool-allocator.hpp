@@ -0,0 +1,180 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_CORE_POOL_ALLOCATOR_HPP
+#define NFD_CORE_POOL_ALLOCATOR_HPP
+
+#include "common.hpp"
+
+#include <algorithm>
+#include <type_traits>
+
+namespace nfd {
+
+namespace detail {
+
+/** \brief a free list of equally sized chunks
+ *
+ *  Chunks are carved from blocks of geometrically increasing size that are never returned
+ *  to the system, so memory usage stays at the high watermark of live chunks.
+ *  There is one pool per chunk size and alignment, shared by all threads that use it;
+ *  it is not thread-safe, as NFD tables are only accessed from the main thread.
+ */
+template<size_t Size, size_t Align>
+class ChunkPool : noncopyable
+{
+public:
+  static ChunkPool&
+  get()
+  {
+    // intentionally leaked, so that chunks can be freed during static destruction
+    static ChunkPool* pool = new ChunkPool;
+    return *pool;
+  }
+
+  void*
+  allocate()
+  {
+    if (m_free == nullptr) {
+      this->addBlock();
+    }
+
+    Chunk* chunk = m_free;
+    m_free = chunk->next;
+    return chunk;
+  }
+
+  void
+  deallocate(void* p)
+  {
+    Chunk* chunk = static_cast<Chunk*>(p);
+    chunk->next = m_free;
+    m_free = chunk;
+  }
+
+private:
+  ChunkPool()
+    : m_free(nullptr)
+  {
+  }
+
+  void
+  addBlock()
+  {
+    static const size_t MIN_BLOCK_CHUNKS = 16;
+    static const size_t MAX_BLOCK_CHUNKS = 4096;
+
+    size_t nChunks = std::min(MIN_BLOCK_CHUNKS << std::min<size_t>(m_blocks.size(), 8),
+                              MAX_BLOCK_CHUNKS);
+    m_blocks.emplace_back(new Chunk[nChunks]);
+
+    Chunk* block = m_blocks.back().get();
+    for (size_t i = 0; i < nChunks; ++i) {
+      block[i].next = i + 1 < nChunks ? &block[i + 1] : m_free;
+    }
+    m_free = block;
+  }
+
+private:
+  union Chunk
+  {
+    Chunk* next;
+    typename std::aligned_storage<Size, Align>::type storage;
+  };
+
+  Chunk* m_free;
+  std::vector<unique_ptr<Chunk[]>> m_blocks;
+};
+
+} // namespace detail
+
+/** \brief an allocator that takes single objects from a per-type free list
+ *
+ *  This is meant for objects that are created and destroyed at high rate, such as PIT entries
+ *  allocated with std::allocate_shared.  Allocating one object costs a few instructions and
+ *  objects are densely packed without per-allocation overhead.
+ *  Arrays of more than one object are allocated with operator new.
+ *
+ *  \warning The underlying pools are not thread-safe.
+ */
+template<typename T>
+class PoolAllocator
+{
+public:
+  typedef T value_type;
+
+  template<typename U>
+  struct rebind
+  {
+    typedef PoolAllocator<U> other;
+  };
+
+  PoolAllocator() = default;
+
+  template<typename U>
+  PoolAllocator(const PoolAllocator<U>&)
+  {
+  }
+
+  T*
+  allocate(size_t n)
+  {
+    if (n != 1) {
+      return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+    return static_cast<T*>(Pool::get().allocate());
+  }
+
+  void
+  deallocate(T* p, size_t n)
+  {
+    if (n != 1) {
+      ::operator delete(p);
+      return;
+    }
+    Pool::get().deallocate(p);
+  }
+
+private:
+  typedef detail::ChunkPool<sizeof(T), alignof(T)> Pool;
+};
+
+template<typename T, typename U>
+bool
+operator==(const PoolAllocator<T>&, const PoolAllocator<U>&)
+{
+  return true;
+}
+
+template<typename T, typename U>
+bool
+operator!=(const PoolAllocator<T>&, const PoolAllocator<U>&)
+{
+  return false;
+}
+
+} // namespace nfd
+
+#endif // NFD_CORE_POOL_ALLOCATOR_HPP
@@ -43,12 +43,6 @@ getGlobalScheduler()
   return *g_scheduler;
 }
 
-EventId
-schedule(const time::nanoseconds& after, const Scheduler::Event& event)
-{
-  return getGlobalScheduler().scheduleEvent(after, event);
-}
-
 void
 cancel(const EventId& eventId)
 {
@@ -35,23 +35,28 @@ namespace scheduler {
 using ndn::Scheduler;
 
 /** \class EventId
- *  \brief Opaque type (shared_ptr) representing ID of a scheduled event
+ *  \brief Opaque type representing ID of a scheduled event
  */
 using ndn::EventId;
 
+Scheduler&
+getGlobalScheduler();
+
 /** \brief schedule an event
+ *  \param event a callable object with signature void()
  */
+template<typename F>
 EventId
-schedule(const time::nanoseconds& after, const Scheduler::Event& event);
+schedule(const time::nanoseconds& after, F&& event)
+{
+  return getGlobalScheduler().scheduleEvent(after, std::forward<F>(event));
+}
 
 /** \brief cancel a scheduled event
  */
 void
 cancel(const EventId& eventId);
 
-Scheduler&
-getGlobalScheduler();
-
 /** \brief cancels an event automatically upon destruction
  */
 class ScopedEventId : noncopyable
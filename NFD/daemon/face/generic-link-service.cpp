@@ -40,6 +40,7 @@ GenericLinkService::Options::Options()
   : allowLocalFields(false)
   , allowFragmentation(false)
   , allowReassembly(false)
+  , allowGeoTag(false)
 {
 }
 
@@ -88,24 +89,31 @@ void
 GenericLinkService::encodeLpFields(const ndn::TagHost& netPkt, lp::Packet& lpPacket)
 {
   if (m_options.allowLocalFields) {
-    shared_ptr<lp::IncomingFaceIdTag> incomingFaceIdTag = netPkt.getTag<lp::IncomingFaceIdTag>();
+    const lp::IncomingFaceIdTag* incomingFaceIdTag = netPkt.peekTag<lp::IncomingFaceIdTag>();
     if (incomingFaceIdTag != nullptr) {
       lpPacket.add<lp::IncomingFaceIdField>(*incomingFaceIdTag);
     }
   }
 
-  shared_ptr<lp::CongestionMarkTag> congestionMarkTag = netPkt.getTag<lp::CongestionMarkTag>();
+  const lp::CongestionMarkTag* congestionMarkTag = netPkt.peekTag<lp::CongestionMarkTag>();
   if (congestionMarkTag != nullptr) {
     lpPacket.add<lp::CongestionMarkField>(*congestionMarkTag);
   }
 
-  shared_ptr<lp::HopCountTag> hopCountTag = netPkt.getTag<lp::HopCountTag>();
+  const lp::HopCountTag* hopCountTag = netPkt.peekTag<lp::HopCountTag>();
   if (hopCountTag != nullptr) {
     lpPacket.add<lp::HopCountTagField>(*hopCountTag);
   }
   else {
     lpPacket.add<lp::HopCountTagField>(0);
   }
+
+  if (m_options.allowGeoTag) {
+    const lp::GeoCordTag* geoCordTag = netPkt.peekTag<lp::GeoCordTag>();
+    if (geoCordTag != nullptr) {
+      lpPacket.add<lp::GeoTagField>(*geoCordTag);
+    }
+  }
 }
 
 void
@@ -232,12 +240,17 @@ GenericLinkService::decodeInterest(const Block& netPkt, const lp::Packet& firstP
 
   // Increment HopCount
   if (firstPkt.has<lp::HopCountTagField>()) {
-    interest->setTag(make_shared<lp::HopCountTag>(firstPkt.get<lp::HopCountTagField>() + 1));
+    interest->emplaceTag<lp::HopCountTag>(firstPkt.get<lp::HopCountTagField>() + 1);
+  }
+
+  // Position of the previous hop, used by V2V transports for deferral and suppression
+  if (firstPkt.has<lp::GeoTagField>()) {
+    interest->setTag(make_shared<lp::GeoCordTag>(firstPkt.get<lp::GeoTagField>()));
   }
 
   if (firstPkt.has<lp::NextHopFaceIdField>()) {
     if (m_options.allowLocalFields) {
-      interest->setTag(make_shared<lp::NextHopFaceIdTag>(firstPkt.get<lp::NextHopFaceIdField>()));
+      interest->emplaceTag<lp::NextHopFaceIdTag>(firstPkt.get<lp::NextHopFaceIdField>());
     }
     else {
       NFD_LOG_FACE_WARN("received NextHopFaceId, but local fields disabled: DROP");
@@ -256,7 +269,7 @@ GenericLinkService::decodeInterest(const Block& netPkt, const lp::Packet& firstP
   }
 
   if (firstPkt.has<lp::CongestionMarkField>()) {
-    interest->setTag(make_shared<lp::CongestionMarkTag>(firstPkt.get<lp::CongestionMarkField>()));
+    interest->emplaceTag<lp::CongestionMarkTag>(firstPkt.get<lp::CongestionMarkField>());
   }
 
   this->receiveInterest(*interest);
@@ -271,7 +284,11 @@ GenericLinkService::decodeData(const Block& netPkt, const lp::Packet& firstPkt)
   auto data = make_shared<Data>(netPkt);
 
   if (firstPkt.has<lp::HopCountTagField>()) {
-    data->setTag(make_shared<lp::HopCountTag>(firstPkt.get<lp::HopCountTagField>() + 1));
+    data->emplaceTag<lp::HopCountTag>(firstPkt.get<lp::HopCountTagField>() + 1);
+  }
+
+  if (firstPkt.has<lp::GeoTagField>()) {
+    data->setTag(make_shared<lp::GeoCordTag>(firstPkt.get<lp::GeoTagField>()));
   }
 
   if (firstPkt.has<lp::NackField>()) {
@@ -290,7 +307,7 @@ GenericLinkService::decodeData(const Block& netPkt, const lp::Packet& firstPkt)
     if (m_options.allowLocalFields) {
       // In case of an invalid CachePolicyType, get<lp::CachePolicyField> will throw,
       // so it's unnecessary to check here.
-      data->setTag(make_shared<lp::CachePolicyTag>(firstPkt.get<lp::CachePolicyField>()));
+      data->emplaceTag<lp::CachePolicyTag>(firstPkt.get<lp::CachePolicyField>());
     }
     else {
       NFD_LOG_FACE_WARN("received CachePolicy, but local fields disabled: IGNORE");
@@ -302,7 +319,7 @@ GenericLinkService::decodeData(const Block& netPkt, const lp::Packet& firstPkt)
   }
 
   if (firstPkt.has<lp::CongestionMarkField>()) {
-    data->setTag(make_shared<lp::CongestionMarkTag>(firstPkt.get<lp::CongestionMarkField>()));
+    data->emplaceTag<lp::CongestionMarkTag>(firstPkt.get<lp::CongestionMarkField>());
   }
 
   this->receiveData(*data);
@@ -334,7 +351,7 @@ GenericLinkService::decodeNack(const Block& netPkt, const lp::Packet& firstPkt)
   }
 
   if (firstPkt.has<lp::CongestionMarkField>()) {
-    nack.setTag(make_shared<lp::CongestionMarkTag>(firstPkt.get<lp::CongestionMarkField>()));
+    nack.emplaceTag<lp::CongestionMarkTag>(firstPkt.get<lp::CongestionMarkField>());
   }
 
   this->receiveNack(nack);
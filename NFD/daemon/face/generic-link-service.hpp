@@ -107,6 +107,13 @@ public:
     /** \brief options for reassembly
      */
     LpReassembler::Options reassemblerOptions;
+
+    /** \brief enables encoding of GeoTag from GeoCordTag
+     *
+     *  Only faces whose transport is a V2V transport should enable this, so that the position
+     *  of a V2V sender is not carried over other links.
+     */
+    bool allowGeoTag;
   };
 
   /** \brief counters provided by GenericLinkService
@@ -122,7 +122,7 @@ Forwarder::onIncomingInterest(Face& inFace, const Interest& interest)
   // receive Interest
   NFD_LOG_DEBUG("onIncomingInterest face=" << inFace.getId() <<
                 " interest=" << interest.getName());
-  interest.setTag(make_shared<lp::IncomingFaceIdTag>(inFace.getId()));
+  interest.emplaceTag<lp::IncomingFaceIdTag>(inFace.getId());
   ++m_counters.nInInterests;
 
   // /localhost scope control
@@ -216,7 +216,7 @@ Forwarder::onContentStoreMiss(const Face& inFace, const shared_ptr<pit::Entry>&
   this->setUnsatisfyTimer(pitEntry);
 
   // has NextHopFaceId?
-  shared_ptr<lp::NextHopFaceIdTag> nextHopTag = interest.getTag<lp::NextHopFaceIdTag>();
+  const lp::NextHopFaceIdTag* nextHopTag = interest.peekTag<lp::NextHopFaceIdTag>();
   if (nextHopTag != nullptr) {
     // chosen NextHop face exists?
     Face* nextHopFace = m_faceTable.get(*nextHopTag);
@@ -244,7 +244,7 @@ Forwarder::onContentStoreHit(const Face& inFace, const shared_ptr<pit::Entry>& p
   this->dispatchToStrategy(*pitEntry,
     [&] (fw::Strategy& strategy) { strategy.beforeSatisfyInterest(pitEntry, *m_csFace, data); });
 
-  data.setTag(make_shared<lp::IncomingFaceIdTag>(face::FACEID_CONTENT_STORE));
+  data.emplaceTag<lp::IncomingFaceIdTag>(face::FACEID_CONTENT_STORE);
   // XXX should we lookup PIT for other Interests that also match csMatch?
 
   // set PIT straggler timer
@@ -319,7 +319,7 @@ Forwarder::onIncomingData(Face& inFace, const Data& data)
 {
   // receive Data
   NFD_LOG_DEBUG("onIncomingData face=" << inFace.getId() << " data=" << data.getName());
-  data.setTag(make_shared<lp::IncomingFaceIdTag>(inFace.getId()));
+  data.emplaceTag<lp::IncomingFaceIdTag>(inFace.getId());
   ++m_counters.nInData;
 
   // /localhost scope control
@@ -342,6 +342,7 @@ Forwarder::onIncomingData(Face& inFace, const Data& data)
 
   shared_ptr<Data> dataCopyWithoutTag = make_shared<Data>(data);
   dataCopyWithoutTag->removeTag<lp::HopCountTag>();
+  dataCopyWithoutTag->removeTag<lp::GeoCordTag>();
 
   // CS insert
   if (m_csFromNdnSim == nullptr)
@@ -439,7 +440,7 @@ void
 Forwarder::onIncomingNack(Face& inFace, const lp::Nack& nack)
 {
   // receive Nack
-  nack.setTag(make_shared<lp::IncomingFaceIdTag>(inFace.getId()));
+  nack.emplaceTag<lp::IncomingFaceIdTag>(inFace.getId());
   ++m_counters.nInNacks;
 
   // if multi-access face, drop
@@ -213,7 +213,7 @@ FaceManager::updateFace(const Name& topPrefix, const Interest& interest,
   FaceId faceId = parameters.getFaceId();
   if (faceId == 0) {
     // Self-updating
-    shared_ptr<lp::IncomingFaceIdTag> incomingFaceIdTag = interest.getTag<lp::IncomingFaceIdTag>();
+    const lp::IncomingFaceIdTag* incomingFaceIdTag = interest.peekTag<lp::IncomingFaceIdTag>();
     if (incomingFaceIdTag == nullptr) {
       NFD_LOG_TRACE("unable to determine face for self-update");
       done(ControlResponse(404, "No FaceId specified and IncomingFaceId not available"));
@@ -338,7 +338,7 @@ FaceManager::findFaceForLocalControl(const Interest& request,
                                      const ControlParameters& parameters,
                                      const ndn::mgmt::CommandContinuation& done)
 {
-  shared_ptr<lp::IncomingFaceIdTag> incomingFaceIdTag = request.getTag<lp::IncomingFaceIdTag>();
+  const lp::IncomingFaceIdTag* incomingFaceIdTag = request.peekTag<lp::IncomingFaceIdTag>();
   // NDNLPv2 says "application MUST be prepared to receive a packet without IncomingFaceId field",
   // but it's fine to assert IncomingFaceId is available, because InternalFace lives inside NFD
   // and is initialized synchronously with IncomingFaceId field enabled.
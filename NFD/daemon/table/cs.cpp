@@ -24,6 +24,7 @@
  */
 
 #include "cs.hpp"
+#include "name-tree-hashtable.hpp"
 #include "core/logger.hpp"
 #include "core/algorithm.hpp"
 #include <ndn-cxx/lp/tags.hpp>
@@ -90,7 +91,7 @@ Cs::insert(const Data& data, bool isUnsolicited)
   }
 
   // recognize CachePolicy
-  shared_ptr<lp::CachePolicyTag> tag = data.getTag<lp::CachePolicyTag>();
+  const lp::CachePolicyTag* tag = data.peekTag<lp::CachePolicyTag>();
   if (tag != nullptr) {
     lp::CachePolicyType policy = tag->get().getPolicy();
     if (policy == lp::CachePolicyType::NO_CACHE) {
@@ -115,6 +116,7 @@ Cs::insert(const Data& data, bool isUnsolicited)
     m_policy->afterRefresh(it);
   }
   else {
+    this->insertIndex(it);
     m_policy->afterInsert(it);
   }
 }
@@ -131,6 +133,23 @@ Cs::find(const Interest& interest,
   bool isRightmost = interest.getChildSelector() == 1;
   NFD_LOG_DEBUG("find " << prefix << (isRightmost ? " R" : " L"));
 
+  if (!isRightmost) {
+    iterator match = this->findExact(interest);
+    if (match != m_table.end()) {
+      NFD_LOG_DEBUG("  matching-exact " << match->getName());
+      m_policy->beforeUse(match);
+      hitCallback(interest, match->getData());
+      return;
+    }
+
+    // only entries with the exact Name can match an Interest with implicit digest
+    if (!prefix.empty() && prefix[-1].isImplicitSha256Digest()) {
+      NFD_LOG_DEBUG("  no-match");
+      missCallback(interest);
+      return;
+    }
+  }
+
   iterator first = m_table.lower_bound(prefix);
   iterator last = m_table.end();
   if (prefix.size() > 0) {
@@ -155,6 +174,32 @@ Cs::find(const Interest& interest,
   hitCallback(interest, match->getData());
 }
 
+iterator
+Cs::findExact(const Interest& interest) const
+{
+  const Name& name = interest.getName();
+  size_t nameLen = name.size();
+  if (nameLen > 0 && name[-1].isImplicitSha256Digest()) {
+    --nameLen;
+  }
+
+  auto range = m_exactIndex.equal_range(name_tree::computeHash(name, nameLen));
+  for (auto i = range.first; i != range.second; ++i) {
+    const Name& dataName = i->second->getName();
+    if (dataName.size() != nameLen || name.compare(0, nameLen, dataName) != 0) {
+      continue; // hash collision
+    }
+
+    for (iterator it = i->second; it != m_table.end() && it->getName() == dataName; ++it) {
+      if (it->canSatisfy(interest)) {
+        return it;
+      }
+    }
+    break;
+  }
+  return m_table.end();
+}
+
 iterator
 Cs::findLeftmost(const Interest& interest, iterator first, iterator last) const
 {
@@ -205,6 +250,7 @@ Cs::setPolicyImpl(unique_ptr<Policy> policy)
   NFD_LOG_DEBUG("set-policy " << policy->getName());
   m_policy = std::move(policy);
   m_beforeEvictConnection = m_policy->beforeEvict.connect([this] (iterator it) {
+      this->eraseIndex(it);
       m_table.erase(it);
     });
 
@@ -212,6 +258,53 @@ Cs::setPolicyImpl(unique_ptr<Policy> policy)
   BOOST_ASSERT(m_policy->getCs() == this);
 }
 
+void
+Cs::insertIndex(iterator it)
+{
+  const Name& name = it->getName();
+  if (it != m_table.begin() && std::prev(it)->getName() == name) {
+    return; // not the first entry of this Name
+  }
+
+  name_tree::HashValue h = name_tree::computeHash(name);
+  iterator next = std::next(it);
+  if (next != m_table.end() && next->getName() == name) {
+    // it now precedes the entry that was first
+    auto range = m_exactIndex.equal_range(h);
+    auto i = std::find_if(range.first, range.second,
+                          [next] (const std::pair<const size_t, iterator>& item) {
+                            return item.second == next;
+                          });
+    BOOST_ASSERT(i != range.second);
+    i->second = it;
+    return;
+  }
+
+  m_exactIndex.emplace(h, it);
+}
+
+void
+Cs::eraseIndex(iterator it)
+{
+  const Name& name = it->getName();
+  auto range = m_exactIndex.equal_range(name_tree::computeHash(name));
+  auto i = std::find_if(range.first, range.second,
+                        [it] (const std::pair<const size_t, iterator>& item) {
+                          return item.second == it;
+                        });
+  if (i == range.second) {
+    return; // not the first entry of this Name
+  }
+
+  iterator next = std::next(it);
+  if (next != m_table.end() && next->getName() == name) {
+    i->second = next;
+  }
+  else {
+    m_exactIndex.erase(i);
+  }
+}
+
 void
 Cs::dump()
 {
@@ -43,6 +43,11 @@
  *  Within each queue, the iterators are kept in first-in-first-out order.
  *  Eviction procedure exhausts the first queue before moving onto the next queue,
  *  in the order of unsolicited, stale, and fresh queue.
+ *
+ *  In addition, an exact-name index (hash table) refers to the first Table entry of every
+ *  Data Name.  Entries whose Data Name equals the Interest Name (without implicit digest)
+ *  precede any other match in the Table, so a lookup with leftmost child selector tries them
+ *  first in O(1), and searches the Table only if none of them can satisfy the Interest.
  */
 
 #ifndef NFD_DAEMON_TABLE_CS_HPP
@@ -177,11 +182,30 @@ private: // find
   iterator
   findRightmostAmongExact(const Interest& interest, iterator first, iterator last) const;
 
+  /** \brief find leftmost match among entries whose Data Name equals the Interest Name
+   *         without implicit digest
+   *  \return the leftmost match, or m_table.end() if not found
+   */
+  iterator
+  findExact(const Interest& interest) const;
+
   void
   setPolicyImpl(unique_ptr<Policy> policy);
 
+private: // exact-name index
+  /** \brief add \p it to the exact-name index, if it is the first entry of its Data Name
+   */
+  void
+  insertIndex(iterator it);
+
+  /** \brief remove \p it from the exact-name index, before it is erased from the Table
+   */
+  void
+  eraseIndex(iterator it);
+
 private:
   Table m_table;
+  std::unordered_multimap<size_t, iterator> m_exactIndex; ///< keyed by hash of Data Name
   unique_ptr<Policy> m_policy;
   ndn::util::signal::ScopedConnection m_beforeEvictConnection;
 };
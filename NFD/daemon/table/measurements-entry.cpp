@@ -28,9 +28,14 @@
 namespace nfd {
 namespace measurements {
 
+constexpr size_t Entry::NOT_QUEUED;
+
 Entry::Entry(const Name& name)
   : m_name(name)
   , m_expiry(time::steady_clock::TimePoint::min())
+  , m_expiryPrev(nullptr)
+  , m_expiryNext(nullptr)
+  , m_expiryQueue(NOT_QUEUED)
   , m_nameTreeEntry(nullptr)
 {
 }
@@ -56,6 +56,13 @@ private:
   time::steady_clock::TimePoint m_expiry;
   scheduler::EventId m_cleanup;
 
+  // position in Measurements expiry queue, used when entries expire lazily
+  Entry* m_expiryPrev;
+  Entry* m_expiryNext;
+  size_t m_expiryQueue; ///< index of the queue, or NOT_QUEUED
+
+  static constexpr size_t NOT_QUEUED = std::numeric_limits<size_t>::max();
+
   name_tree::Entry* m_nameTreeEntry;
 
   friend class Measurements;
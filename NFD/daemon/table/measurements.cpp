@@ -28,13 +28,31 @@
 #include "pit-entry.hpp"
 #include "fib-entry.hpp"
 
+#include <algorithm>
+
 namespace nfd {
 namespace measurements {
 
 Measurements::Measurements(NameTree& nameTree)
   : m_nameTree(nameTree)
   , m_nItems(0)
+  , m_sweepInterval(time::nanoseconds::zero())
+{
+}
+
+Measurements::~Measurements()
+{
+  scheduler::cancel(m_sweep);
+}
+
+void
+Measurements::setSweepInterval(const time::nanoseconds& sweepInterval)
 {
+  BOOST_ASSERT(m_nItems == 0);
+
+  m_sweepInterval = sweepInterval;
+  m_expiryQueues.clear();
+  scheduler::cancel(m_sweep);
 }
 
 Entry&
@@ -42,16 +60,20 @@ Measurements::get(name_tree::Entry& nte)
 {
   Entry* entry = nte.getMeasurementsEntry();
   if (entry != nullptr) {
-    return *entry;
+    if (!isExpired(*entry)) {
+      return *entry;
+    }
+    // replace the expired entry, keeping the name tree entry
+    unlinkExpiry(*entry);
+    nte.setMeasurementsEntry(nullptr);
+    --m_nItems;
   }
 
   nte.setMeasurementsEntry(make_unique<Entry>(nte.getName()));
   ++m_nItems;
   entry = nte.getMeasurementsEntry();
 
-  entry->m_expiry = time::steady_clock::now() + getInitialLifetime();
-  entry->m_cleanup = scheduler::schedule(getInitialLifetime(),
-                                         bind(&Measurements::cleanup, this, ref(*entry)));
+  this->setExpiry(*entry, getInitialLifetime());
 
   return *entry;
 }
@@ -95,9 +117,9 @@ Entry*
 Measurements::findLongestPrefixMatchImpl(const K& key, const EntryPredicate& pred) const
 {
   name_tree::Entry* match = m_nameTree.findLongestPrefixMatch(key,
-    [&pred] (const name_tree::Entry& nte) {
+    [this, &pred] (const name_tree::Entry& nte) {
       const Entry* entry = nte.getMeasurementsEntry();
-      return entry != nullptr && pred(*entry);
+      return entry != nullptr && !this->isExpired(*entry) && pred(*entry);
     });
   if (match != nullptr) {
     return match->getMeasurementsEntry();
@@ -121,7 +143,12 @@ Entry*
 Measurements::findExactMatch(const Name& name) const
 {
   const name_tree::Entry* nte = m_nameTree.findExactMatch(name);
-  return nte == nullptr ? nullptr : nte->getMeasurementsEntry();
+  if (nte == nullptr) {
+    return nullptr;
+  }
+
+  Entry* entry = nte->getMeasurementsEntry();
+  return entry == nullptr || isExpired(*entry) ? nullptr : entry;
 }
 
 void
@@ -135,9 +162,7 @@ Measurements::extendLifetime(Entry& entry, const time::nanoseconds& lifetime)
     return;
   }
 
-  scheduler::cancel(entry.m_cleanup);
-  entry.m_expiry = expiry;
-  entry.m_cleanup = scheduler::schedule(lifetime, bind(&Measurements::cleanup, this, ref(entry)));
+  this->setExpiry(entry, lifetime);
 }
 
 void
@@ -146,10 +171,103 @@ Measurements::cleanup(Entry& entry)
   name_tree::Entry* nte = m_nameTree.getEntry(entry);
   BOOST_ASSERT(nte != nullptr);
 
+  unlinkExpiry(entry);
   nte->setMeasurementsEntry(nullptr);
   m_nameTree.eraseIfEmpty(nte);
   --m_nItems;
 }
 
+bool
+Measurements::isExpired(const Entry& entry) const
+{
+  return m_sweepInterval > time::nanoseconds::zero() &&
+         entry.m_expiry <= time::steady_clock::now();
+}
+
+void
+Measurements::setExpiry(Entry& entry, const time::nanoseconds& lifetime)
+{
+  entry.m_expiry = time::steady_clock::now() + lifetime;
+
+  if (m_sweepInterval <= time::nanoseconds::zero()) {
+    scheduler::cancel(entry.m_cleanup);
+    entry.m_cleanup = scheduler::schedule(lifetime, bind(&Measurements::cleanup, this, ref(entry)));
+    return;
+  }
+
+  // entries enter a queue in the order of now(), so that the queue stays sorted by expiry
+  auto it = std::find_if(m_expiryQueues.begin(), m_expiryQueues.end(),
+                         [&lifetime] (const ExpiryQueue& queue) { return queue.lifetime == lifetime; });
+  if (it == m_expiryQueues.end()) {
+    it = m_expiryQueues.insert(it, ExpiryQueue{lifetime, nullptr, nullptr});
+  }
+
+  unlinkExpiry(entry);
+  entry.m_expiryQueue = std::distance(m_expiryQueues.begin(), it);
+  entry.m_expiryPrev = it->tail;
+  entry.m_expiryNext = nullptr;
+  if (it->tail == nullptr) {
+    it->head = &entry;
+  }
+  else {
+    it->tail->m_expiryNext = &entry;
+  }
+  it->tail = &entry;
+
+  this->scheduleSweep();
+}
+
+void
+Measurements::unlinkExpiry(Entry& entry)
+{
+  if (m_sweepInterval <= time::nanoseconds::zero()) {
+    scheduler::cancel(entry.m_cleanup);
+    return;
+  }
+
+  if (entry.m_expiryQueue == Entry::NOT_QUEUED) {
+    return;
+  }
+
+  ExpiryQueue& queue = m_expiryQueues[entry.m_expiryQueue];
+  if (entry.m_expiryPrev == nullptr) {
+    queue.head = entry.m_expiryNext;
+  }
+  else {
+    entry.m_expiryPrev->m_expiryNext = entry.m_expiryNext;
+  }
+  if (entry.m_expiryNext == nullptr) {
+    queue.tail = entry.m_expiryPrev;
+  }
+  else {
+    entry.m_expiryNext->m_expiryPrev = entry.m_expiryPrev;
+  }
+  entry.m_expiryPrev = entry.m_expiryNext = nullptr;
+  entry.m_expiryQueue = Entry::NOT_QUEUED;
+}
+
+void
+Measurements::scheduleSweep()
+{
+  if (!m_sweep) {
+    m_sweep = scheduler::schedule(m_sweepInterval, bind(&Measurements::sweep, this));
+  }
+}
+
+void
+Measurements::sweep()
+{
+  time::steady_clock::TimePoint now = time::steady_clock::now();
+  for (ExpiryQueue& queue : m_expiryQueues) {
+    while (queue.head != nullptr && queue.head->m_expiry <= now) {
+      this->cleanup(*queue.head);
+    }
+  }
+
+  if (m_nItems > 0) {
+    this->scheduleSweep();
+  }
+}
+
 } // namespace measurements
 } // namespace nfd
@@ -71,6 +71,15 @@ public:
 };
 
 /** \brief represents the Measurements table
+ *
+ *  By default, every entry has a scheduler event that erases it when its lifetime ends, and
+ *  this event is rescheduled whenever the lifetime is extended.
+ *
+ *  With a nonzero sweep interval, entries instead expire lazily: an expired entry is treated
+ *  as absent by lookups, replaced by a new entry when it is requested with get(), and erased
+ *  by a periodic sweep.  To find expired entries in O(1) each, entries are kept in FIFO
+ *  queues, one per lifetime passed to extendLifetime, in which expiry time is nondecreasing.
+ *  Only one scheduler event, the next sweep, is pending at any time.
  */
 class Measurements : noncopyable
 {
@@ -78,6 +87,15 @@ public:
   explicit
   Measurements(NameTree& nametree);
 
+  ~Measurements();
+
+  /** \brief set the interval of the sweep that erases expired entries
+   *  \param sweepInterval the interval; zero selects one cleanup event per entry
+   *  \pre the table is empty
+   */
+  void
+  setSweepInterval(const time::nanoseconds& sweepInterval);
+
   /** \brief find or insert a Measurements entry for \p name
    */
   Entry&
@@ -122,10 +140,15 @@ public:
   /** \brief extend lifetime of an entry
    *
    *  The entry will be kept until at least now()+lifetime.
+   *  \note With a nonzero sweep interval, each distinct \p lifetime adds an expiry queue;
+   *        callers are expected to use a few constant lifetimes.
    */
   void
   extendLifetime(Entry& entry, const time::nanoseconds& lifetime);
 
+  /** \return number of entries
+   *  \note With a nonzero sweep interval, this includes expired entries not yet erased.
+   */
   size_t
   size() const;
 
@@ -133,6 +156,25 @@ private:
   void
   cleanup(Entry& entry);
 
+  bool
+  isExpired(const Entry& entry) const;
+
+  /** \brief set expiry of \p entry to now()+lifetime and (re)schedule its cleanup
+   */
+  void
+  setExpiry(Entry& entry, const time::nanoseconds& lifetime);
+
+  void
+  unlinkExpiry(Entry& entry);
+
+  void
+  scheduleSweep();
+
+  /** \brief erase all expired entries
+   */
+  void
+  sweep();
+
   Entry&
   get(name_tree::Entry& nte);
 
@@ -143,8 +185,19 @@ private:
   findLongestPrefixMatchImpl(const K& key, const EntryPredicate& pred) const;
 
 private:
+  struct ExpiryQueue
+  {
+    time::nanoseconds lifetime;
+    Entry* head;
+    Entry* tail;
+  };
+
   NameTree& m_nameTree;
   size_t m_nItems;
+
+  time::nanoseconds m_sweepInterval;
+  std::vector<ExpiryQueue> m_expiryQueues;
+  scheduler::EventId m_sweep;
 };
 
 inline time::nanoseconds
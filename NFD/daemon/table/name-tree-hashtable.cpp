@@ -27,6 +27,10 @@
 #include "core/logger.hpp"
 #include "core/city-hash.hpp"
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
 namespace nfd {
 namespace name_tree {
 
@@ -56,13 +60,61 @@ public:
  */
 typedef std::conditional<(sizeof(HashValue) > 4), Hash64, Hash32>::type HashFunc;
 
+/** \brief compute hash values of the prefixes of \p name longer than those in \p cached
+ */
+static shared_ptr<const HashSequence>
+extendHashes(const Name& name, const HashSequence* cached)
+{
+  name.wireEncode(); // ensure wire buffer exists
+
+  auto seq = make_shared<HashSequence>();
+  seq->reserve(name.size() + 1);
+
+  if (cached == nullptr || cached->empty()) {
+    seq->push_back(0);
+  }
+  else {
+    seq->assign(cached->begin(), cached->end());
+  }
+
+  HashValue h = seq->back();
+  for (size_t i = seq->size() - 1; i < name.size(); ++i) {
+    const name::Component& comp = name[i];
+    h ^= HashFunc::compute(comp.wire(), comp.size());
+    seq->push_back(h);
+  }
+  return seq;
+}
+
+const HashSequence&
+getHashes(const Name& name)
+{
+  const shared_ptr<const HashSequence>& cached = name.getCachedPrefixHashes();
+  if (cached != nullptr && cached->size() > name.size()) {
+    return *cached;
+  }
+
+  name.setCachedPrefixHashes(extendHashes(name, cached.get()));
+  return *name.getCachedPrefixHashes();
+}
+
 HashValue
 computeHash(const Name& name, ssize_t prefixLen)
 {
+  size_t last = prefixLen < 0 ? name.size() : prefixLen;
+
+  const shared_ptr<const HashSequence>& cached = name.getCachedPrefixHashes();
+  if (cached != nullptr && cached->size() > last) {
+    return (*cached)[last];
+  }
+  if (last == name.size()) {
+    return getHashes(name)[last];
+  }
+
   name.wireEncode(); // ensure wire buffer exists
 
   HashValue h = 0;
-  for (size_t i = 0, last = prefixLen < 0 ? name.size() : prefixLen; i < last; ++i) {
+  for (size_t i = 0; i < last; ++i) {
     const name::Component& comp = name[i];
     h ^= HashFunc::compute(comp.wire(), comp.size());
   }
@@ -72,19 +124,8 @@ computeHash(const Name& name, ssize_t prefixLen)
 HashSequence
 computeHashes(const Name& name)
 {
-  name.wireEncode(); // ensure wire buffer exists
-
-  HashSequence seq;
-  seq.reserve(name.size() + 1);
-
-  HashValue h = 0;
-  seq.push_back(h);
-
-  for (const name::Component& comp : name) {
-    h ^= HashFunc::compute(comp.wire(), comp.size());
-    seq.push_back(h);
-  }
-  return seq;
+  const HashSequence& hashes = getHashes(name);
+  return HashSequence(hashes.begin(), hashes.begin() + name.size() + 1);
 }
 
 Node::Node(HashValue h, const Name& name)
@@ -107,6 +148,131 @@ getNode(const Entry& entry)
   return entry.m_node;
 }
 
+NodeArena::NodeArena()
+  : m_capacity(0)
+  , m_nUsedInLastBlock(0)
+  , m_lastBlockSize(0)
+  , m_freeList(nullptr)
+  , m_nAllocated(0)
+{
+}
+
+NodeArena::~NodeArena()
+{
+  BOOST_ASSERT(m_nAllocated == 0);
+}
+
+Node*
+NodeArena::allocate(HashValue h, const Name& name)
+{
+  static const size_t MIN_BLOCK_SIZE = 16;
+  static const size_t MAX_BLOCK_SIZE = 4096;
+
+  Slot* slot = m_freeList;
+  if (slot != nullptr) {
+    m_freeList = slot->nextFree;
+  }
+  else {
+    if (m_nUsedInLastBlock == m_lastBlockSize) {
+      m_lastBlockSize = std::min(std::max(m_capacity, MIN_BLOCK_SIZE), MAX_BLOCK_SIZE);
+      m_blocks.emplace_back(new Slot[m_lastBlockSize]);
+      m_capacity += m_lastBlockSize;
+      m_nUsedInLastBlock = 0;
+    }
+    slot = &m_blocks.back()[m_nUsedInLastBlock++];
+  }
+
+  ++m_nAllocated;
+  return new (&slot->storage) Node(h, name);
+}
+
+void
+NodeArena::deallocate(Node* node)
+{
+  BOOST_ASSERT(m_nAllocated > 0);
+  node->~Node();
+
+  Slot* slot = reinterpret_cast<Slot*>(node);
+  slot->nextFree = m_freeList;
+  m_freeList = slot;
+  --m_nAllocated;
+}
+
+size_t
+NodeArena::getMemoryUsage() const
+{
+  return m_capacity * sizeof(Slot);
+}
+
+/** \brief bucket tags of HashtableLayout::OPEN_ADDRESSING
+ *
+ *  An occupied bucket is tagged with the lowest 7 bits of the hash value of its node.
+ *  Free buckets have the highest bit set.
+ */
+enum : uint8_t {
+  TAG_EMPTY = 0x80,
+  TAG_ERASED = 0xFE
+};
+
+/** \brief number of buckets probed at once
+ */
+static const size_t GROUP_SIZE = 16;
+
+static uint8_t
+computeTag(HashValue h)
+{
+  return static_cast<uint8_t>(h & 0x7F);
+}
+
+/** \return index of the first group in the probe sequence of h
+ */
+static size_t
+computeGroupIndex(HashValue h, size_t nGroups)
+{
+  return (h >> 7) & (nGroups - 1);
+}
+
+/** \return bitmask of the buckets in group whose tag equals tag
+ */
+static uint32_t
+matchTag(const uint8_t* group, uint8_t tag)
+{
+#ifdef __SSE2__
+  __m128i tags = _mm_loadu_si128(reinterpret_cast<const __m128i*>(group));
+  return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(tags, _mm_set1_epi8(tag))));
+#else
+  uint32_t mask = 0;
+  for (size_t i = 0; i < GROUP_SIZE; ++i) {
+    mask |= static_cast<uint32_t>(group[i] == tag) << i;
+  }
+  return mask;
+#endif // __SSE2__
+}
+
+/** \return bitmask of the empty or erased buckets in group
+ */
+static uint32_t
+matchFree(const uint8_t* group)
+{
+#ifdef __SSE2__
+  __m128i tags = _mm_loadu_si128(reinterpret_cast<const __m128i*>(group));
+  return static_cast<uint32_t>(_mm_movemask_epi8(tags));
+#else
+  uint32_t mask = 0;
+  for (size_t i = 0; i < GROUP_SIZE; ++i) {
+    mask |= static_cast<uint32_t>(group[i] >> 7) << i;
+  }
+  return mask;
+#endif // __SSE2__
+}
+
+static size_t
+findFirstBit(uint32_t mask)
+{
+  BOOST_ASSERT(mask != 0);
+  return __builtin_ctz(mask);
+}
+
 HashtableOptions::HashtableOptions(size_t size)
   : initialSize(size)
   , minSize(size)
@@ -116,6 +282,7 @@ HashtableOptions::HashtableOptions(size_t size)
 Hashtable::Hashtable(const Options& options)
   : m_options(options)
   , m_size(0)
+  , m_nErased(0)
 {
   BOOST_ASSERT(m_options.minSize > 0);
   BOOST_ASSERT(m_options.initialSize >= m_options.minSize);
@@ -127,20 +294,61 @@ Hashtable::Hashtable(const Options& options)
   BOOST_ASSERT(m_options.shrinkFactor > 0.0);
   BOOST_ASSERT(m_options.shrinkFactor < 1.0);
 
-  m_buckets.resize(options.initialSize);
+  m_buckets.resize(this->adjustNBuckets(options.initialSize));
+  if (m_options.layout == HashtableLayout::OPEN_ADDRESSING) {
+    m_tags.assign(m_buckets.size(), TAG_EMPTY);
+  }
   this->computeThresholds();
 }
 
 Hashtable::~Hashtable()
 {
   for (size_t i = 0; i < m_buckets.size(); ++i) {
-    foreachNode(m_buckets[i], [] (Node* node) {
+    foreachNode(m_buckets[i], [this] (Node* node) {
       node->prev = node->next = nullptr;
-      delete node;
+      if (m_options.layout == HashtableLayout::OPEN_ADDRESSING) {
+        m_arena.deallocate(node);
+      }
+      else {
+        delete node;
+      }
     });
   }
 }
 
+size_t
+Hashtable::getMemoryUsage() const
+{
+  size_t nBytes = m_buckets.capacity() * sizeof(Node*) + m_tags.capacity();
+  if (m_options.layout == HashtableLayout::OPEN_ADDRESSING) {
+    return nBytes + m_arena.getMemoryUsage();
+  }
+  return nBytes + m_size * sizeof(Node);
+}
+
+size_t
+Hashtable::getBucketIndex(const Node* node) const
+{
+  if (m_options.layout != HashtableLayout::OPEN_ADDRESSING) {
+    return this->computeBucketIndex(node->hash);
+  }
+
+  size_t nGroups = m_buckets.size() / GROUP_SIZE;
+  uint8_t tag = computeTag(node->hash);
+  size_t group = computeGroupIndex(node->hash, nGroups);
+  for (size_t i = 1; ; ++i) {
+    size_t first = group * GROUP_SIZE;
+    for (uint32_t match = matchTag(&m_tags[first], tag); match != 0; match &= match - 1) {
+      size_t bucket = first + findFirstBit(match);
+      if (m_buckets[bucket] == node) {
+        return bucket;
+      }
+    }
+    BOOST_ASSERT(i < nGroups);
+    group = (group + i) & (nGroups - 1);
+  }
+}
+
 void
 Hashtable::attach(size_t bucket, Node* node)
 {
@@ -178,6 +386,10 @@ Hashtable::detach(size_t bucket, Node* node)
 std::pair<const Node*, bool>
 Hashtable::findOrInsert(const Name& name, size_t prefixLen, HashValue h, bool allowInsert)
 {
+  if (m_options.layout == HashtableLayout::OPEN_ADDRESSING) {
+    return this->findOrInsertOpen(name, prefixLen, h, allowInsert);
+  }
+
   size_t bucket = this->computeBucketIndex(h);
 
   for (const Node* node = m_buckets[bucket]; node != nullptr; node = node->next) {
@@ -204,6 +416,73 @@ Hashtable::findOrInsert(const Name& name, size_t prefixLen, HashValue h, bool al
   return {node, true};
 }
 
+std::pair<const Node*, bool>
+Hashtable::findOrInsertOpen(const Name& name, size_t prefixLen, HashValue h, bool allowInsert)
+{
+  // triangular probing visits every group when the number of groups is a power of two
+  size_t nGroups = m_buckets.size() / GROUP_SIZE;
+  uint8_t tag = computeTag(h);
+  size_t group = computeGroupIndex(h, nGroups);
+  for (size_t i = 1; ; ++i) {
+    const uint8_t* tags = &m_tags[group * GROUP_SIZE];
+    for (uint32_t match = matchTag(tags, tag); match != 0; match &= match - 1) {
+      const Node* node = m_buckets[group * GROUP_SIZE + findFirstBit(match)];
+      if (node->hash == h && name.compare(0, prefixLen, node->entry.getName()) == 0) {
+        NFD_LOG_TRACE("found " << name.getPrefix(prefixLen) << " hash=" << h << " group=" << group);
+        return {node, false};
+      }
+    }
+
+    // a group with an empty bucket has never been full, so no probe sequence continues past it
+    if (matchTag(tags, TAG_EMPTY) != 0 || i == nGroups) {
+      break;
+    }
+    group = (group + i) & (nGroups - 1);
+  }
+
+  if (!allowInsert) {
+    NFD_LOG_TRACE("not-found " << name.getPrefix(prefixLen) << " hash=" << h);
+    return {nullptr, false};
+  }
+
+  size_t bucket = this->findFreeBucket(h);
+  if (m_tags[bucket] == TAG_ERASED) {
+    --m_nErased;
+  }
+  Node* node = m_arena.allocate(h, name.getPrefix(prefixLen));
+  m_buckets[bucket] = node;
+  m_tags[bucket] = tag;
+  NFD_LOG_TRACE("insert " << node->entry.getName() << " hash=" << h << " bucket=" << bucket);
+  ++m_size;
+
+  if (m_size + m_nErased > m_expandThreshold) {
+    if (m_nErased >= m_size) {
+      this->resize(this->getNBuckets()); // only purge erased buckets
+    }
+    else {
+      this->resize(this->adjustNBuckets(
+        static_cast<size_t>(m_options.expandFactor * this->getNBuckets())));
+    }
+  }
+
+  return {node, true};
+}
+
+size_t
+Hashtable::findFreeBucket(HashValue h) const
+{
+  size_t nGroups = m_buckets.size() / GROUP_SIZE;
+  size_t group = computeGroupIndex(h, nGroups);
+  for (size_t i = 1; ; ++i) {
+    uint32_t match = matchFree(&m_tags[group * GROUP_SIZE]);
+    if (match != 0) {
+      return group * GROUP_SIZE + findFirstBit(match);
+    }
+    BOOST_ASSERT(i < nGroups);
+    group = (group + i) & (nGroups - 1);
+  }
+}
+
 const Node*
 Hashtable::find(const Name& name, size_t prefixLen) const
 {
@@ -231,32 +510,76 @@ Hashtable::erase(Node* node)
   BOOST_ASSERT(node != nullptr);
   BOOST_ASSERT(node->entry.getParent() == nullptr);
 
-  size_t bucket = this->computeBucketIndex(node->hash);
-  NFD_LOG_TRACE("erase " << node->entry.getName() << " hash=" << node->hash << " bucket=" << bucket);
+  if (m_options.layout == HashtableLayout::OPEN_ADDRESSING) {
+    this->eraseOpen(node);
+  }
+  else {
+    size_t bucket = this->computeBucketIndex(node->hash);
+    NFD_LOG_TRACE("erase " << node->entry.getName() << " hash=" << node->hash << " bucket=" << bucket);
 
-  this->detach(bucket, node);
-  delete node;
+    this->detach(bucket, node);
+    delete node;
+  }
   --m_size;
 
   if (m_size < m_shrinkThreshold) {
-    size_t newNBuckets = std::max(m_options.minSize,
-      static_cast<size_t>(m_options.shrinkFactor * this->getNBuckets()));
-    this->resize(newNBuckets);
+    size_t newNBuckets = this->adjustNBuckets(std::max(m_options.minSize,
+      static_cast<size_t>(m_options.shrinkFactor * this->getNBuckets())));
+    if (newNBuckets != this->getNBuckets()) {
+      this->resize(newNBuckets);
+    }
   }
 }
 
+void
+Hashtable::eraseOpen(Node* node)
+{
+  size_t bucket = this->getBucketIndex(node);
+  NFD_LOG_TRACE("erase " << node->entry.getName() << " hash=" << node->hash << " bucket=" << bucket);
+
+  // probe sequences may continue past a group without empty buckets,
+  // so the bucket must stay occupied for them until the next resize
+  if (matchTag(&m_tags[bucket / GROUP_SIZE * GROUP_SIZE], TAG_EMPTY) != 0) {
+    m_tags[bucket] = TAG_EMPTY;
+  }
+  else {
+    m_tags[bucket] = TAG_ERASED;
+    ++m_nErased;
+  }
+  m_buckets[bucket] = nullptr;
+  m_arena.deallocate(node);
+}
+
+size_t
+Hashtable::adjustNBuckets(size_t n) const
+{
+  if (m_options.layout != HashtableLayout::OPEN_ADDRESSING) {
+    return n;
+  }
+
+  size_t nBuckets = GROUP_SIZE;
+  while (nBuckets < n) {
+    nBuckets <<= 1;
+  }
+  return nBuckets;
+}
+
 void
 Hashtable::computeThresholds()
 {
   m_expandThreshold = static_cast<size_t>(m_options.expandLoadFactor * this->getNBuckets());
   m_shrinkThreshold = static_cast<size_t>(m_options.shrinkLoadFactor * this->getNBuckets());
+  if (m_options.layout == HashtableLayout::OPEN_ADDRESSING) {
+    // keep at least one free bucket for insertion
+    m_expandThreshold = std::min(m_expandThreshold, this->getNBuckets() - 1);
+  }
   NFD_LOG_TRACE("thresholds expand=" << m_expandThreshold << " shrink=" << m_shrinkThreshold);
 }
 
 void
 Hashtable::resize(size_t newNBuckets)
 {
-  if (this->getNBuckets() == newNBuckets) {
+  if (this->getNBuckets() == newNBuckets && m_nErased == 0) {
     return;
   }
   NFD_LOG_DEBUG("resize from=" << this->getNBuckets() << " to=" << newNBuckets);
@@ -265,10 +588,22 @@ Hashtable::resize(size_t newNBuckets)
   oldBuckets.swap(m_buckets);
   m_buckets.resize(newNBuckets);
 
+  if (m_options.layout == HashtableLayout::OPEN_ADDRESSING) {
+    m_tags = std::vector<uint8_t>(newNBuckets, TAG_EMPTY);
+    m_nErased = 0;
+  }
+
   for (Node* head : oldBuckets) {
     foreachNode(head, [this] (Node* node) {
-      size_t bucket = this->computeBucketIndex(node->hash);
-      this->attach(bucket, node);
+      if (m_options.layout == HashtableLayout::OPEN_ADDRESSING) {
+        size_t bucket = this->findFreeBucket(node->hash);
+        m_buckets[bucket] = node;
+        m_tags[bucket] = computeTag(node->hash);
+      }
+      else {
+        size_t bucket = this->computeBucketIndex(node->hash);
+        this->attach(bucket, node);
+      }
     });
   }
 
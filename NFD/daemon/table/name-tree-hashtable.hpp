@@ -28,6 +28,8 @@
 
 #include "name-tree-entry.hpp"
 
+#include <type_traits>
+
 namespace nfd {
 namespace name_tree {
 
@@ -40,12 +42,15 @@ typedef size_t HashValue;
 /** \brief a sequence of hash values
  *  \sa computeHashes
  */
-typedef std::vector<HashValue> HashSequence;
+typedef Name::PrefixHashes HashSequence;
 
 /** \brief computes a single hash value
  *  \param name base name
  *  \param prefixLen if non-negative, compute hash value for name.getPrefix(prefixLen);
  *                   if negative, compute hash value for complete name
+ *
+ *  Hash values cached on \p name are used when available.  The hash value of the complete
+ *  name is computed through getHashes, so that the hash values of all prefixes are cached.
  */
 HashValue
 computeHash(const Name& name, ssize_t prefixLen = -1);
@@ -56,10 +61,24 @@ computeHash(const Name& name, ssize_t prefixLen = -1);
 HashSequence
 computeHashes(const Name& name);
 
+/** \brief get hash values for each prefix of name, caching them on \p name
+ *  \return a hash sequence, where the i-th hash value equals computeHash(name, i) for
+ *          i <= name.size(); it may contain more values, which must be ignored
+ *  \note The reference is valid until \p name is modified or destroyed.
+ *
+ *  The hash sequence is computed once per name and then shared by copies and prefixes of the
+ *  name, so that e.g. the PIT insertion, FIB longest prefix match, and strategy choice lookup
+ *  of an Interest hash its name only once.  When components have been appended to a name
+ *  since the sequence was computed, only the new components are hashed.
+ */
+const HashSequence&
+getHashes(const Name& name);
+
 /** \brief a hashtable node
  *
  *  Zero or more nodes can be added to a hashtable bucket. They are organized as
  *  a doubly linked list through prev and next pointers.
+ *  In a hashtable with HashtableLayout::OPEN_ADDRESSING, prev and next are always nullptr.
  */
 class Node : noncopyable
 {
@@ -104,6 +123,67 @@ foreachNode(N* head, const F& func)
   }
 }
 
+/** \brief allocates nodes from contiguous blocks of memory
+ *
+ *  Blocks grow geometrically and are kept until the arena is destroyed; memory of erased
+ *  nodes is reused through a free list.
+ */
+class NodeArena : noncopyable
+{
+public:
+  NodeArena();
+
+  /** \pre all nodes have been deallocated
+   */
+  ~NodeArena();
+
+  /** \brief construct a node
+   */
+  Node*
+  allocate(HashValue h, const Name& name);
+
+  /** \brief destruct a node allocated from this arena
+   */
+  void
+  deallocate(Node* node);
+
+  /** \return bytes held by the blocks
+   */
+  size_t
+  getMemoryUsage() const;
+
+private:
+  union Slot
+  {
+    Slot* nextFree;
+    std::aligned_storage<sizeof(Node), alignof(Node)>::type storage;
+  };
+
+  std::vector<std::unique_ptr<Slot[]>> m_blocks;
+  size_t m_capacity; ///< total number of slots in m_blocks
+  size_t m_nUsedInLastBlock;
+  size_t m_lastBlockSize;
+  Slot* m_freeList;
+  size_t m_nAllocated;
+};
+
+/** \brief how Hashtable resolves hash collisions
+ */
+enum class HashtableLayout {
+  /** \brief each bucket is a doubly linked list of individually allocated nodes
+   */
+  CHAINED,
+
+  /** \brief each bucket holds at most one node, and colliding nodes are placed in other buckets
+   *
+   *  Buckets are probed in groups of 16, with a one-byte tag per bucket derived from the hash
+   *  value that is compared to all tags of a group at once (with SSE2 if available); names
+   *  are only compared when the tag and the full hash value match.  Nodes are allocated
+   *  from a NodeArena.  The number of buckets is rounded up to a power of two.
+   */
+  OPEN_ADDRESSING
+};
+
 /** \brief provides options for Hashtable
  */
 class HashtableOptions
@@ -140,13 +220,22 @@ public:
   /** \brief when hashtable is shrunk, its new size is max(nBuckets*shrinkFactor, minSize)
    */
   float shrinkFactor = 0.5;
+
+  /** \brief collision resolution scheme
+   *
+   *  With HashtableLayout::OPEN_ADDRESSING, buckets marked as erased also count towards
+   *  expandLoadFactor; when they make up most of the load, the hashtable is rebuilt with
+   *  the same number of buckets instead of being expanded.
+   */
+  HashtableLayout layout = HashtableLayout::CHAINED;
 };
 
 /** \brief a hashtable for fast exact name lookup
  *
  *  The Hashtable contains a number of buckets.
  *  Each node is placed into a bucket determined by a hash value computed from its name.
- *  Hash collision is resolved through a doubly linked list in each bucket.
+ *  Hash collision is resolved through a doubly linked list in each bucket, or through open
+ *  addressing, as selected by HashtableOptions::layout.
  *  The number of buckets is adjusted according to how many nodes are stored.
  */
 class Hashtable
@@ -177,7 +266,14 @@ public:
     return m_buckets.size();
   }
 
+  /** \return memory used by buckets and nodes, excluding memory owned by entries
+   */
+  size_t
+  getMemoryUsage() const;
+
   /** \return bucket index for hash value h
+   *  \note With HashtableLayout::OPEN_ADDRESSING, this is where probing starts;
+   *        use getBucketIndex to locate a node.
    */
   size_t
   computeBucketIndex(HashValue h) const
@@ -185,6 +281,12 @@ public:
     return h % this->getNBuckets();
   }
 
+  /** \return index of the bucket that contains node
+   *  \pre node exists in this hashtable
+   */
+  size_t
+  getBucketIndex(const Node* node) const;
+
   /** \return i-th bucket
    *  \pre bucket < getNBuckets()
    */
@@ -203,14 +305,14 @@ public:
 
   /** \brief find node for name.getPrefix(prefixLen)
    *  \pre name.size() > prefixLen
-   *  \pre hashes == computeHashes(name)
+   *  \pre hashes[i] == computeHash(name, i) for i <= prefixLen
    */
   const Node*
   find(const Name& name, size_t prefixLen, const HashSequence& hashes) const;
 
   /** \brief find or insert node for name.getPrefix(prefixLen)
    *  \pre name.size() > prefixLen
-   *  \pre hashes == computeHashes(name)
+   *  \pre hashes[i] == computeHash(name, i) for i <= prefixLen
    */
   std::pair<const Node*, bool>
   insert(const Name& name, size_t prefixLen, const HashSequence& hashes);
@@ -235,6 +337,22 @@ private:
   std::pair<const Node*, bool>
   findOrInsert(const Name& name, size_t prefixLen, HashValue h, bool allowInsert);
 
+  std::pair<const Node*, bool>
+  findOrInsertOpen(const Name& name, size_t prefixLen, HashValue h, bool allowInsert);
+
+  /** \return index of an empty or erased bucket in the probe sequence of h
+   */
+  size_t
+  findFreeBucket(HashValue h) const;
+
+  void
+  eraseOpen(Node* node);
+
+  /** \return number of buckets for the current layout, at least n
+   */
+  size_t
+  adjustNBuckets(size_t n) const;
+
   void
   computeThresholds();
 
@@ -247,6 +365,11 @@ private:
   size_t m_size;
   size_t m_expandThreshold;
   size_t m_shrinkThreshold;
+
+  // HashtableLayout::OPEN_ADDRESSING
+  std::vector<uint8_t> m_tags; ///< tag of each bucket, TAG_EMPTY, or TAG_ERASED
+  size_t m_nErased;            ///< number of buckets marked as erased
+  NodeArena m_arena;
 };
 
 } // namespace name_tree
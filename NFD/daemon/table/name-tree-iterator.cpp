@@ -146,7 +146,7 @@ FullEnumerationImpl::advance(Iterator& i)
   }
 
   // process other buckets
-  size_t currentBucket = ht.computeBucketIndex(getNode(*i.m_entry)->hash);
+  size_t currentBucket = ht.getBucketIndex(getNode(*i.m_entry));
   for (size_t bucket = currentBucket + 1; bucket < ht.getNBuckets(); ++bucket) {
     for (const Node* node = ht.getBucket(bucket); node != nullptr; node = node->next) {
       if (m_pred(node->entry)) {
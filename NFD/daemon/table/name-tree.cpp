@@ -40,12 +40,17 @@ NameTree::NameTree(size_t nBuckets)
 {
 }
 
+NameTree::NameTree(const HashtableOptions& options)
+  : m_ht(options)
+{
+}
+
 Entry&
 NameTree::lookup(const Name& name)
 {
   NFD_LOG_TRACE("lookup " << name);
 
-  HashSequence hashes = computeHashes(name);
+  const HashSequence& hashes = getHashes(name);
   const Node* node = nullptr;
   Entry* parent = nullptr;
 
@@ -154,7 +159,7 @@ NameTree::findExactMatch(const Name& name) const
 Entry*
 NameTree::findLongestPrefixMatch(const Name& name, const EntrySelector& entrySelector) const
 {
-  HashSequence hashes = computeHashes(name);
+  const HashSequence& hashes = getHashes(name);
 
   for (ssize_t prefixLen = name.size(); prefixLen >= 0; --prefixLen) {
     const Node* node = m_ht.find(name, prefixLen, hashes);
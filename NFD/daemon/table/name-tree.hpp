@@ -39,6 +39,11 @@ public:
   explicit
   NameTree(size_t nBuckets = 1024);
 
+  /** \brief create a name tree whose hashtable has the specified options
+   */
+  explicit
+  NameTree(const HashtableOptions& options);
+
 public: // information
   /** \return number of name tree entries
    */
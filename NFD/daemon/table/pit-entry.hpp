@@ -28,6 +28,7 @@
 
 #include "pit-in-record.hpp"
 #include "pit-out-record.hpp"
+#include "pit-record-collection.hpp"
 #include "core/scheduler.hpp"
 
 namespace nfd {
@@ -40,11 +41,11 @@ namespace pit {
 
 /** \brief an unordered collection of in-records
  */
-typedef std::list<InRecord> InRecordCollection;
+typedef RecordCollection<InRecord, 2> InRecordCollection;
 
 /** \brief an unordered collection of out-records
  */
-typedef std::list<OutRecord> OutRecordCollection;
+typedef RecordCollection<OutRecord, 2> OutRecordCollection;
 
 /** \brief an Interest table entry
  *
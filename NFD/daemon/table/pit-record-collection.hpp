@@ -0,0 +1,209 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2016,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_TABLE_PIT_RECORD_COLLECTION_HPP
+#define NFD_DAEMON_TABLE_PIT_RECORD_COLLECTION_HPP
+
+#include "core/common.hpp"
+
+#include <type_traits>
+
+namespace nfd {
+namespace pit {
+
+/** \brief a collection of in-records or out-records of a PIT entry
+ *  \tparam Record InRecord or OutRecord
+ *  \tparam N number of records stored inline
+ *
+ *  Most PIT entries have records for only one or two faces.  Up to \p N records are stored
+ *  within the collection itself; more records are moved into a heap array, which is released
+ *  when the collection is cleared.
+ *
+ *  Records are kept contiguous, newest first.  Inserting or erasing a record invalidates
+ *  iterators and references to other records.
+ */
+template<typename Record, size_t N>
+class RecordCollection : noncopyable
+{
+  static_assert(N > 0, "at least one record must be stored inline");
+
+public:
+  typedef Record value_type;
+  typedef Record* iterator;
+  typedef const Record* const_iterator;
+
+  RecordCollection()
+    : m_records(getInlineRecords())
+    , m_size(0)
+    , m_capacity(N)
+  {
+  }
+
+  ~RecordCollection()
+  {
+    this->clear();
+  }
+
+  iterator
+  begin()
+  {
+    return m_records;
+  }
+
+  const_iterator
+  begin() const
+  {
+    return m_records;
+  }
+
+  iterator
+  end()
+  {
+    return m_records + m_size;
+  }
+
+  const_iterator
+  end() const
+  {
+    return m_records + m_size;
+  }
+
+  size_t
+  size() const
+  {
+    return m_size;
+  }
+
+  bool
+  empty() const
+  {
+    return m_size == 0;
+  }
+
+  Record&
+  front()
+  {
+    BOOST_ASSERT(!this->empty());
+    return m_records[0];
+  }
+
+  const Record&
+  front() const
+  {
+    BOOST_ASSERT(!this->empty());
+    return m_records[0];
+  }
+
+  /** \brief construct a record at the beginning of the collection
+   *  \return iterator to the new record
+   */
+  template<typename... A>
+  iterator
+  emplace_front(A&&... args)
+  {
+    Record record(std::forward<A>(args)...);
+
+    if (m_size == m_capacity) {
+      this->grow();
+    }
+
+    // records are move-constructible but not assignable
+    for (size_t i = m_size; i > 0; --i) {
+      new (&m_records[i]) Record(std::move(m_records[i - 1]));
+      m_records[i - 1].~Record();
+    }
+    new (&m_records[0]) Record(std::move(record));
+    ++m_size;
+    return m_records;
+  }
+
+  /** \brief erase a record, preserving the order of the remaining records
+   *  \return iterator to the record following the erased one
+   */
+  iterator
+  erase(iterator pos)
+  {
+    BOOST_ASSERT(pos >= this->begin() && pos < this->end());
+    size_t index = pos - m_records;
+
+    m_records[index].~Record();
+    for (size_t i = index + 1; i < m_size; ++i) {
+      new (&m_records[i - 1]) Record(std::move(m_records[i]));
+      m_records[i].~Record();
+    }
+    --m_size;
+    return m_records + index;
+  }
+
+  void
+  clear()
+  {
+    for (size_t i = 0; i < m_size; ++i) {
+      m_records[i].~Record();
+    }
+    m_size = 0;
+
+    if (m_records != getInlineRecords()) {
+      ::operator delete(m_records);
+      m_records = getInlineRecords();
+      m_capacity = N;
+    }
+  }
+
+private:
+  Record*
+  getInlineRecords()
+  {
+    return reinterpret_cast<Record*>(&m_inline);
+  }
+
+  void
+  grow()
+  {
+    size_t capacity = m_capacity * 2;
+    Record* records = static_cast<Record*>(::operator new(capacity * sizeof(Record)));
+    for (size_t i = 0; i < m_size; ++i) {
+      new (&records[i]) Record(std::move(m_records[i]));
+      m_records[i].~Record();
+    }
+
+    if (m_records != getInlineRecords()) {
+      ::operator delete(m_records);
+    }
+    m_records = records;
+    m_capacity = capacity;
+  }
+
+private:
+  Record* m_records;
+  uint32_t m_size;
+  uint32_t m_capacity;
+  typename std::aligned_storage<sizeof(Record) * N, alignof(Record)>::type m_inline;
+};
+
+} // namespace pit
+} // namespace nfd
+
+#endif // NFD_DAEMON_TABLE_PIT_RECORD_COLLECTION_HPP
@@ -24,6 +24,7 @@
  */
 
 #include "pit.hpp"
+#include "core/pool-allocator.hpp"
 
 namespace nfd {
 namespace pit {
@@ -78,7 +79,8 @@ Pit::findOrInsert(const Interest& interest, bool allowInsert)
     return {nullptr, true};
   }
 
-  auto entry = make_shared<Entry>(interest);
+  // entry and its control block are taken from a free list in one chunk
+  auto entry = std::allocate_shared<Entry>(PoolAllocator<Entry>(), interest);
   nte->insertPitEntry(entry);
   ++m_nItems;
   return {entry, true};
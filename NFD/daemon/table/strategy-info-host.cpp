@@ -30,7 +30,7 @@ namespace nfd {
 void
 StrategyInfoHost::clearStrategyInfo()
 {
-  m_items.clear();
+  m_items.reset();
 }
 
 } // namespace nfd
@@ -46,8 +46,12 @@ public:
     static_assert(std::is_base_of<fw::StrategyInfo, T>::value,
                   "T must inherit from StrategyInfo");
 
-    auto it = m_items.find(T::getTypeId());
-    if (it == m_items.end()) {
+    if (m_items == nullptr) {
+      return nullptr;
+    }
+
+    auto it = m_items->find(T::getTypeId());
+    if (it == m_items->end()) {
       return nullptr;
     }
     return static_cast<T*>(it->second.get());
@@ -65,7 +69,11 @@ public:
     static_assert(std::is_base_of<fw::StrategyInfo, T>::value,
                   "T must inherit from StrategyInfo");
 
-    unique_ptr<fw::StrategyInfo>& item = m_items[T::getTypeId()];
+    if (m_items == nullptr) {
+      m_items.reset(new ItemMap);
+    }
+
+    unique_ptr<fw::StrategyInfo>& item = (*m_items)[T::getTypeId()];
     bool isNew = (item == nullptr);
     if (isNew) {
       item.reset(new T(std::forward<A>(args)...));
@@ -84,7 +92,10 @@ public:
     static_assert(std::is_base_of<fw::StrategyInfo, T>::value,
                   "T must inherit from StrategyInfo");
 
-    return m_items.erase(T::getTypeId());
+    if (m_items == nullptr) {
+      return 0;
+    }
+    return m_items->erase(T::getTypeId());
   }
 
   /** \brief clear all StrategyInfo items
@@ -93,7 +104,14 @@ public:
   clearStrategyInfo();
 
 private:
-  std::unordered_map<int, unique_ptr<fw::StrategyInfo>> m_items;
+  typedef std::unordered_map<int, unique_ptr<fw::StrategyInfo>> ItemMap;
+
+  /** \brief StrategyInfo items, allocated upon first insertion
+   *
+   *  Most hosts (e.g. PIT in-records and out-records) never carry any item,
+   *  so an empty host occupies only one pointer.
+   */
+  unique_ptr<ItemMap> m_items;
 };
 
 } // namespace nfd
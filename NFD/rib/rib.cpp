@@ -100,7 +100,7 @@ Rib::insert(const Name& prefix, const Route& route)
       afterAddRoute(RibRouteRef{entry, entryIt});
 
       // Register with face lookup table
-      m_faceMap[route.faceId].push_back(entry);
+      m_faceMap[route.faceId].emplace(prefix, entry);
     }
     else {
       // Route exists, update fields
@@ -151,7 +151,7 @@ Rib::insert(const Name& prefix, const Route& route)
     }
 
     // Register with face lookup table
-    m_faceMap[route.faceId].push_back(entry);
+    m_faceMap[route.faceId].emplace(prefix, entry);
 
     // do something after inserting an entry
     afterInsertEntry(prefix);
@@ -178,7 +178,13 @@ Rib::erase(const Name& prefix, const Route& route)
 
       // If this RibEntry no longer has this faceId, unregister from face lookup table
       if (!entry->hasFaceId(faceId)) {
-        m_faceMap[faceId].remove(entry);
+        FaceLookupTable::iterator lookupIt = m_faceMap.find(faceId);
+        if (lookupIt != m_faceMap.end()) {
+          lookupIt->second.erase(prefix);
+          if (lookupIt->second.empty()) {
+            m_faceMap.erase(lookupIt);
+          }
+        }
       }
 
       // If a RibEntry's route list is empty, remove it from the tree
@@ -216,23 +222,15 @@ Rib::findParent(const Name& prefix) const
   return shared_ptr<RibEntry>();
 }
 
-std::list<shared_ptr<RibEntry> >
+std::list<shared_ptr<RibEntry>>
 Rib::findDescendants(const Name& prefix) const
 {
-  std::list<shared_ptr<RibEntry> > children;
-
-  RibTable::const_iterator it = m_rib.find(prefix);
+  std::list<shared_ptr<RibEntry>> children;
 
-  if (it != m_rib.end()) {
-    ++it;
-    for (; it != m_rib.end(); ++it) {
-      if (prefix.isPrefixOf(it->first)) {
-        children.push_back((it->second));
-      }
-      else {
-        break;
-      }
-    }
+  // In canonical order, names under prefix immediately follow prefix itself
+  for (RibTable::const_iterator it = m_rib.upper_bound(prefix);
+       it != m_rib.end() && prefix.isPrefixOf(it->first); ++it) {
+    children.push_back(it->second);
   }
 
   return children;
@@ -243,10 +241,9 @@ Rib::findDescendantsForNonInsertedName(const Name& prefix) const
 {
   std::list<shared_ptr<RibEntry>> children;
 
-  for (std::pair<Name, shared_ptr<RibEntry>> pair : m_rib) {
-    if (prefix.isPrefixOf(pair.first)) {
-      children.push_back(pair.second);
-    }
+  for (RibTable::const_iterator it = m_rib.lower_bound(prefix);
+       it != m_rib.end() && prefix.isPrefixOf(it->first); ++it) {
+    children.push_back(it->second);
   }
 
   return children;
@@ -488,10 +485,10 @@ Rib::findRoutesWithFaceId(uint64_t faceId)
     return routes;
   }
 
-  RibEntryList& ribEntries = lookupIt->second;
-
   // For each RIB entry that has faceId
-  for (const shared_ptr<RibEntry>& entry : ribEntries) {
+  for (const auto& item : lookupIt->second) {
+    const shared_ptr<RibEntry>& entry = item.second;
+
     // Find the routes in the entry
     for (const Route& route : *entry) {
       if (route.faceId == faceId) {
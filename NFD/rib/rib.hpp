@@ -59,7 +59,11 @@ public:
   typedef std::list<shared_ptr<RibEntry>> RibEntryList;
   typedef std::map<Name, shared_ptr<RibEntry>> RibTable;
   typedef RibTable::const_iterator const_iterator;
-  typedef std::map<uint64_t, std::list<shared_ptr<RibEntry>>> FaceLookupTable;
+  /** \brief RIB entries with at least one route on each face, by face ID then name
+   *
+   *  Faces that no longer have any route are removed from the table.
+   */
+  typedef std::map<uint64_t, RibTable> FaceLookupTable;
   typedef bool (*RouteComparePredicate)(const Route&, const Route&);
   typedef std::set<Route, RouteComparePredicate> RouteSet;
 
@@ -92,6 +96,10 @@ public:
   findParent(const Name& prefix) const;
 
   /** \brief finds namespaces under the passed prefix
+   *
+   *  Descendants are contiguous in the name-ordered table, so only O(log N + k)
+   *  entries are visited for k descendants.
+   *
    *  \return{ a list of entries which are under the passed prefix }
    */
   std::list<shared_ptr<RibEntry>>
@@ -100,7 +108,8 @@ public:
   /** \brief finds namespaces under the passed prefix
    *
    *  \note Unlike findDescendants, needs to find where prefix would fit in tree
-   *  before collecting list of descendant prefixes
+   *  before collecting list of descendant prefixes; this is a lower_bound lookup,
+   *  not a scan of the whole RIB
    *
    *  \return{ a list of entries which would be under the passed prefix if the prefix
    *  existed in the RIB }
@@ -210,6 +219,8 @@ private:
 PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   typedef std::pair<const Name&,const Route&> NameAndRoute;
 
+  /** \return{ routes on faceId, ordered by name }
+   */
   std::list<NameAndRoute>
   findRoutesWithFaceId(uint64_t faceId);
 
@@ -0,0 +1,105 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "core/pool-allocator.hpp"
+
+#include "tests/test-common.hpp"
+
+namespace nfd {
+namespace tests {
+
+BOOST_FIXTURE_TEST_SUITE(TestPoolAllocator, BaseFixture)
+
+struct PoolAllocatorItem
+{
+  explicit
+  PoolAllocatorItem(int value)
+    : value(value)
+  {
+    ++nInstances;
+  }
+
+  ~PoolAllocatorItem()
+  {
+    --nInstances;
+  }
+
+  int value;
+  char padding[83];
+
+  static int nInstances;
+};
+
+int PoolAllocatorItem::nInstances = 0;
+
+BOOST_AUTO_TEST_CASE(SharedPtr)
+{
+  std::vector<shared_ptr<PoolAllocatorItem>> items;
+  for (int i = 0; i < 1000; ++i) {
+    items.push_back(std::allocate_shared<PoolAllocatorItem>(PoolAllocator<PoolAllocatorItem>(), i));
+  }
+  BOOST_CHECK_EQUAL(PoolAllocatorItem::nInstances, 1000);
+
+  std::set<const PoolAllocatorItem*> addresses;
+  for (int i = 0; i < 1000; ++i) {
+    BOOST_CHECK_EQUAL(items[i]->value, i);
+    addresses.insert(items[i].get());
+  }
+  BOOST_CHECK_EQUAL(addresses.size(), 1000);
+
+  // freed chunks are reused
+  const PoolAllocatorItem* freed = items.back().get();
+  items.pop_back();
+  BOOST_CHECK_EQUAL(PoolAllocatorItem::nInstances, 999);
+  items.push_back(std::allocate_shared<PoolAllocatorItem>(PoolAllocator<PoolAllocatorItem>(), 7));
+  BOOST_CHECK_EQUAL(items.back().get(), freed);
+
+  items.clear();
+  BOOST_CHECK_EQUAL(PoolAllocatorItem::nInstances, 0);
+}
+
+BOOST_AUTO_TEST_CASE(Array)
+{
+  PoolAllocator<uint64_t> allocator;
+
+  uint64_t* one = allocator.allocate(1);
+  uint64_t* many = allocator.allocate(100);
+  for (int i = 0; i < 100; ++i) {
+    many[i] = i;
+  }
+  *one = 8;
+  BOOST_CHECK_EQUAL(many[99], 99);
+  BOOST_CHECK_EQUAL(*one, 8);
+
+  allocator.deallocate(many, 100);
+  allocator.deallocate(one, 1);
+  BOOST_CHECK_EQUAL(allocator.allocate(1), one);
+  allocator.deallocate(one, 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestPoolAllocator
+
+} // namespace tests
+} // namespace nfd
@@ -721,6 +721,60 @@ BOOST_AUTO_TEST_CASE(ReceiveCongestionMarkNack)
   BOOST_CHECK_EQUAL(*tag, 1);
 }
 
+BOOST_AUTO_TEST_CASE(GeoTagRoundTrip)
+{
+  GenericLinkService::Options options;
+  options.allowGeoTag = true;
+  initialize(options);
+
+  lp::GeoTag geoTag;
+  geoTag.setPosX(120.5);
+  geoTag.setPosY(30.0);
+
+  shared_ptr<Interest> interest = makeInterest("/12345678");
+  lp::Packet packet(interest->wireEncode());
+  packet.set<lp::GeoTagField>(geoTag);
+
+  transport->receivePacket(packet.wireEncode());
+
+  BOOST_REQUIRE_EQUAL(receivedInterests.size(), 1);
+  shared_ptr<lp::GeoCordTag> tag = receivedInterests.back().getTag<lp::GeoCordTag>();
+  BOOST_REQUIRE(tag != nullptr);
+  BOOST_CHECK_EQUAL(tag->get().getPosX(), 120.5);
+  BOOST_CHECK_EQUAL(tag->get().getPosY(), 30.0);
+
+  face->sendInterest(receivedInterests.back());
+
+  BOOST_REQUIRE_EQUAL(transport->sentPackets.size(), 1);
+  lp::Packet sent(transport->sentPackets.back().packet);
+  BOOST_REQUIRE(sent.has<lp::GeoTagField>());
+  BOOST_CHECK_EQUAL(sent.get<lp::GeoTagField>().getPosX(), 120.5);
+  BOOST_CHECK_EQUAL(sent.get<lp::GeoTagField>().getPosY(), 30.0);
+}
+
+BOOST_AUTO_TEST_CASE(GeoTagDisabled)
+{
+  // e.g. a wired face: the position of the V2V sender must not be forwarded
+  GenericLinkService::Options options;
+  options.allowGeoTag = false;
+  initialize(options);
+
+  lp::GeoTag geoTag;
+  geoTag.setPosX(120.5);
+
+  shared_ptr<Interest> interest = makeInterest("/12345678");
+  interest->setTag(make_shared<lp::GeoCordTag>(geoTag));
+  face->sendInterest(*interest);
+
+  shared_ptr<Data> data = makeData("/12345678");
+  data->setTag(make_shared<lp::GeoCordTag>(geoTag));
+  face->sendData(*data);
+
+  BOOST_REQUIRE_EQUAL(transport->sentPackets.size(), 2);
+  BOOST_CHECK(!lp::Packet(transport->sentPackets[0].packet).has<lp::GeoTagField>());
+  BOOST_CHECK(!lp::Packet(transport->sentPackets[1].packet).has<lp::GeoTagField>());
+}
+
 BOOST_AUTO_TEST_SUITE_END() // LpFields
 
 
@@ -315,6 +315,57 @@ BOOST_AUTO_TEST_CASE(DigestExclude)
   CHECK_CS_FIND(1);
 }
 
+BOOST_AUTO_TEST_CASE(FullNameMiss)
+{
+  Name n1 = insert(1, "ndn:/A");
+  insert(2, "ndn:/A/B");
+
+  Name n3 = makeData("ndn:/A")->getFullName();
+  BOOST_REQUIRE_NE(n1, n3);
+
+  startInterest(n3);
+  CHECK_CS_FIND(0);
+}
+
+BOOST_AUTO_TEST_CASE(ExactNameNotSatisfying)
+{
+  insert(1, "ndn:/A");
+  insert(2, "ndn:/A/B");
+
+  // the entry with exact Name is found first, but cannot satisfy the Interest
+  startInterest("ndn:/A")
+    .setMaxSuffixComponents(1)
+    .setMinSuffixComponents(2);
+  CHECK_CS_FIND(0);
+
+  startInterest("ndn:/A")
+    .setMinSuffixComponents(2);
+  CHECK_CS_FIND(2);
+}
+
+BOOST_AUTO_TEST_CASE(ExactNameAfterEviction)
+{
+  m_cs.setLimit(2);
+
+  insert(1, "ndn:/A");
+  Name n2 = insert(2, "ndn:/A");
+  insert(3, "ndn:/B"); // evicts 1
+
+  startInterest("ndn:/A");
+  CHECK_CS_FIND(2);
+  startInterest(n2);
+  CHECK_CS_FIND(2);
+  startInterest("ndn:/B");
+  CHECK_CS_FIND(3);
+
+  insert(4, "ndn:/A/C"); // evicts 2
+
+  startInterest("ndn:/A");
+  CHECK_CS_FIND(4);
+  startInterest(n2);
+  CHECK_CS_FIND(0);
+}
+
 /// \todo test MustBeFresh
 
 BOOST_AUTO_TEST_SUITE_END() // Find
@@ -238,6 +238,70 @@ BOOST_AUTO_TEST_CASE(EraseNameTreeEntry)
   BOOST_CHECK_EQUAL(nameTree.size(), nNameTreeEntriesBefore);
 }
 
+BOOST_AUTO_TEST_CASE(LazyLifetime)
+{
+  measurements.setSweepInterval(time::seconds(1));
+
+  Name nameA("ndn:/A");
+  Name nameB("ndn:/B");
+  Name nameC("ndn:/C");
+  size_t nNameTreeEntriesBefore = nameTree.size();
+
+  Entry& entryA = measurements.get(nameA);
+  measurements.get(nameB);
+  Entry& entryC = measurements.get(nameC);
+  BOOST_CHECK_EQUAL(measurements.size(), 3);
+
+  measurements.extendLifetime(entryA, time::seconds(2));
+  measurements.extendLifetime(entryC, time::seconds(6));
+
+  this->advanceClocks(time::milliseconds(100), time::seconds(3));
+  BOOST_CHECK(measurements.findExactMatch(nameA) != nullptr);
+  BOOST_CHECK(measurements.findExactMatch(nameB) != nullptr);
+  BOOST_CHECK(measurements.findExactMatch(nameC) != nullptr);
+  BOOST_CHECK_EQUAL(measurements.size(), 3);
+
+  this->advanceClocks(time::milliseconds(100), time::seconds(2));
+  BOOST_CHECK(measurements.findExactMatch(nameA) == nullptr);
+  BOOST_CHECK(measurements.findExactMatch(nameB) == nullptr);
+  BOOST_CHECK(measurements.findExactMatch(nameC) != nullptr);
+  BOOST_CHECK_EQUAL(measurements.size(), 1);
+
+  this->advanceClocks(time::milliseconds(100), time::seconds(2));
+  BOOST_CHECK(measurements.findExactMatch(nameC) == nullptr);
+  BOOST_CHECK_EQUAL(measurements.size(), 0);
+  BOOST_CHECK_EQUAL(nameTree.size(), nNameTreeEntriesBefore);
+}
+
+BOOST_AUTO_TEST_CASE(LazyExpiredEntry)
+{
+  measurements.setSweepInterval(time::seconds(60));
+
+  measurements.get("/A").insertStrategyInfo<DummyStrategyInfo1>();
+  measurements.extendLifetime(measurements.get("/A"), time::seconds(10));
+  measurements.get("/A/B").insertStrategyInfo<DummyStrategyInfo1>();
+  BOOST_CHECK_EQUAL(measurements.size(), 2);
+
+  this->advanceClocks(time::milliseconds(100), Measurements::getInitialLifetime());
+
+  // /A/B has expired, but is not erased before the sweep
+  BOOST_CHECK_EQUAL(measurements.size(), 2);
+  BOOST_CHECK(measurements.findExactMatch("/A/B") == nullptr);
+
+  Entry* found = measurements.findLongestPrefixMatch("/A/B/C");
+  BOOST_REQUIRE(found != nullptr);
+  BOOST_CHECK_EQUAL(found->getName(), "/A");
+
+  // get() replaces the expired entry with a new one
+  Entry& entryAB = measurements.get("/A/B");
+  BOOST_CHECK(entryAB.getStrategyInfo<DummyStrategyInfo1>() == nullptr);
+  BOOST_CHECK_EQUAL(measurements.size(), 2);
+  BOOST_CHECK_EQUAL(measurements.findExactMatch("/A/B"), &entryAB);
+
+  this->advanceClocks(time::seconds(1), time::seconds(60));
+  BOOST_CHECK_EQUAL(measurements.size(), 0);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // TestMeasurements
 BOOST_AUTO_TEST_SUITE_END() // Table
 
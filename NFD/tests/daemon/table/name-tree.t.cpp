@@ -49,6 +49,43 @@ BOOST_AUTO_TEST_CASE(ComputeHash)
   BOOST_CHECK_EQUAL(hashes.size(), prefix.size() + 1);
 }
 
+BOOST_AUTO_TEST_CASE(CachedHashes)
+{
+  Name name("/A/B/C");
+  BOOST_CHECK(name.getCachedPrefixHashes() == nullptr);
+
+  const HashSequence* cached = &getHashes(name);
+  BOOST_CHECK(name.getCachedPrefixHashes() != nullptr);
+  BOOST_CHECK_EQUAL(&getHashes(name), cached);
+
+  HashSequence hashes = *cached;
+  BOOST_REQUIRE_EQUAL(hashes.size(), 4);
+  for (size_t i = 0; i <= name.size(); ++i) {
+    BOOST_CHECK_EQUAL(hashes[i], computeHash(Name(name.getPrefix(i).wireEncode()), i));
+  }
+
+  // prefixes share the cache
+  Name prefix = name.getPrefix(2);
+  BOOST_CHECK_EQUAL(&getHashes(prefix), cached);
+  BOOST_CHECK_EQUAL(computeHash(prefix), hashes[2]);
+  BOOST_CHECK_EQUAL(computeHashes(prefix).size(), 3);
+
+  // appending to the prefix must not reuse the hash of /A/B/C
+  prefix.append("D");
+  BOOST_CHECK_EQUAL(computeHash(prefix), computeHash(Name("/A/B/D")));
+
+  // appending to the name extends the cached sequence
+  name.append("D");
+  HashSequence extended = computeHashes(name);
+  BOOST_REQUIRE_EQUAL(extended.size(), 5);
+  BOOST_CHECK(std::equal(hashes.begin(), hashes.end(), extended.begin()));
+  BOOST_CHECK_EQUAL(extended[4], computeHash(Name("/A/B/C/D")));
+
+  name.clear();
+  BOOST_CHECK(name.getCachedPrefixHashes() == nullptr);
+  BOOST_CHECK_EQUAL(computeHash(name), 0);
+}
+
 BOOST_AUTO_TEST_SUITE(Hashtable)
 using name_tree::Hashtable;
 
@@ -179,6 +216,68 @@ BOOST_AUTO_TEST_CASE(Resize)
   BOOST_CHECK_EQUAL(ht.getNBuckets(), 6);
 }
 
+BOOST_AUTO_TEST_CASE(OpenAddressing)
+{
+  HashtableOptions options(20);
+  options.layout = HashtableLayout::OPEN_ADDRESSING;
+  Hashtable ht(options);
+  BOOST_CHECK_EQUAL(ht.getNBuckets(), 32);
+
+  auto makeName = [] (int i) {
+    Name name("/A");
+    name.appendNumber(i);
+    return name;
+  };
+
+  std::vector<const Node*> nodes;
+  for (int i = 0; i < 1000; ++i) {
+    Name name = makeName(i);
+    const Node* node = nullptr;
+    bool isNew = false;
+    std::tie(node, isNew) = ht.insert(name, name.size(), computeHashes(name));
+    BOOST_CHECK_EQUAL(isNew, true);
+    BOOST_CHECK_EQUAL(node->entry.getName(), name);
+    nodes.push_back(node);
+  }
+  BOOST_CHECK_EQUAL(ht.size(), 1000);
+  BOOST_CHECK_EQUAL(ht.getNBuckets(), 2048);
+
+  for (int i = 0; i < 1000; ++i) {
+    Name name = makeName(i);
+    // nodes do not move when the hashtable is expanded
+    BOOST_CHECK_EQUAL(ht.find(name, name.size()), nodes[i]);
+    BOOST_CHECK_EQUAL(ht.insert(name, name.size(), computeHashes(name)).second, false);
+    BOOST_CHECK_EQUAL(ht.getBucket(ht.getBucketIndex(nodes[i])), nodes[i]);
+    BOOST_CHECK(ht.find(name, 1) == nullptr);
+  }
+
+  for (int i = 0; i < 1000; i += 2) {
+    ht.erase(const_cast<Node*>(nodes[i]));
+  }
+  BOOST_CHECK_EQUAL(ht.size(), 500);
+
+  size_t nNodes = 0;
+  for (size_t bucket = 0; bucket < ht.getNBuckets(); ++bucket) {
+    const Node* node = ht.getBucket(bucket);
+    if (node != nullptr) {
+      BOOST_CHECK(node->next == nullptr);
+      ++nNodes;
+    }
+  }
+  BOOST_CHECK_EQUAL(nNodes, 500);
+
+  for (int i = 0; i < 1000; ++i) {
+    Name name = makeName(i);
+    BOOST_CHECK_EQUAL(ht.find(name, name.size()), i % 2 == 0 ? nullptr : nodes[i]);
+  }
+
+  for (int i = 1; i < 1000; i += 2) {
+    ht.erase(const_cast<Node*>(nodes[i]));
+  }
+  BOOST_CHECK_EQUAL(ht.size(), 0);
+  BOOST_CHECK_EQUAL(ht.getNBuckets(), 32);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // Hashtable
 
 BOOST_AUTO_TEST_SUITE(TestEntry)
@@ -521,6 +620,30 @@ BOOST_FIXTURE_TEST_CASE(IteratorFullEnumerate, EnumerationFixture)
     .end();
 }
 
+BOOST_AUTO_TEST_CASE(IteratorFullEnumerateOpenAddressing)
+{
+  HashtableOptions options(16);
+  options.layout = HashtableLayout::OPEN_ADDRESSING;
+  NameTree nt(options);
+
+  std::set<Name> expected;
+  for (int i = 0; i < 100; ++i) {
+    Name name("/a");
+    name.appendNumber(i % 10).appendNumber(i);
+    for (size_t prefixLen = 0; prefixLen <= name.size(); ++prefixLen) {
+      expected.insert(name.getPrefix(prefixLen));
+    }
+    nt.lookup(name);
+  }
+  BOOST_CHECK_EQUAL(nt.size(), expected.size());
+
+  std::set<Name> actual;
+  for (const Entry& entry : nt.fullEnumerate()) {
+    BOOST_CHECK(actual.insert(entry.getName()).second);
+  }
+  BOOST_CHECK_EQUAL_COLLECTIONS(actual.begin(), actual.end(), expected.begin(), expected.end());
+}
+
 BOOST_FIXTURE_TEST_SUITE(IteratorPartialEnumerate, EnumerationFixture)
 
 BOOST_AUTO_TEST_CASE(Empty)
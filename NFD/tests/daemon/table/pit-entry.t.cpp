@@ -175,6 +175,83 @@ BOOST_AUTO_TEST_CASE(InOutRecords)
   BOOST_CHECK(entry.getOutRecord(*face2) == entry.out_end());
 }
 
+class RecordStrategyInfo : public fw::StrategyInfo, noncopyable
+{
+public:
+  static constexpr int
+  getTypeId()
+  {
+    return 31;
+  }
+
+  explicit
+  RecordStrategyInfo(int id)
+    : m_id(id)
+  {
+  }
+
+public:
+  int m_id;
+};
+
+BOOST_AUTO_TEST_CASE(ManyRecords)
+{
+  // more records than stored inline
+  std::vector<shared_ptr<Face>> faces;
+  for (int i = 0; i < 5; ++i) {
+    faces.push_back(make_shared<DummyFace>());
+  }
+  shared_ptr<Interest> interest = makeInterest("ndn:/9pvPnxUjkF");
+  Entry entry(*interest);
+
+  for (size_t i = 0; i < faces.size(); ++i) {
+    interest->setNonce(i);
+    InRecordCollection::iterator in = entry.insertOrUpdateInRecord(*faces[i], *interest);
+    in->insertStrategyInfo<RecordStrategyInfo>(i);
+    OutRecordCollection::iterator out = entry.insertOrUpdateOutRecord(*faces[i], *interest);
+    lp::Nack nack(*interest);
+    BOOST_CHECK_EQUAL(out->setIncomingNack(nack), true);
+  }
+  BOOST_CHECK_EQUAL(entry.getInRecords().size(), 5);
+  BOOST_CHECK_EQUAL(entry.getOutRecords().size(), 5);
+
+  // records are newest first, and keep their contents when moved
+  auto checkRecords = [&] (std::vector<size_t> expected) {
+    BOOST_REQUIRE_EQUAL(entry.getInRecords().size(), expected.size());
+    BOOST_REQUIRE_EQUAL(entry.getOutRecords().size(), expected.size());
+    auto in = entry.in_begin();
+    auto out = entry.out_begin();
+    for (size_t i : expected) {
+      BOOST_CHECK_EQUAL(&in->getFace(), faces[i].get());
+      BOOST_CHECK_EQUAL(in->getLastNonce(), i);
+      BOOST_REQUIRE(in->getStrategyInfo<RecordStrategyInfo>() != nullptr);
+      BOOST_CHECK_EQUAL(in->getStrategyInfo<RecordStrategyInfo>()->m_id, static_cast<int>(i));
+      BOOST_CHECK_EQUAL(&out->getFace(), faces[i].get());
+      BOOST_REQUIRE(out->getIncomingNack() != nullptr);
+      BOOST_CHECK_EQUAL(out->getIncomingNack()->getInterest().getNonce(), i);
+      ++in;
+      ++out;
+    }
+  };
+  checkRecords({4, 3, 2, 1, 0});
+
+  entry.deleteInRecord(*faces[2]);
+  entry.deleteOutRecord(*faces[2]);
+  checkRecords({4, 3, 1, 0});
+
+  entry.deleteInRecord(*faces[4]);
+  entry.deleteOutRecord(*faces[4]);
+  entry.deleteInRecord(*faces[0]);
+  entry.deleteOutRecord(*faces[0]);
+  checkRecords({3, 1});
+
+  entry.clearInRecords();
+  BOOST_CHECK(entry.in_begin() == entry.in_end());
+  InRecordCollection::iterator in = entry.insertOrUpdateInRecord(*faces[0], *interest);
+  BOOST_CHECK(in == entry.in_begin());
+  BOOST_CHECK_EQUAL(entry.getInRecords().size(), 1);
+}
+
 BOOST_AUTO_TEST_CASE(Lifetime)
 {
   shared_ptr<Interest> interest = makeInterest("ndn:/7oIEurbgy6");
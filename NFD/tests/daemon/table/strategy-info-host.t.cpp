@@ -86,6 +86,9 @@ BOOST_AUTO_TEST_CASE(Basic)
   g_DummyStrategyInfo_count = 0;
   bool isNew = false;
 
+  BOOST_CHECK(host.getStrategyInfo<DummyStrategyInfo>() == nullptr);
+  BOOST_CHECK_EQUAL(host.eraseStrategyInfo<DummyStrategyInfo>(), 0);
+
   DummyStrategyInfo* info = nullptr;
   std::tie(info, isNew) = host.insertStrategyInfo<DummyStrategyInfo>(3503);
   BOOST_CHECK_EQUAL(isNew, true);
@@ -105,6 +108,11 @@ BOOST_AUTO_TEST_CASE(Basic)
   host.clearStrategyInfo();
   BOOST_CHECK(host.getStrategyInfo<DummyStrategyInfo>() == nullptr);
   BOOST_CHECK_EQUAL(g_DummyStrategyInfo_count, 0);
+
+  std::tie(info, isNew) = host.insertStrategyInfo<DummyStrategyInfo>(5218);
+  BOOST_CHECK_EQUAL(isNew, true);
+  BOOST_CHECK_EQUAL(g_DummyStrategyInfo_count, 1);
+  BOOST_CHECK_EQUAL(host.getStrategyInfo<DummyStrategyInfo>(), info);
 }
 
 BOOST_AUTO_TEST_CASE(Types)
@@ -171,6 +171,32 @@ BOOST_AUTO_TEST_CASE(InsertFindHit)
   BOOST_TEST_MESSAGE("insert-find(hit) " << (N_WORKLOAD * REPEAT) << ": " << d);
 }
 
+// find(exact) hit in a large ContentStore
+BOOST_AUTO_TEST_CASE(ExactHitLarge)
+{
+  constexpr size_t N_ENTRIES = 500000;
+  constexpr size_t REPEAT = 4;
+
+  Cs largeCs(N_ENTRIES);
+  std::vector<shared_ptr<Interest>> interestWorkload = makeInterestWorkload(N_ENTRIES);
+  std::vector<shared_ptr<Data>> dataWorkload = makeDataWorkload(N_ENTRIES);
+  for (const auto& data : dataWorkload) {
+    largeCs.insert(*data, false);
+  }
+  BOOST_REQUIRE(largeCs.size() == N_ENTRIES);
+
+  size_t nHits = 0;
+  time::microseconds d = timedRun([&] {
+    for (size_t j = 0; j < REPEAT; ++j) {
+      for (const auto& interest : interestWorkload) {
+        largeCs.find(*interest, bind([&nHits] { ++nHits; }), bind([]{}));
+      }
+    }
+  });
+  BOOST_CHECK_EQUAL(nHits, N_ENTRIES * REPEAT);
+  BOOST_TEST_MESSAGE("find(exact hit) " << (N_ENTRIES * REPEAT) << ": " << d);
+}
+
 // find(leftmost) hit
 BOOST_AUTO_TEST_CASE(Leftmost)
 {
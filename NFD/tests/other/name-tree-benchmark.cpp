@@ -0,0 +1,130 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2016,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "table/name-tree-hashtable.hpp"
+
+#include "tests/test-common.hpp"
+
+#ifdef HAVE_VALGRIND
+#include <valgrind/callgrind.h>
+#endif
+
+namespace nfd {
+namespace name_tree {
+namespace tests {
+
+using namespace nfd::tests;
+
+class NameTreeBenchmarkFixture : public BaseFixture
+{
+protected:
+  NameTreeBenchmarkFixture()
+  {
+#ifdef _DEBUG
+    BOOST_TEST_MESSAGE("Benchmark compiled in debug mode is unreliable, "
+                       "please compile in release mode.");
+#endif
+
+    // names of 6 to 10 components, sharing prefixes as in a forwarder's name tree
+    names.reserve(N_ENTRIES);
+    for (size_t i = 0; i < N_ENTRIES; ++i) {
+      Name name("/benchmark");
+      name.appendNumber(i % 64).appendNumber(i % 4096).append("video").appendNumber(i);
+      for (size_t j = 0; j < i % 5; ++j) {
+        name.appendSegment(j);
+      }
+      getHashes(name);
+      names.push_back(name);
+    }
+
+    lookupOrder.reserve(N_ENTRIES);
+    for (size_t i = 0; i < N_ENTRIES; ++i) {
+      lookupOrder.push_back((i * 7919) % N_ENTRIES);
+    }
+  }
+
+  void
+  run(HashtableLayout layout, float expandLoadFactor)
+  {
+    HashtableOptions options;
+    options.layout = layout;
+    options.expandLoadFactor = expandLoadFactor;
+    Hashtable ht(options);
+
+    for (const Name& name : names) {
+      ht.insert(name, name.size(), getHashes(name));
+    }
+    BOOST_REQUIRE_EQUAL(ht.size(), N_ENTRIES);
+
+#ifdef HAVE_VALGRIND
+    CALLGRIND_START_INSTRUMENTATION;
+#endif
+
+    size_t nFound = 0;
+    auto t1 = time::steady_clock::now();
+    for (size_t round = 0; round < N_ROUNDS; ++round) {
+      for (size_t i : lookupOrder) {
+        const Name& name = names[i];
+        nFound += ht.find(name, name.size(), getHashes(name)) != nullptr;
+      }
+    }
+    auto t2 = time::steady_clock::now();
+
+#ifdef HAVE_VALGRIND
+    CALLGRIND_STOP_INSTRUMENTATION;
+#endif
+
+    BOOST_CHECK_EQUAL(nFound, N_ENTRIES * N_ROUNDS);
+
+    double seconds = time::duration_cast<time::microseconds>(t2 - t1).count() / 1e6;
+    BOOST_TEST_MESSAGE((layout == HashtableLayout::CHAINED ? "chained" : "open-addressing") <<
+                       " expandLoadFactor=" << expandLoadFactor <<
+                       " buckets=" << ht.getNBuckets() <<
+                       " lookups/s=" << static_cast<uint64_t>(nFound / seconds) <<
+                       " bytes/entry=" << static_cast<double>(ht.getMemoryUsage()) / ht.size());
+  }
+
+protected:
+  static const size_t N_ENTRIES = 1000000;
+  static const size_t N_ROUNDS = 3;
+
+  std::vector<Name> names;
+  std::vector<size_t> lookupOrder;
+};
+
+const size_t NameTreeBenchmarkFixture::N_ENTRIES;
+const size_t NameTreeBenchmarkFixture::N_ROUNDS;
+
+// Bytes per entry count buckets and nodes, but not names and table entries attached to nodes.
+BOOST_FIXTURE_TEST_CASE(ExactMatch, NameTreeBenchmarkFixture)
+{
+  run(HashtableLayout::CHAINED, 0.5);
+  run(HashtableLayout::OPEN_ADDRESSING, 0.5);
+  run(HashtableLayout::OPEN_ADDRESSING, 0.875);
+}
+
+} // namespace tests
+} // namespace name_tree
+} // namespace nfd
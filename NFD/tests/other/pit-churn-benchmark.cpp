@@ -0,0 +1,165 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2016,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "table/pit.hpp"
+#include "face/null-face.hpp"
+
+#include "tests/test-common.hpp"
+
+#include <fstream>
+#include <unistd.h>
+
+#ifdef HAVE_VALGRIND
+#include <valgrind/callgrind.h>
+#endif
+
+namespace nfd {
+namespace tests {
+
+class PitChurnBenchmarkFixture : public BaseFixture
+{
+protected:
+  PitChurnBenchmarkFixture()
+    : m_pit(m_nameTree)
+    , m_downstream(face::makeNullFace())
+    , m_upstream(face::makeNullFace())
+  {
+#ifdef _DEBUG
+    BOOST_TEST_MESSAGE("Benchmark compiled in debug mode is unreliable, "
+                       "please compile in release mode.");
+#endif
+
+    interests.reserve(N_INTERESTS);
+    for (size_t i = 0; i < N_INTERESTS; ++i) {
+      Name name("/churn");
+      name.appendNumber(i % 256).append("segment").appendNumber(i);
+      shared_ptr<Interest> interest = make_shared<Interest>(name);
+      interest->setNonce(i);
+      interest->wireEncode();
+      interests.push_back(interest);
+    }
+  }
+
+  /** \brief create a pending PIT entry as the forwarder does for an Interest forwarded upstream
+   */
+  void
+  receiveInterest(const Interest& interest)
+  {
+    shared_ptr<pit::Entry> entry = m_pit.insert(interest).first;
+    entry->insertOrUpdateInRecord(*m_downstream, interest);
+    entry->insertOrUpdateOutRecord(*m_upstream, interest);
+    entry->m_unsatisfyTimer = scheduler::schedule(time::seconds(4), [] {});
+  }
+
+  /** \brief delete the PIT entry as the forwarder does when Data arrives
+   */
+  void
+  receiveData(const Interest& interest)
+  {
+    shared_ptr<pit::Entry> entry = m_pit.find(interest);
+    BOOST_ASSERT(entry != nullptr);
+    scheduler::cancel(entry->m_unsatisfyTimer);
+    m_pit.erase(entry.get());
+  }
+
+  /** \return resident set size in bytes, or 0 if unknown
+   */
+  static size_t
+  getRss()
+  {
+    std::ifstream statm("/proc/self/statm");
+    size_t size = 0, resident = 0;
+    if (!(statm >> size >> resident)) {
+      return 0;
+    }
+    return resident * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  }
+
+protected:
+  static const size_t N_INTERESTS = 1000000;
+
+  std::vector<shared_ptr<Interest>> interests;
+
+  NameTree m_nameTree;
+  Pit m_pit;
+  shared_ptr<Face> m_downstream;
+  shared_ptr<Face> m_upstream;
+};
+
+const size_t PitChurnBenchmarkFixture::N_INTERESTS;
+
+// Every Interest creates a PIT entry with one in-record, one out-record, and the unsatisfy timer.
+// The entry is deleted when Data arrives nPending Interests later.
+BOOST_FIXTURE_TEST_CASE(Churn, PitChurnBenchmarkFixture)
+{
+  // number of pending Interests
+  const size_t nPending = 20000;
+
+#ifdef HAVE_VALGRIND
+  CALLGRIND_START_INSTRUMENTATION;
+#endif
+
+  auto t1 = time::steady_clock::now();
+  for (size_t i = 0; i < N_INTERESTS; ++i) {
+    receiveInterest(*interests[i]);
+    if (i >= nPending) {
+      receiveData(*interests[i - nPending]);
+    }
+  }
+  auto t2 = time::steady_clock::now();
+
+#ifdef HAVE_VALGRIND
+  CALLGRIND_STOP_INSTRUMENTATION;
+#endif
+
+  BOOST_CHECK_EQUAL(m_pit.size(), nPending);
+
+  double seconds = time::duration_cast<time::microseconds>(t2 - t1).count() / 1e6;
+  BOOST_TEST_MESSAGE("pending=" << nPending <<
+                     " Interests/s=" << static_cast<uint64_t>(N_INTERESTS / seconds));
+}
+
+// RSS growth while N_INTERESTS Interests are pending, including name tree entries
+// but not the Interests themselves.
+BOOST_FIXTURE_TEST_CASE(Footprint, PitChurnBenchmarkFixture)
+{
+  size_t rss1 = getRss();
+  for (const shared_ptr<Interest>& interest : interests) {
+    receiveInterest(*interest);
+  }
+  size_t rss2 = getRss();
+
+  BOOST_CHECK_EQUAL(m_pit.size(), N_INTERESTS);
+
+  if (rss1 == 0 || rss2 == 0) {
+    BOOST_TEST_MESSAGE("RSS is unavailable on this platform");
+    return;
+  }
+  BOOST_TEST_MESSAGE("pending=" << N_INTERESTS <<
+                     " RSS bytes/Interest=" << static_cast<double>(rss2 - rss1) / N_INTERESTS);
+}
+
+} // namespace tests
+} // namespace nfd
@@ -201,6 +201,80 @@ BOOST_AUTO_TEST_CASE(EraseRibEntry)
   BOOST_CHECK(ribEntry3->getParent() == ribEntry1);
 }
 
+BOOST_AUTO_TEST_CASE(Descendants)
+{
+  rib::Rib rib;
+
+  Route route;
+  route.faceId = 1;
+  route.origin = 20;
+  for (const char* uri : {"/a", "/a/b", "/a/b/c", "/a/d", "/ab", "/b"}) {
+    rib.insert(uri, route);
+  }
+
+  auto toNames = [] (const std::list<shared_ptr<rib::RibEntry>>& entries) {
+    std::vector<Name> names;
+    for (const auto& entry : entries) {
+      names.push_back(entry->getName());
+    }
+    return names;
+  };
+
+  std::vector<Name> expected{"/a/b", "/a/b/c", "/a/d"};
+  std::vector<Name> actual = toNames(rib.findDescendants("/a"));
+  BOOST_CHECK_EQUAL_COLLECTIONS(actual.begin(), actual.end(), expected.begin(), expected.end());
+
+  BOOST_CHECK(rib.findDescendants("/b").empty());
+  BOOST_CHECK(rib.findDescendants("/c").empty());
+
+  expected = {"/a/b/c"};
+  actual = toNames(rib.findDescendantsForNonInsertedName("/a/b/c"));
+  BOOST_CHECK_EQUAL_COLLECTIONS(actual.begin(), actual.end(), expected.begin(), expected.end());
+
+  actual = toNames(rib.findDescendantsForNonInsertedName("/"));
+  BOOST_CHECK_EQUAL(actual.size(), 6);
+
+  BOOST_CHECK(rib.findDescendantsForNonInsertedName("/a/c").empty());
+  BOOST_CHECK(rib.findDescendantsForNonInsertedName("/z").empty());
+}
+
+BOOST_AUTO_TEST_CASE(FaceLookup)
+{
+  rib::Rib rib;
+
+  Route route1;
+  route1.faceId = 1;
+  route1.origin = 20;
+  Route route2 = route1;
+  route2.origin = 30;
+  Route route3 = route1;
+  route3.faceId = 2;
+
+  rib.insert("/b", route1);
+  rib.insert("/a", route1);
+  rib.insert("/a", route2);
+  rib.insert("/a", route3);
+
+  auto routes = rib.findRoutesWithFaceId(1);
+  BOOST_REQUIRE_EQUAL(routes.size(), 3);
+  BOOST_CHECK_EQUAL(routes.front().first, "/a");
+  BOOST_CHECK_EQUAL(routes.back().first, "/b");
+  BOOST_CHECK_EQUAL(rib.findRoutesWithFaceId(2).size(), 1);
+
+  // the entry stays indexed under face 1 while it has another route on face 1
+  rib.erase("/a", route1);
+  BOOST_CHECK_EQUAL(rib.findRoutesWithFaceId(1).size(), 2);
+
+  rib.erase("/a", route2);
+  rib.erase("/b", route1);
+  BOOST_CHECK(rib.findRoutesWithFaceId(1).empty());
+  BOOST_CHECK_EQUAL(rib.findRoutesWithFaceId(2).size(), 1);
+
+  rib.erase("/a", route3);
+  BOOST_CHECK(rib.findRoutesWithFaceId(2).empty());
+  BOOST_CHECK(rib.empty());
+}
+
 BOOST_AUTO_TEST_CASE(Basic)
 {
   rib::Rib rib;
@@ -78,6 +78,11 @@ ConsumerCbr::~ConsumerCbr()
 void
 ConsumerCbr::ScheduleNextPacket()
 {
+  if (m_generator != nullptr) {
+    ScheduleNextGeneratedPacket();
+    return;
+  }
+
   // double mean = 8.0 * m_payloadSize / m_desiredRate.GetBitRate ();
   // std::cout << "next: " << Simulator::Now().ToDouble(Time::S) + mean << "s\n";
 
@@ -21,8 +21,6 @@
 
 #include "ndn-consumer-zipf-mandelbrot.hpp"
 
-#include <math.h>
-
 NS_LOG_COMPONENT_DEFINE("ndn.ConsumerZipfMandelbrot");
 
 namespace ns3 {
@@ -52,7 +50,15 @@ ConsumerZipfMandelbrot::GetTypeId(void)
       .AddAttribute("s", "parameter of power", StringValue("0.7"),
                     MakeDoubleAccessor(&ConsumerZipfMandelbrot::SetS,
                                        &ConsumerZipfMandelbrot::GetS),
-                    MakeDoubleChecker<double>());
+                    MakeDoubleChecker<double>())
+
+      .AddAttribute("Sampler",
+                    "Sampling method: cdf (default, binary search over the cumulative "
+                    "distribution) or alias (Walker's alias method)",
+                    StringValue("cdf"),
+                    MakeStringAccessor(&ConsumerZipfMandelbrot::SetSampler,
+                                       &ConsumerZipfMandelbrot::GetSampler),
+                    MakeStringChecker());
 
   return tid;
 }
@@ -61,6 +67,7 @@ ConsumerZipfMandelbrot::ConsumerZipfMandelbrot()
   : m_N(100) // needed here to make sure when SetQ/SetS are called, there is a valid value of N
   , m_q(0.7)
   , m_s(0.7)
+  , m_samplerMethod(ZipfMandelbrotSampler::CDF)
   , m_seqRng(CreateObject<UniformRandomVariable>())
 {
   // SetNumberOfContents is called by NS-3 object system during the initialization
@@ -74,20 +81,9 @@ void
 ConsumerZipfMandelbrot::SetNumberOfContents(uint32_t numOfContents)
 {
   m_N = numOfContents;
+  m_sampler = nullptr;
 
   NS_LOG_DEBUG(m_q << " and " << m_s << " and " << m_N);
-
-  m_Pcum = std::vector<double>(m_N + 1);
-
-  m_Pcum[0] = 0.0;
-  for (uint32_t i = 1; i <= m_N; i++) {
-    m_Pcum[i] = m_Pcum[i - 1] + 1.0 / std::pow(i + m_q, m_s);
-  }
-
-  for (uint32_t i = 1; i <= m_N; i++) {
-    m_Pcum[i] = m_Pcum[i] / m_Pcum[m_N];
-    NS_LOG_LOGIC("Cumulative probability [" << i << "]=" << m_Pcum[i]);
-  }
 }
 
 uint32_t
@@ -100,7 +96,7 @@ void
 ConsumerZipfMandelbrot::SetQ(double q)
 {
   m_q = q;
-  SetNumberOfContents(m_N);
+  m_sampler = nullptr;
 }
 
 double
@@ -113,7 +109,7 @@ void
 ConsumerZipfMandelbrot::SetS(double s)
 {
   m_s = s;
-  SetNumberOfContents(m_N);
+  m_sampler = nullptr;
 }
 
 double
@@ -122,6 +118,27 @@ ConsumerZipfMandelbrot::GetS() const
   return m_s;
 }
 
+void
+ConsumerZipfMandelbrot::SetSampler(const std::string& sampler)
+{
+  if (sampler == "cdf") {
+    m_samplerMethod = ZipfMandelbrotSampler::CDF;
+  }
+  else if (sampler == "alias") {
+    m_samplerMethod = ZipfMandelbrotSampler::ALIAS;
+  }
+  else {
+    NS_FATAL_ERROR("Unknown Zipf-Mandelbrot sampler " << sampler << " (expected cdf or alias)");
+  }
+  m_sampler = nullptr;
+}
+
+std::string
+ConsumerZipfMandelbrot::GetSampler() const
+{
+  return m_samplerMethod == ZipfMandelbrotSampler::ALIAS ? "alias" : "cdf";
+}
+
 void
 ConsumerZipfMandelbrot::SendPacket()
 {
@@ -176,18 +193,8 @@ ConsumerZipfMandelbrot::SendPacket()
 
   // NS_LOG_INFO ("Requesting Interest: \n" << *interest);
   NS_LOG_INFO("> Interest for " << seq << ", Total: " << m_seq << ", face: " << m_face->getId());
-  NS_LOG_DEBUG("Trying to add " << seq << " with " << Simulator::Now() << ". already "
-                                << m_seqTimeouts.size() << " items");
-
-  m_seqTimeouts.insert(SeqTimeout(seq, Simulator::Now()));
-  m_seqFullDelay.insert(SeqTimeout(seq, Simulator::Now()));
 
-  m_seqLastDelay.erase(seq);
-  m_seqLastDelay.insert(SeqTimeout(seq, Simulator::Now()));
-
-  m_seqRetxCounts[seq]++;
-
-  m_rtt->SentSeq(SequenceNumber32(seq), 1);
+  WillSendOutInterest(seq);
 
   m_transmittedInterests(interest, this, m_face);
   m_appLink->onReceiveInterest(*interest);
@@ -198,24 +205,17 @@ ConsumerZipfMandelbrot::SendPacket()
 uint32_t
 ConsumerZipfMandelbrot::GetNextSeq()
 {
-  uint32_t content_index = 1; //[1, m_N]
-  double p_sum = 0;
+  if (m_sampler == nullptr) {
+    m_sampler = ZipfMandelbrotSampler::get(m_N, m_q, m_s, m_samplerMethod);
+  }
 
   double p_random = m_seqRng->GetValue();
   while (p_random == 0) {
     p_random = m_seqRng->GetValue();
   }
-  // if (p_random == 0)
   NS_LOG_LOGIC("p_random=" << p_random);
-  for (uint32_t i = 1; i <= m_N; i++) {
-    p_sum = m_Pcum[i]; // m_Pcum[i] = m_Pcum[i-1] + p[i], p[0] = 0;   e.g.: p_cum[1] = p[1],
-                       // p_cum[2] = p[1] + p[2]
-    if (p_random <= p_sum) {
-      content_index = i;
-      break;
-    } // if
-  }   // for
-  // content_index = 1;
+
+  uint32_t content_index = m_sampler->sample(p_random); //[1, m_N]
   NS_LOG_DEBUG("RandomNumber=" << content_index);
   return content_index;
 }
@@ -223,6 +223,10 @@ ConsumerZipfMandelbrot::GetNextSeq()
 void
 ConsumerZipfMandelbrot::ScheduleNextPacket()
 {
+  if (m_generator != nullptr) {
+    ScheduleNextGeneratedPacket();
+    return;
+  }
 
   if (m_firstTime) {
     m_sendEvent = Simulator::Schedule(Seconds(0.0), &ConsumerZipfMandelbrot::SendPacket, this);
@@ -27,6 +27,8 @@
 #include "ndn-consumer.hpp"
 #include "ndn-consumer-cbr.hpp"
 
+#include "ns3/ndnSIM/utils/ndn-zipf-mandelbrot-sampler.hpp"
+
 #include "ns3/ptr.h"
 #include "ns3/log.h"
 #include "ns3/simulator.h"
@@ -47,6 +49,9 @@ namespace ndn {
  * The class implements an app which requests contents following Zipf-Mandelbrot Distribution
  * Here is the explaination of Zipf-Mandelbrot Distribution:
  *http://en.wikipedia.org/wiki/Zipf%E2%80%93Mandelbrot_law
+ *
+ * Sequence numbers are drawn with a ZipfMandelbrotSampler, which is built on the first
+ * request after any parameter change and shared by all consumers with the same parameters.
  */
 class ConsumerZipfMandelbrot : public ConsumerCbr {
 public:
@@ -90,11 +95,18 @@ private:
   double
   GetS() const;
 
+  void
+  SetSampler(const std::string& sampler);
+
+  std::string
+  GetSampler() const;
+
 private:
   uint32_t m_N;               // number of the contents
   double m_q;                 // q in (k+q)^s
   double m_s;                 // s in (k+q)^s
-  std::vector<double> m_Pcum; // cumulative probability
+  ZipfMandelbrotSampler::Method m_samplerMethod;
+  shared_ptr<const ZipfMandelbrotSampler> m_sampler; // built lazily by GetNextSeq
 
   Ptr<UniformRandomVariable> m_seqRng; // RNG
 };
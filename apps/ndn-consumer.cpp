@@ -28,6 +28,7 @@
 #include "ns3/uinteger.h"
 #include "ns3/integer.h"
 #include "ns3/double.h"
+#include "ns3/pointer.h"
 
 #include "utils/ndn-ns3-packet-tag.hpp"
 #include "utils/ndn-rtt-mean-deviation.hpp"
@@ -65,6 +66,12 @@ Consumer::GetTypeId(void)
                     MakeTimeAccessor(&Consumer::GetRetxTimer, &Consumer::SetRetxTimer),
                     MakeTimeChecker())
 
+      .AddAttribute("RequestGenerator",
+                    "Model choosing the sequence numbers (and, for rate-driven consumers, the "
+                    "times) of new Interests, e.g. ns3::ndn::TraceRequestGenerator[File=trace]",
+                    PointerValue(), MakePointerAccessor(&Consumer::m_generator),
+                    MakePointerChecker<RequestGenerator>())
+
       .AddTraceSource("LastRetransmittedInterestDataDelay",
                       "Delay between last retransmitted Interest and received Data",
                       MakeTraceSourceAccessor(&Consumer::m_lastRetransmittedInterestDataDelay),
@@ -82,6 +89,7 @@ Consumer::Consumer()
   : m_rand(CreateObject<UniformRandomVariable>())
   , m_seq(0)
   , m_seqMax(0) // don't request anything
+  , m_hasNextRequest(false)
 {
   NS_LOG_FUNCTION_NOARGS();
 
@@ -92,13 +100,14 @@ void
 Consumer::SetRetxTimer(Time retxTimer)
 {
   m_retxTimer = retxTimer;
+  m_retxTimerStart = Simulator::Now();
   if (m_retxEvent.IsRunning()) {
     // m_retxEvent.Cancel (); // cancel any scheduled cleanup events
     Simulator::Remove(m_retxEvent); // slower, but better for memory
   }
 
   // schedule even with new timeout
-  m_retxEvent = Simulator::Schedule(m_retxTimer, &Consumer::CheckRetxTimeout, this);
+  ScheduleRetxCheck();
 }
 
 Time
@@ -107,6 +116,22 @@ Consumer::GetRetxTimer() const
   return m_retxTimer;
 }
 
+void
+Consumer::ScheduleRetxCheck()
+{
+  if (m_retxEvent.IsRunning() || !m_seqTable.hasTimeouts()) {
+    return;
+  }
+
+  // keep checks at the same points in time as if they had never stopped
+  NS_ASSERT(m_retxTimer.IsStrictlyPositive());
+  Time now = Simulator::Now();
+  int64_t nPeriods = (now - m_retxTimerStart).GetTimeStep() / m_retxTimer.GetTimeStep() + 1;
+  Time next = m_retxTimerStart + TimeStep(nPeriods * m_retxTimer.GetTimeStep());
+
+  m_retxEvent = Simulator::Schedule(next - now, &Consumer::CheckRetxTimeout, this);
+}
+
 void
 Consumer::CheckRetxTimeout()
 {
@@ -115,20 +140,47 @@ Consumer::CheckRetxTimeout()
   Time rto = m_rtt->RetransmitTimeout();
   // NS_LOG_DEBUG ("Current RTO: " << rto.ToDouble (Time::S) << "s");
 
-  while (!m_seqTimeouts.empty()) {
-    SeqTimeoutsContainer::index<i_timestamp>::type::iterator entry =
-      m_seqTimeouts.get<i_timestamp>().begin();
-    if (entry->time + rto <= now) // timeout expired?
-    {
-      uint32_t seqNo = entry->seq;
-      m_seqTimeouts.get<i_timestamp>().erase(entry);
-      OnTimeout(seqNo);
+  uint32_t seqNo = 0;
+  while (m_seqTable.popExpiredTimeout(now, rto, seqNo)) {
+    OnTimeout(seqNo);
+  }
+
+  if (m_seqTable.hasTimeouts()) {
+    m_retxEvent = Simulator::Schedule(m_retxTimer, &Consumer::CheckRetxTimeout, this);
+  }
+}
+
+void
+Consumer::ScheduleNextGeneratedPacket()
+{
+  Time delay;
+  if (!m_retxSeqs.empty()) {
+    delay = Seconds(0); // retransmissions do not wait for the next request
+  }
+  else if (PeekNextRequest()) {
+    delay = std::max(m_generatorStart + m_nextRequest.time - Simulator::Now(), Seconds(0));
+  }
+  else {
+    return; // nothing left to send
+  }
+
+  if (m_sendEvent.IsRunning()) {
+    if (m_sendEvent.GetTs() <= static_cast<uint64_t>((Simulator::Now() + delay).GetTimeStep())) {
+      return; // already scheduled early enough
     }
-    else
-      break; // nothing else to do. All later packets need not be retransmitted
+    Simulator::Cancel(m_sendEvent);
   }
 
-  m_retxEvent = Simulator::Schedule(m_retxTimer, &Consumer::CheckRetxTimeout, this);
+  m_sendEvent = Simulator::Schedule(delay, &Consumer::SendPacket, this);
+}
+
+bool
+Consumer::PeekNextRequest()
+{
+  if (!m_hasNextRequest) {
+    m_hasNextRequest = m_generator->GetNextRequest(m_nextRequest);
+  }
+  return m_hasNextRequest;
 }
 
 // Application Methods
@@ -140,6 +192,11 @@ Consumer::StartApplication() // Called at time specified by Start
   // do base stuff
   App::StartApplication();
 
+  if (m_generator != nullptr) {
+    m_generator->Attach(this);
+    m_generatorStart = Simulator::Now();
+  }
+
   ScheduleNextPacket();
 }
 
@@ -178,7 +235,17 @@ Consumer::SendPacket()
       }
     }
 
-    seq = m_seq++;
+    if (m_generator != nullptr) {
+      if (!PeekNextRequest()) {
+        return; // the generator has no more requests
+      }
+      seq = m_nextRequest.seq;
+      m_hasNextRequest = false;
+      m_seq++;
+    }
+    else {
+      seq = m_seq++;
+    }
   }
 
   //
@@ -225,28 +292,24 @@ Consumer::OnData(shared_ptr<const Data> data)
   NS_LOG_INFO("< DATA for " << seq);
 
   int hopCount = 0;
-  auto hopCountTag = data->getTag<lp::HopCountTag>();
+  auto hopCountTag = data->peekTag<lp::HopCountTag>();
   if (hopCountTag != nullptr) { // e.g., packet came from local node's cache
     hopCount = *hopCountTag;
   }
   NS_LOG_DEBUG("Hop count: " << hopCount);
 
-  SeqTimeoutsContainer::iterator entry = m_seqLastDelay.find(seq);
-  if (entry != m_seqLastDelay.end()) {
-    m_lastRetransmittedInterestDataDelay(this, seq, Simulator::Now() - entry->time, hopCount);
-  }
+  ConsumerSeqTable::Record* record = m_seqTable.find(seq);
+  if (record != nullptr) {
+    ConsumerSeqTable::Record acked = *record;
+    m_seqTable.erase(seq);
 
-  entry = m_seqFullDelay.find(seq);
-  if (entry != m_seqFullDelay.end()) {
-    m_firstInterestDataDelay(this, seq, Simulator::Now() - entry->time, m_seqRetxCounts[seq], hopCount);
+    m_lastRetransmittedInterestDataDelay(this, seq, Simulator::Now() - acked.lastSent, hopCount);
+    m_firstInterestDataDelay(this, seq, Simulator::Now() - acked.firstSent, acked.nSent, hopCount);
   }
 
-  m_seqRetxCounts.erase(seq);
-  m_seqFullDelay.erase(seq);
-  m_seqLastDelay.erase(seq);
-
-  m_seqTimeouts.erase(seq);
-  m_retxSeqs.erase(seq);
+  if (!m_retxSeqs.empty()) {
+    m_retxSeqs.erase(seq);
+  }
 
   m_rtt->AckSeq(SequenceNumber32(seq));
 }
@@ -279,15 +342,17 @@ void
 Consumer::WillSendOutInterest(uint32_t sequenceNumber)
 {
   NS_LOG_DEBUG("Trying to add " << sequenceNumber << " with " << Simulator::Now() << ". already "
-                                << m_seqTimeouts.size() << " items");
+                                << m_seqTable.size() << " items");
 
-  m_seqTimeouts.insert(SeqTimeout(sequenceNumber, Simulator::Now()));
-  m_seqFullDelay.insert(SeqTimeout(sequenceNumber, Simulator::Now()));
-
-  m_seqLastDelay.erase(sequenceNumber);
-  m_seqLastDelay.insert(SeqTimeout(sequenceNumber, Simulator::Now()));
-
-  m_seqRetxCounts[sequenceNumber]++;
+  Time now = Simulator::Now();
+  ConsumerSeqTable::Record& record = m_seqTable.insert(sequenceNumber);
+  if (record.nSent == 0) {
+    record.firstSent = now;
+  }
+  record.lastSent = now;
+  record.nSent++;
+  m_seqTable.startTimeout(record, now);
+  ScheduleRetxCheck();
 
   m_rtt->SentSeq(SequenceNumber32(sequenceNumber), 1);
 }
@@ -23,6 +23,7 @@
 #include "ns3/ndnSIM/model/ndn-common.hpp"
 
 #include "ndn-app.hpp"
+#include "ndn-request-generator.hpp"
 
 #include "ns3/random-variable-stream.h"
 #include "ns3/nstime.h"
@@ -30,15 +31,11 @@
 
 #include "ns3/ndnSIM/model/ndn-common.hpp"
 #include "ns3/ndnSIM/utils/ndn-rtt-estimator.hpp"
+#include "ns3/ndnSIM/utils/ndn-consumer-seq-table.hpp"
 
 #include <set>
 #include <map>
 
-#include <boost/multi_index_container.hpp>
-#include <boost/multi_index/tag.hpp>
-#include <boost/multi_index/ordered_index.hpp>
-#include <boost/multi_index/member.hpp>
-
 namespace ns3 {
 namespace ndn {
 
@@ -113,10 +110,18 @@ protected:
 
   /**
    * \brief Checks if the packet need to be retransmitted becuase of retransmission timer expiration
+   *
+   * Runs every RetxTimer while any Interest is waiting for Data.
    */
   void
   CheckRetxTimeout();
 
+  /**
+   * \brief Schedules CheckRetxTimeout for the next multiple of RetxTimer, unless already scheduled
+   */
+  void
+  ScheduleRetxCheck();
+
   /**
    * \brief Modifies the frequency of checking the retransmission timeouts
    * \param retxTimer Timeout defining how frequent retransmission timeouts should be checked
@@ -131,6 +136,21 @@ protected:
   Time
   GetRetxTimer() const;
 
+  /**
+   * \brief Schedule SendPacket for the time of the next request of the request generator, or
+   * right away if a retransmission is pending
+   */
+  void
+  ScheduleNextGeneratedPacket();
+
+  /**
+   * \brief Fetch the next request from the request generator into m_nextRequest, unless
+   * already fetched
+   * \return false if the generator has no more requests
+   */
+  bool
+  PeekNextRequest();
+
 protected:
   Ptr<UniformRandomVariable> m_rand; ///< @brief nonce generator
 
@@ -146,6 +166,11 @@ protected:
   Name m_interestName;     ///< \brief NDN Name of the Interest (use Name)
   Time m_interestLifeTime; ///< \brief LifeTime for interest packet
 
+  Ptr<RequestGenerator> m_generator;       ///< \brief Source of new requests, if any
+  Time m_generatorStart;                   ///< \brief Time the generator's request times refer to
+  bool m_hasNextRequest;                   ///< \brief Whether m_nextRequest is fetched
+  RequestGenerator::Request m_nextRequest; ///< \brief Next new request of the generator
+
   /// @cond include_hidden
   /**
    * \struct This struct contains sequence numbers of packets to be retransmitted
@@ -155,54 +180,8 @@ protected:
 
   RetxSeqsContainer m_retxSeqs; ///< \brief ordered set of sequence numbers to be retransmitted
 
-  /**
-   * \struct This struct contains a pair of packet sequence number and its timeout
-   */
-  struct SeqTimeout {
-    SeqTimeout(uint32_t _seq, Time _time)
-      : seq(_seq)
-      , time(_time)
-    {
-    }
-
-    uint32_t seq;
-    Time time;
-  };
-  /// @endcond
-
-  /// @cond include_hidden
-  class i_seq {
-  };
-  class i_timestamp {
-  };
-  /// @endcond
-
-  /// @cond include_hidden
-  /**
-   * \struct This struct contains a multi-index for the set of SeqTimeout structs
-   */
-  struct SeqTimeoutsContainer
-    : public boost::multi_index::
-        multi_index_container<SeqTimeout,
-                              boost::multi_index::
-                                indexed_by<boost::multi_index::
-                                             ordered_unique<boost::multi_index::tag<i_seq>,
-                                                            boost::multi_index::
-                                                              member<SeqTimeout, uint32_t,
-                                                                     &SeqTimeout::seq>>,
-                                           boost::multi_index::
-                                             ordered_non_unique<boost::multi_index::
-                                                                  tag<i_timestamp>,
-                                                                boost::multi_index::
-                                                                  member<SeqTimeout, Time,
-                                                                         &SeqTimeout::time>>>> {
-  };
-
-  SeqTimeoutsContainer m_seqTimeouts; ///< \brief multi-index for the set of SeqTimeout structs
-
-  SeqTimeoutsContainer m_seqLastDelay;
-  SeqTimeoutsContainer m_seqFullDelay;
-  std::map<uint32_t, uint32_t> m_seqRetxCounts;
+  ConsumerSeqTable m_seqTable; ///< \brief records of Interests waiting for Data
+  Time m_retxTimerStart;       ///< \brief time CheckRetxTimeout runs are counted from
 
   TracedCallback<Ptr<App> /* app */, uint32_t /* seqno */, Time /* delay */, int32_t /*hop count*/>
     m_lastRetransmittedInterestDataDelay;
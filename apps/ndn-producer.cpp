@@ -51,19 +51,22 @@ Producer::GetTypeId(void)
          "Postfix that is added to the output data (e.g., for adding producer-uniqueness)",
          StringValue("/"), MakeNameAccessor(&Producer::m_postfix), MakeNameChecker())
       .AddAttribute("PayloadSize", "Virtual payload size for Content packets", UintegerValue(1024),
-                    MakeUintegerAccessor(&Producer::m_virtualPayloadSize),
+                    MakeUintegerAccessor(&Producer::GetPayloadSize, &Producer::SetPayloadSize),
                     MakeUintegerChecker<uint32_t>())
       .AddAttribute("Freshness", "Freshness of data packets, if 0, then unlimited freshness",
-                    TimeValue(Seconds(0)), MakeTimeAccessor(&Producer::m_freshness),
+                    TimeValue(Seconds(0)),
+                    MakeTimeAccessor(&Producer::GetFreshness, &Producer::SetFreshness),
                     MakeTimeChecker())
       .AddAttribute(
          "Signature",
          "Fake signature, 0 valid signature (default), other values application-specific",
-         UintegerValue(0), MakeUintegerAccessor(&Producer::m_signature),
+         UintegerValue(0), MakeUintegerAccessor(&Producer::GetSignature, &Producer::SetSignature),
          MakeUintegerChecker<uint32_t>())
       .AddAttribute("KeyLocator",
                     "Name to be used for key locator.  If root, then key locator is not used",
-                    NameValue(), MakeNameAccessor(&Producer::m_keyLocator), MakeNameChecker());
+                    NameValue(),
+                    MakeNameAccessor(&Producer::GetKeyLocator, &Producer::SetKeyLocator),
+                    MakeNameChecker());
   return tid;
 }
 
@@ -104,31 +107,71 @@ Producer::OnInterest(shared_ptr<const Interest> interest)
   // dataName.append(m_postfix);
   // dataName.appendVersion();
 
-  auto data = make_shared<Data>();
-  data->setName(dataName);
-  data->setFreshnessPeriod(::ndn::time::milliseconds(m_freshness.GetMilliSeconds()));
+  // MetaInfo, virtual payload, and fake signature are pre-encoded in the template, which is
+  // rebuilt after any of them changes
+  if (m_dataTemplate == nullptr) {
+    ::ndn::time::milliseconds freshness(m_freshness.GetMilliSeconds());
+    m_dataTemplate = make_unique<DataTemplate>(m_virtualPayloadSize, freshness, m_signature,
+                                               m_keyLocator);
+  }
+  auto data = m_dataTemplate->makeData(dataName);
 
-  data->setContent(make_shared< ::ndn::Buffer>(m_virtualPayloadSize));
+  NS_LOG_INFO("node(" << GetNode()->GetId() << ") responding with Data: " << data->getName());
 
-  Signature signature;
-  SignatureInfo signatureInfo(static_cast< ::ndn::tlv::SignatureTypeValue>(255));
+  m_transmittedDatas(data, this, m_face);
+  m_appLink->onReceiveData(*data);
+}
 
-  if (m_keyLocator.size() > 0) {
-    signatureInfo.setKeyLocator(m_keyLocator);
-  }
+void
+Producer::SetPayloadSize(uint32_t payloadSize)
+{
+  m_virtualPayloadSize = payloadSize;
+  m_dataTemplate.reset();
+}
 
-  signature.setInfo(signatureInfo);
-  signature.setValue(::ndn::makeNonNegativeIntegerBlock(::ndn::tlv::SignatureValue, m_signature));
+uint32_t
+Producer::GetPayloadSize() const
+{
+  return m_virtualPayloadSize;
+}
 
-  data->setSignature(signature);
+void
+Producer::SetFreshness(Time freshness)
+{
+  m_freshness = freshness;
+  m_dataTemplate.reset();
+}
 
-  NS_LOG_INFO("node(" << GetNode()->GetId() << ") responding with Data: " << data->getName());
+Time
+Producer::GetFreshness() const
+{
+  return m_freshness;
+}
 
-  // to create real wire encoding
-  data->wireEncode();
+void
+Producer::SetSignature(uint32_t signature)
+{
+  m_signature = signature;
+  m_dataTemplate.reset();
+}
 
-  m_transmittedDatas(data, this, m_face);
-  m_appLink->onReceiveData(*data);
+uint32_t
+Producer::GetSignature() const
+{
+  return m_signature;
+}
+
+void
+Producer::SetKeyLocator(Name keyLocator)
+{
+  m_keyLocator = keyLocator;
+  m_dataTemplate.reset();
+}
+
+Name
+Producer::GetKeyLocator() const
+{
+  return m_keyLocator;
 }
 
 } // namespace ndn
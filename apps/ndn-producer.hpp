@@ -24,6 +24,7 @@
 
 #include "ndn-app.hpp"
 #include "ns3/ndnSIM/model/ndn-common.hpp"
+#include "ns3/ndnSIM/utils/ndn-data-template.hpp"
 
 #include "ns3/nstime.h"
 #include "ns3/ptr.h"
@@ -59,6 +60,31 @@ protected:
   virtual void
   StopApplication(); // Called at time specified by Stop
 
+private:
+  void
+  SetPayloadSize(uint32_t payloadSize);
+
+  uint32_t
+  GetPayloadSize() const;
+
+  void
+  SetFreshness(Time freshness);
+
+  Time
+  GetFreshness() const;
+
+  void
+  SetSignature(uint32_t signature);
+
+  uint32_t
+  GetSignature() const;
+
+  void
+  SetKeyLocator(Name keyLocator);
+
+  Name
+  GetKeyLocator() const;
+
 private:
   Name m_prefix;
   Name m_postfix;
@@ -67,6 +93,8 @@ private:
 
   uint32_t m_signature;
   Name m_keyLocator;
+
+  std::unique_ptr<DataTemplate> m_dataTemplate; ///< built on demand, reset by the setters
 };
 
 } // namespace ndn
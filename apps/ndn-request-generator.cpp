@@ -0,0 +1,230 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2016  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-request-generator.hpp"
+
+#include "ns3/ndnSIM/utils/ndn-request-trace.hpp"
+
+#include "ns3/log.h"
+#include "ns3/string.h"
+#include "ns3/double.h"
+#include "ns3/pointer.h"
+
+#include <algorithm>
+
+NS_LOG_COMPONENT_DEFINE("ndn.RequestGenerator");
+
+namespace ns3 {
+namespace ndn {
+
+NS_OBJECT_ENSURE_REGISTERED(RequestGenerator);
+NS_OBJECT_ENSURE_REGISTERED(TraceRequestGenerator);
+NS_OBJECT_ENSURE_REGISTERED(ShotNoiseRequestGenerator);
+
+// number of replayed records after which pages of the trace are given back
+static const size_t RELEASE_INTERVAL = 1 << 20;
+
+// number of consecutive contents without requests after which the shot noise model gives up
+static const uint32_t MAX_EMPTY_CONTENTS = 1000000;
+
+TypeId
+RequestGenerator::GetTypeId()
+{
+  static TypeId tid =
+    TypeId("ns3::ndn::RequestGenerator")
+      .SetGroupName("Ndn")
+      .SetParent<Object>();
+  return tid;
+}
+
+RequestGenerator::RequestGenerator()
+  : m_owner(nullptr)
+{
+}
+
+void
+RequestGenerator::Attach(const void* owner)
+{
+  if (m_owner != nullptr && m_owner != owner) {
+    NS_FATAL_ERROR("RequestGenerator cannot be shared between consumers");
+  }
+  m_owner = owner;
+}
+
+int64_t
+RequestGenerator::AssignStreams(int64_t stream)
+{
+  return 0;
+}
+
+TypeId
+TraceRequestGenerator::GetTypeId()
+{
+  static TypeId tid =
+    TypeId("ns3::ndn::TraceRequestGenerator")
+      .SetGroupName("Ndn")
+      .SetParent<RequestGenerator>()
+      .AddConstructor<TraceRequestGenerator>()
+      .AddAttribute("File", "Name of the request trace file to replay", StringValue(""),
+                    MakeStringAccessor(&TraceRequestGenerator::m_fileName),
+                    MakeStringChecker());
+  return tid;
+}
+
+TraceRequestGenerator::TraceRequestGenerator()
+  : m_firstTimestamp(0)
+  , m_next(0)
+  , m_released(0)
+{
+}
+
+bool
+TraceRequestGenerator::GetNextRequest(Request& request)
+{
+  if (m_trace == nullptr) {
+    try {
+      m_trace = RequestTrace::open(m_fileName);
+    }
+    catch (const RequestTrace::Error& e) {
+      NS_FATAL_ERROR(e.what());
+    }
+    NS_LOG_DEBUG("Replaying " << m_trace->size() << " requests from " << m_fileName);
+
+    if (m_trace->size() > 0) {
+      m_firstTimestamp = m_trace->get(0).timestamp;
+    }
+  }
+
+  if (m_next >= m_trace->size()) {
+    return false;
+  }
+
+  RequestTrace::Record record = m_trace->get(m_next++);
+  request.time = NanoSeconds(record.timestamp >= m_firstTimestamp ?
+                             record.timestamp - m_firstTimestamp : 0);
+  request.seq = record.nameId;
+
+  if (m_next - m_released >= RELEASE_INTERVAL) {
+    m_trace->release(m_next);
+    m_released = m_next;
+  }
+  return true;
+}
+
+TypeId
+ShotNoiseRequestGenerator::GetTypeId()
+{
+  static TypeId tid =
+    TypeId("ns3::ndn::ShotNoiseRequestGenerator")
+      .SetGroupName("Ndn")
+      .SetParent<RequestGenerator>()
+      .AddConstructor<ShotNoiseRequestGenerator>()
+      .AddAttribute("ContentRate", "Rate (per second) at which new contents appear",
+                    DoubleValue(1.0),
+                    MakeDoubleAccessor(&ShotNoiseRequestGenerator::m_contentRate),
+                    MakeDoubleChecker<double>(0.0))
+      .AddAttribute("Volume", "Random variable for the mean number of requests of a content",
+                    StringValue("ns3::ExponentialRandomVariable[Mean=100.0]"),
+                    MakePointerAccessor(&ShotNoiseRequestGenerator::m_volume),
+                    MakePointerChecker<RandomVariableStream>())
+      .AddAttribute("Lifetime", "Random variable for the mean delay (in seconds) of the "
+                    "requests of a content after it appears",
+                    StringValue("ns3::ExponentialRandomVariable[Mean=10.0]"),
+                    MakePointerAccessor(&ShotNoiseRequestGenerator::m_lifetime),
+                    MakePointerChecker<RandomVariableStream>());
+  return tid;
+}
+
+ShotNoiseRequestGenerator::ShotNoiseRequestGenerator()
+  : m_contentRate(1.0)
+  , m_exponential(CreateObject<ExponentialRandomVariable>())
+  , m_uniform(CreateObject<UniformRandomVariable>())
+  , m_isStarted(false)
+  , m_nContents(0)
+  , m_nEmptyContents(0)
+{
+}
+
+bool
+ShotNoiseRequestGenerator::GetNextRequest(Request& request)
+{
+  if (!m_isStarted && m_contentRate > 0.0) {
+    m_nextContentTime = Seconds(m_exponential->GetValue(1.0 / m_contentRate, 0));
+    m_isStarted = true;
+  }
+
+  // requests of a content never precede its appearance, so once the earliest pending
+  // request is due before the next content appears, no other request can come earlier
+  while (m_contentRate > 0.0 &&
+         (m_pending.empty() ? m_nEmptyContents < MAX_EMPTY_CONTENTS :
+                              m_pending.top().first > m_nextContentTime)) {
+    AddContent();
+  }
+
+  if (m_pending.empty()) {
+    if (m_nEmptyContents >= MAX_EMPTY_CONTENTS) {
+      NS_LOG_WARN("No requests in the last " << m_nEmptyContents << " contents (Volume is "
+                  "likely always zero), no more requests are generated");
+    }
+    return false;
+  }
+
+  request.time = m_pending.top().first;
+  request.seq = m_pending.top().second;
+  m_pending.pop();
+  return true;
+}
+
+void
+ShotNoiseRequestGenerator::AddContent()
+{
+  uint32_t seq = m_nContents++;
+  Time appearance = m_nextContentTime;
+
+  double volume = std::max(m_volume->GetValue(), 0.0);
+  uint32_t nRequests = static_cast<uint32_t>(volume);
+  if (m_uniform->GetValue() < volume - nRequests) {
+    ++nRequests;
+  }
+
+  m_nEmptyContents = nRequests > 0 ? 0 : m_nEmptyContents + 1;
+
+  double lifetime = std::max(m_lifetime->GetValue(), 0.0);
+  for (uint32_t i = 0; i < nRequests; i++) {
+    Time delay = lifetime > 0 ? Seconds(m_exponential->GetValue(lifetime, 0)) : Seconds(0);
+    m_pending.push(PendingRequest(appearance + delay, seq));
+  }
+  NS_LOG_DEBUG("Content " << seq << " appears at " << appearance << " with " << nRequests
+               << " requests, lifetime " << lifetime << "s");
+
+  m_nextContentTime = appearance + Seconds(m_exponential->GetValue(1.0 / m_contentRate, 0));
+}
+
+int64_t
+ShotNoiseRequestGenerator::AssignStreams(int64_t stream)
+{
+  m_exponential->SetStream(stream);
+  m_uniform->SetStream(stream + 1);
+  m_volume->SetStream(stream + 2);
+  m_lifetime->SetStream(stream + 3);
+  return 4;
+}
+
+} // namespace ndn
+} // namespace ns3
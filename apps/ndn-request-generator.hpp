@@ -0,0 +1,174 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2016  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_REQUEST_GENERATOR_H
+#define NDN_REQUEST_GENERATOR_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ns3/object.h"
+#include "ns3/nstime.h"
+#include "ns3/random-variable-stream.h"
+
+#include <queue>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+class RequestTrace;
+
+/**
+ * @ingroup ndn-apps
+ * @brief Base class of models that decide which sequence numbers a Consumer requests and when
+ *
+ * A generator is set on a consumer with its RequestGenerator attribute.  Open-loop consumers
+ * (ConsumerCbr, ConsumerZipfMandelbrot) then send each new Interest at the time given by the
+ * generator; window- and batch-driven consumers keep their own pacing and only take sequence
+ * numbers from the generator.  Retransmissions are handled by the consumer as usual.
+ *
+ * A generator keeps the state of one request stream and therefore belongs to a single
+ * consumer.
+ */
+class RequestGenerator : public Object
+{
+public:
+  static TypeId
+  GetTypeId();
+
+  struct Request
+  {
+    Time time;    ///< since the consumer started
+    uint32_t seq;
+  };
+
+  RequestGenerator();
+
+  /**
+   * @brief Bind the generator to @p owner; aborts if it is already bound to another one
+   */
+  void
+  Attach(const void* owner);
+
+  /**
+   * @brief Get the next request; requests are returned in non-decreasing time order
+   * @return false if there are no more requests
+   */
+  virtual bool
+  GetNextRequest(Request& request) = 0;
+
+  /**
+   * @brief Assign fixed random variable stream numbers to the random variables used by
+   *        this model
+   * @return the number of streams (possibly zero) that have been assigned
+   */
+  virtual int64_t
+  AssignStreams(int64_t stream);
+
+private:
+  const void* m_owner;
+};
+
+/**
+ * @ingroup ndn-apps
+ * @brief Replays a RequestTrace
+ *
+ * Record i is requested at (timestamp(i) - timestamp(0)) after the consumer starts, with the
+ * name ID as sequence number.  Records are read from the memory-mapped file as they are
+ * replayed and pages already replayed are given back periodically, so memory use does not
+ * grow with the length of the trace.
+ */
+class TraceRequestGenerator : public RequestGenerator
+{
+public:
+  static TypeId
+  GetTypeId();
+
+  TraceRequestGenerator();
+
+  virtual bool
+  GetNextRequest(Request& request) override;
+
+private:
+  std::string m_fileName;
+
+  shared_ptr<const RequestTrace> m_trace; // mapped on the first request
+  uint64_t m_firstTimestamp;
+  size_t m_next;
+  size_t m_released;
+};
+
+/**
+ * @ingroup ndn-apps
+ * @brief Shot Noise Model (SNM) of time-varying content popularity
+ *
+ * New contents appear as a Poisson process with rate ContentRate, and are numbered in the
+ * order they appear.  Each content is given a volume V drawn from Volume and a lifetime L
+ * drawn from Lifetime.  It is then requested V times (rounded at random to one of the
+ * nearest integers), each request following the appearance of the content by an
+ * exponentially distributed delay with mean L, i.e., the popularity of every content
+ * decays exponentially after it appears.
+ *
+ * Requests of a content are generated when it appears and held in a heap until they are
+ * due, so the cost per request is O(log P) for P pending requests.  The catalog starts
+ * empty; requests in the first few lifetimes form a warm-up period.
+ *
+ * If a million contents in a row get no requests (e.g., Volume is always zero), the
+ * generator stops rather than searching for a request forever.
+ */
+class ShotNoiseRequestGenerator : public RequestGenerator
+{
+public:
+  static TypeId
+  GetTypeId();
+
+  ShotNoiseRequestGenerator();
+
+  virtual bool
+  GetNextRequest(Request& request) override;
+
+  virtual int64_t
+  AssignStreams(int64_t stream) override;
+
+private:
+  void
+  AddContent();
+
+private:
+  double m_contentRate;
+  Ptr<RandomVariableStream> m_volume;
+  Ptr<RandomVariableStream> m_lifetime;
+
+  Ptr<ExponentialRandomVariable> m_exponential;
+  Ptr<UniformRandomVariable> m_uniform;
+
+  bool m_isStarted;
+  Time m_nextContentTime;
+  uint32_t m_nContents;
+  uint32_t m_nEmptyContents; ///< consecutive contents without requests
+
+  typedef std::pair<Time, uint32_t> PendingRequest;
+  std::priority_queue<PendingRequest, std::vector<PendingRequest>,
+                      std::greater<PendingRequest>> m_pending;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_REQUEST_GENERATOR_H
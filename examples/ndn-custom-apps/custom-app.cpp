@@ -28,6 +28,7 @@
 
 #include "ns3/ndnSIM/helper/ndn-stack-helper.hpp"
 #include "ns3/ndnSIM/helper/ndn-fib-helper.hpp"
+#include "ns3/ndnSIM/utils/ndn-data-template.hpp"
 
 #include "ns3/random-variable-stream.h"
 
@@ -100,7 +101,8 @@ CustomApp::OnInterest(std::shared_ptr<const ndn::Interest> interest)
 
   auto data = std::make_shared<ndn::Data>(interest->getName());
   data->setFreshnessPeriod(ndn::time::milliseconds(1000));
-  data->setContent(std::make_shared< ::ndn::Buffer>(1024));
+  // virtual payload buffers are shared, read-only, and need not be allocated per Data
+  data->setContent(ndn::DataTemplate::getVirtualPayload(1024));
   ndn::StackHelper::getKeyChain().sign(*data);
 
   NS_LOG_DEBUG("Sending Data packet for " << data->getName());
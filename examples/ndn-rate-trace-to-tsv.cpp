@@ -0,0 +1,67 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-rate-trace-to-tsv.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/ndnSIM-module.h"
+
+namespace ns3 {
+
+/**
+ * This program converts a rate trace written by ndn::L3RateTracer in binary format (global
+ * value NdnL3RateTracerFormat set to "binary") into the usual tab-separated values:
+ *
+ *     ./waf --run="ndn-tree-tracers --NdnL3RateTracerFormat=binary"
+ *     ./waf --run="ndn-rate-trace-to-tsv --input=rate-trace.txt --output=rate-trace.tsv"
+ *
+ * If output is "-" (the default), the converted trace is written to the standard output.
+ */
+
+int
+main(int argc, char* argv[])
+{
+  std::string input;
+  std::string output = "-";
+
+  CommandLine cmd;
+  cmd.AddValue("input", "Binary rate trace", input);
+  cmd.AddValue("output", "File to write tab-separated values into, - for standard output", output);
+  cmd.Parse(argc, argv);
+
+  if (input.empty()) {
+    std::cerr << "Input trace is not specified (--input)" << std::endl;
+    return 1;
+  }
+
+  if (!ndn::L3RateTracer::ConvertToTsv(input, output)) {
+    std::cerr << "Cannot convert " << input << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  return ns3::main(argc, argv);
+}
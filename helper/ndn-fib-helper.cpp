@@ -37,16 +37,41 @@
 #include "ns3/callback.h"
 #include "ns3/node-list.h"
 #include "ns3/data-rate.h"
+#include "ns3/global-value.h"
+#include "ns3/boolean.h"
 
 #include "daemon/mgmt/fib-manager.hpp"
 #include "ns3/ndnSIM/model/ndn-l3-protocol.hpp"
 #include "ns3/ndnSIM/helper/ndn-stack-helper.hpp"
 
+#include <chrono>
+
 namespace ns3 {
 namespace ndn {
 
 NS_LOG_COMPONENT_DEFINE("ndn.FibHelper");
 
+static GlobalValue g_fibDirectInstall("NdnFibDirectInstall",
+                                      "Whether FibHelper::AddRoutes/RemoveRoutes write straight "
+                                      "into FIB instead of sending command Interests",
+                                      BooleanValue(true), MakeBooleanChecker());
+
+static FibHelper::InstallStats g_installStats;
+
+static bool
+isDirectInstall()
+{
+  BooleanValue isDirect;
+  g_fibDirectInstall.GetValue(isDirect);
+  return isDirect.Get();
+}
+
+static double
+getWallClockSeconds(std::chrono::steady_clock::time_point since)
+{
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - since).count();
+}
+
 void
 FibHelper::AddNextHop(const ControlParameters& parameters, Ptr<Node> node)
 {
@@ -256,6 +281,82 @@ FibHelper::RemoveRoute(const std::string& nodeName, const Name& prefix,
   RemoveRoute(node, prefix, otherNode);
 }
 
+void
+FibHelper::AddRoutes(Ptr<Node> node, const std::vector<Route>& routes)
+{
+  auto start = std::chrono::steady_clock::now();
+
+  if (isDirectInstall()) {
+    Ptr<L3Protocol> l3 = node->GetObject<L3Protocol>();
+    NS_ASSERT_MSG(l3 != 0, "Ndn stack should be installed on the node");
+
+    std::vector<L3Protocol::NextHop> nextHops;
+    nextHops.reserve(routes.size());
+    for (const auto& route : routes) {
+      nextHops.emplace_back(std::get<0>(route), std::get<1>(route)->getId(), std::get<2>(route));
+    }
+    l3->addNextHops(nextHops);
+
+    g_installStats.nDirect += routes.size();
+    g_installStats.directSeconds += getWallClockSeconds(start);
+  }
+  else {
+    for (const auto& route : routes) {
+      AddRoute(node, std::get<0>(route), std::get<1>(route), std::get<2>(route));
+    }
+
+    g_installStats.nCommands += routes.size();
+    g_installStats.commandSeconds += getWallClockSeconds(start);
+  }
+
+  NS_LOG_DEBUG("[" << node->GetId() << "]$ added " << routes.size() << " routes in "
+               << getWallClockSeconds(start) << " s");
+}
+
+void
+FibHelper::RemoveRoutes(Ptr<Node> node, const std::vector<Route>& routes)
+{
+  auto start = std::chrono::steady_clock::now();
+
+  if (isDirectInstall()) {
+    Ptr<L3Protocol> l3 = node->GetObject<L3Protocol>();
+    NS_ASSERT_MSG(l3 != 0, "Ndn stack should be installed on the node");
+
+    std::vector<L3Protocol::NextHop> nextHops;
+    nextHops.reserve(routes.size());
+    for (const auto& route : routes) {
+      nextHops.emplace_back(std::get<0>(route), std::get<1>(route)->getId(), 0);
+    }
+    l3->removeNextHops(nextHops);
+
+    g_installStats.nDirect += routes.size();
+    g_installStats.directSeconds += getWallClockSeconds(start);
+  }
+  else {
+    for (const auto& route : routes) {
+      RemoveRoute(node, std::get<0>(route), std::get<1>(route));
+    }
+
+    g_installStats.nCommands += routes.size();
+    g_installStats.commandSeconds += getWallClockSeconds(start);
+  }
+
+  NS_LOG_DEBUG("[" << node->GetId() << "]$ removed " << routes.size() << " routes in "
+               << getWallClockSeconds(start) << " s");
+}
+
+const FibHelper::InstallStats&
+FibHelper::GetInstallStats()
+{
+  return g_installStats;
+}
+
+void
+FibHelper::ResetInstallStats()
+{
+  g_installStats = InstallStats();
+}
+
 } // namespace ndn
 
 } // namespace ns
@@ -28,6 +28,9 @@
 
 #include <ndn-cxx/management/nfd-control-parameters.hpp>
 
+#include <tuple>
+#include <vector>
+
 namespace ns3 {
 namespace ndn {
 
@@ -150,6 +153,54 @@ public:
   static void
   RemoveRoute(const std::string& nodeName, const Name& prefix, const std::string& otherNodeName);
 
+  /**
+   * \brief Route: prefix, face, and metric
+   */
+  typedef std::tuple<Name, shared_ptr<Face>, int32_t> Route;
+
+  /**
+   * \brief Add many forwarding entries to FIB of a node at once
+   *
+   * By default, the routes are written straight into FIB using L3Protocol::addNextHops,
+   * which saves creating, signing, and dispatching a command Interest for every route.  If
+   * the NdnFibDirectInstall global value is false, every route is added with AddRoute
+   * (i.e., through the FIB manager) instead.
+   *
+   * \param node   Node
+   * \param routes Routes to add; existing next hops get the new metric
+   */
+  static void
+  AddRoutes(Ptr<Node> node, const std::vector<Route>& routes);
+
+  /**
+   * \brief Remove many forwarding entries from FIB of a node at once
+   *
+   * Uses the same path as AddRoutes.
+   *
+   * \param node   Node
+   * \param routes Routes to remove (metrics are ignored)
+   */
+  static void
+  RemoveRoutes(Ptr<Node> node, const std::vector<Route>& routes);
+
+  /**
+   * \brief Number of routes added or removed by AddRoutes/RemoveRoutes and the wall-clock
+   *        time spent on them, for each installation path
+   */
+  struct InstallStats
+  {
+    uint64_t nDirect;
+    double directSeconds;
+    uint64_t nCommands;
+    double commandSeconds;
+  };
+
+  static const InstallStats&
+  GetInstallStats();
+
+  static void
+  ResetInstallStats();
+
 private:
   static void
   GenerateCommand(Interest& interest);
@@ -0,0 +1,754 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#include "ndn-global-routing-engine.hpp"
+
+#include "model/ndn-global-router.hpp"
+#include "helper/ndn-fib-helper.hpp"
+
+#include "ns3/node.h"
+#include "ns3/node-list.h"
+#include "ns3/channel.h"
+#include "ns3/channel-list.h"
+#include "ns3/simulator.h"
+#include "ns3/global-value.h"
+#include "ns3/uinteger.h"
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <thread>
+
+NS_LOG_COMPONENT_DEFINE("ndn.GlobalRoutingEngine");
+
+namespace ns3 {
+namespace ndn {
+
+static GlobalValue g_globalRoutingThreads("NdnGlobalRoutingThreads",
+                                          "Number of threads used to compute global routes "
+                                          "(0 to use one thread per hardware core)",
+                                          UintegerValue(0), MakeUintegerChecker<uint32_t>());
+
+static GlobalValue g_globalRoutingMaxPaths("NdnGlobalRoutingMaxPaths",
+                                           "Maximum number of faces used towards each origin by "
+                                           "GlobalRoutingHelper::CalculateAllPossibleRoutes "
+                                           "(0 for no limit)",
+                                           UintegerValue(0), MakeUintegerChecker<uint32_t>());
+
+static const uint32_t INFINITE_DISTANCE = std::numeric_limits<uint32_t>::max();
+
+static size_t
+getNThreads()
+{
+  UintegerValue nThreads;
+  g_globalRoutingThreads.GetValue(nThreads);
+  if (nThreads.Get() > 0) {
+    return nThreads.Get();
+  }
+  return std::max(std::thread::hardware_concurrency(), 1u);
+}
+
+/**
+ * @brief Run task(i, workspace) for i in [0, nTasks) on a pool of worker threads, each with
+ *        its own Workspace
+ */
+template<typename Workspace, typename Task>
+static void
+runParallel(size_t nTasks, const Task& task)
+{
+  size_t nThreads = std::min(getNThreads(), nTasks);
+
+  std::atomic<size_t> next(0);
+  auto worker = [nTasks, &task, &next] {
+    Workspace ws;
+    for (size_t i = next++; i < nTasks; i = next++) {
+      task(i, ws);
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < nThreads; ++i) {
+    threads.emplace_back(worker);
+  }
+  worker();
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+static void
+logInstallStats(const FibHelper::InstallStats& before)
+{
+  const FibHelper::InstallStats& after = FibHelper::GetInstallStats();
+  NS_LOG_INFO("FIB updated: " << after.nDirect - before.nDirect << " routes written directly in "
+              << after.directSeconds - before.directSeconds << " s, "
+              << after.nCommands - before.nCommands << " routes via commands in "
+              << after.commandSeconds - before.commandSeconds << " s");
+}
+
+GlobalRoutingEngine&
+GlobalRoutingEngine::Get()
+{
+  static GlobalRoutingEngine instance;
+  return instance;
+}
+
+GlobalRoutingEngine::GlobalRoutingEngine()
+  : m_hasSnapshot(false)
+  , m_isMultipath(false)
+  , m_nRecomputed(0)
+  , m_isCleanupScheduled(false)
+{
+}
+
+void
+GlobalRoutingEngine::CalculateRoutes()
+{
+  scheduleCleanup();
+  takeSnapshot();
+  m_isMultipath = false;
+
+  std::vector<uint32_t> sources(m_sources.size());
+  std::iota(sources.begin(), sources.end(), 0);
+
+  computeSources(sources);
+  m_nRecomputed = sources.size();
+
+  installRoutes(sources);
+}
+
+void
+GlobalRoutingEngine::CalculateAllPossibleRoutes()
+{
+  scheduleCleanup();
+  takeSnapshot();
+  m_isMultipath = true;
+
+  UintegerValue maxPaths;
+  g_globalRoutingMaxPaths.GetValue(maxPaths);
+
+  // origins are processed in chunks to bound the memory taken by intermediate results
+  static const size_t CHUNK_SIZE = 64;
+
+  std::vector<RouteSet> routeSets(m_sources.size());
+  for (size_t first = 0; first < m_origins.size(); first += CHUNK_SIZE) {
+    std::vector<std::vector<MultipathRoute>> results(std::min(CHUNK_SIZE,
+                                                              m_origins.size() - first));
+    runParallel<MultipathWorkspace>(results.size(), [&] (size_t i, MultipathWorkspace& ws) {
+        computeMultipathRoutes(first + i, maxPaths.Get(), ws, results[i]);
+      });
+
+    for (size_t i = 0; i < results.size(); ++i) {
+      for (const auto& prefix : m_routers[m_origins[first + i]]->GetLocalPrefixes()) {
+        for (const auto& route : results[i]) {
+          auto key = std::make_pair(*prefix, m_faces[route.face]);
+          auto entry = routeSets[route.source].emplace(key, route.cost);
+          if (!entry.second) {
+            entry.first->second = std::min(entry.first->second, route.cost);
+          }
+        }
+      }
+    }
+  }
+
+  m_nRecomputed = m_sources.size();
+
+  FibHelper::InstallStats before = FibHelper::GetInstallStats();
+  for (uint32_t source = 0; source < m_sources.size(); ++source) {
+    applyRoutes(source, routeSets[source]);
+  }
+  logInstallStats(before);
+}
+
+void
+GlobalRoutingEngine::RecalculateRoutes()
+{
+  if (!m_hasSnapshot) {
+    CalculateRoutes();
+    return;
+  }
+
+  if (m_isMultipath) {
+    // multipath routes are cheap enough to be recalculated from scratch
+    CalculateAllPossibleRoutes();
+    return;
+  }
+
+  // changes are applied one at a time, so that affected sources of every change are
+  // determined from routes that are consistent with the state right before it
+  std::vector<uint8_t> isRecomputed(m_sources.size(), 0);
+  for (const auto& change : m_pendingChanges) {
+    std::vector<uint32_t> edges;
+    for (const Face* face : {change.face1, change.face2}) {
+      auto edge = m_faceEdges.find(face);
+      if (edge != m_faceEdges.end() && m_isEdgeUp[edge->second] != change.isUp) {
+        edges.push_back(edge->second);
+      }
+    }
+    if (edges.empty()) {
+      continue;
+    }
+
+    std::vector<uint8_t> isAffected(m_sources.size(), 0);
+    for (uint32_t edge : edges) {
+      findAffectedSources(edge, change.isUp, isAffected);
+    }
+    for (uint32_t edge : edges) {
+      m_isEdgeUp[edge] = change.isUp;
+    }
+
+    std::vector<uint32_t> affected;
+    for (uint32_t source = 0; source < m_sources.size(); ++source) {
+      if (isAffected[source]) {
+        affected.push_back(source);
+        isRecomputed[source] = 1;
+      }
+    }
+    NS_LOG_DEBUG("Link " << (change.isUp ? "up" : "down") << ": recomputing "
+                 << affected.size() << " of " << m_sources.size() << " nodes");
+
+    computeSources(affected);
+  }
+  m_pendingChanges.clear();
+
+  std::vector<uint32_t> recomputed;
+  for (uint32_t source = 0; source < m_sources.size(); ++source) {
+    if (isRecomputed[source]) {
+      recomputed.push_back(source);
+    }
+  }
+  m_nRecomputed = recomputed.size();
+
+  installRoutes(recomputed);
+}
+
+void
+GlobalRoutingEngine::NotifyLinkStatus(const Face& face1, const Face& face2, bool isUp)
+{
+  scheduleCleanup();
+
+  if (isUp) {
+    m_downFaces.erase(&face1);
+    m_downFaces.erase(&face2);
+  }
+  else {
+    m_downFaces.insert(&face1);
+    m_downFaces.insert(&face2);
+  }
+
+  if (m_hasSnapshot) {
+    m_pendingChanges.push_back({&face1, &face2, isUp});
+  }
+}
+
+size_t
+GlobalRoutingEngine::GetNRecomputed() const
+{
+  return m_nRecomputed;
+}
+
+void
+GlobalRoutingEngine::Clear()
+{
+  m_routers.clear();
+  m_vertexSource.clear();
+  m_sources.clear();
+  m_origins.clear();
+  m_offsets.clear();
+  m_targets.clear();
+  m_weights.clear();
+  m_edgeFaces.clear();
+  m_isEdgeUp.clear();
+  m_faces.clear();
+  m_faceEdges.clear();
+  m_reverseOffsets.clear();
+  m_reverseEdges.clear();
+  m_edgeSources.clear();
+  m_routes.clear();
+  m_hasSnapshot = false;
+  m_isMultipath = false;
+  m_downFaces.clear();
+  m_pendingChanges.clear();
+  m_installed.clear();
+  m_nRecomputed = 0;
+  m_isCleanupScheduled = false;
+}
+
+void
+GlobalRoutingEngine::takeSnapshot()
+{
+  m_routers.clear();
+  m_vertexSource.clear();
+  m_sources.clear();
+  m_origins.clear();
+
+  std::unordered_map<const GlobalRouter*, uint32_t> vertices;
+
+  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
+    Ptr<GlobalRouter> gr = (*node)->GetObject<GlobalRouter>();
+    if (gr == 0) {
+      NS_LOG_DEBUG("Node " << (*node)->GetId() << " does not export GlobalRouter interface");
+      continue;
+    }
+
+    uint32_t vertex = m_routers.size();
+    vertices[PeekPointer(gr)] = vertex;
+    m_routers.push_back(gr);
+    m_vertexSource.push_back(m_sources.size());
+    m_sources.push_back(vertex);
+    if (!gr->GetLocalPrefixes().empty()) {
+      m_origins.push_back(vertex);
+    }
+  }
+
+  for (ChannelList::Iterator channel = ChannelList::Begin(); channel != ChannelList::End();
+       channel++) {
+    Ptr<GlobalRouter> gr = (*channel)->GetObject<GlobalRouter>();
+    if (gr == 0) {
+      continue;
+    }
+
+    vertices[PeekPointer(gr)] = m_routers.size();
+    m_routers.push_back(gr);
+    m_vertexSource.push_back(-1);
+  }
+
+  m_offsets.assign(1, 0);
+  m_targets.clear();
+  m_weights.clear();
+  m_edgeFaces.clear();
+  m_isEdgeUp.clear();
+  m_edgeSources.clear();
+  m_faces.clear();
+  m_faceEdges.clear();
+
+  for (uint32_t vertex = 0; vertex < m_routers.size(); ++vertex) {
+    for (const auto& incidency : m_routers[vertex]->GetIncidencies()) {
+      auto target = vertices.find(PeekPointer(std::get<2>(incidency)));
+      if (target == vertices.end()) {
+        continue;
+      }
+
+      const shared_ptr<Face>& face = std::get<1>(incidency);
+      uint32_t edge = m_targets.size();
+      m_targets.push_back(target->second);
+      m_edgeSources.push_back(vertex);
+      if (face != nullptr) {
+        m_weights.push_back(face->getMetric());
+        m_edgeFaces.push_back(m_faces.size());
+        m_isEdgeUp.push_back(m_downFaces.count(face.get()) == 0);
+        m_faceEdges[face.get()] = edge;
+        m_faces.push_back(face);
+      }
+      else {
+        m_weights.push_back(0);
+        m_edgeFaces.push_back(-1);
+        m_isEdgeUp.push_back(1);
+      }
+    }
+    m_offsets.push_back(m_targets.size());
+  }
+
+  // reverse adjacency (counting sort of edges by target)
+  m_reverseOffsets.assign(m_routers.size() + 1, 0);
+  for (uint32_t target : m_targets) {
+    ++m_reverseOffsets[target + 1];
+  }
+  std::partial_sum(m_reverseOffsets.begin(), m_reverseOffsets.end(), m_reverseOffsets.begin());
+  m_reverseEdges.resize(m_targets.size());
+  std::vector<uint32_t> position(m_reverseOffsets.begin(), m_reverseOffsets.end() - 1);
+  for (uint32_t edge = 0; edge < m_targets.size(); ++edge) {
+    m_reverseEdges[position[m_targets[edge]]++] = edge;
+  }
+
+  m_routes.assign(m_sources.size() * m_origins.size(), Route{INFINITE_DISTANCE, -1});
+  m_pendingChanges.clear();
+  m_hasSnapshot = true;
+
+  NS_LOG_DEBUG("Snapshot: " << m_sources.size() << " nodes, "
+               << m_routers.size() - m_sources.size() << " channels, "
+               << m_targets.size() << " edges, " << m_origins.size() << " origins");
+}
+
+void
+GlobalRoutingEngine::computeSources(const std::vector<uint32_t>& sources)
+{
+  runParallel<Workspace>(sources.size(), [this, &sources] (size_t i, Workspace& ws) {
+      runDijkstra(sources[i], ws);
+    });
+}
+
+void
+GlobalRoutingEngine::runDijkstra(uint32_t source, Workspace& ws)
+{
+  // Runs on worker threads: touches nothing but the snapshot arrays and row `source` of
+  // m_routes
+  std::vector<uint32_t>& distance = ws.distance;
+  std::vector<int32_t>& face = ws.face;
+  auto& heap = ws.heap;
+  typedef std::greater<std::pair<uint32_t, uint32_t>> Compare;
+
+  distance.assign(m_routers.size(), INFINITE_DISTANCE);
+  face.assign(m_routers.size(), -1);
+  heap.clear();
+
+  uint32_t start = m_sources[source];
+  distance[start] = 0;
+  heap.emplace_back(0, start);
+
+  while (!heap.empty()) {
+    std::pop_heap(heap.begin(), heap.end(), Compare());
+    uint32_t d = heap.back().first;
+    uint32_t u = heap.back().second;
+    heap.pop_back();
+    if (d > distance[u]) {
+      continue; // stale heap entry
+    }
+
+    for (uint32_t edge = m_offsets[u]; edge < m_offsets[u + 1]; ++edge) {
+      if (!m_isEdgeUp[edge]) {
+        continue;
+      }
+
+      uint32_t v = m_targets[edge];
+      uint32_t newDistance = d + m_weights[edge];
+      if (newDistance < distance[v]) {
+        distance[v] = newDistance;
+        face[v] = face[u] >= 0 ? face[u] : m_edgeFaces[edge];
+        heap.emplace_back(newDistance, v);
+        std::push_heap(heap.begin(), heap.end(), Compare());
+      }
+    }
+  }
+
+  Route* routes = &m_routes[source * m_origins.size()];
+  for (size_t i = 0; i < m_origins.size(); ++i) {
+    routes[i].distance = distance[m_origins[i]];
+    routes[i].face = face[m_origins[i]];
+  }
+}
+
+void
+GlobalRoutingEngine::reverseDijkstra(uint32_t target, std::vector<uint32_t>& distance,
+                                     std::vector<int32_t>* parent,
+                                     std::vector<std::pair<uint32_t, uint32_t>>& heap) const
+{
+  typedef std::greater<std::pair<uint32_t, uint32_t>> Compare;
+
+  distance.assign(m_routers.size(), INFINITE_DISTANCE);
+  if (parent != nullptr) {
+    parent->assign(m_routers.size(), -1);
+  }
+  heap.clear();
+
+  distance[target] = 0;
+  heap.emplace_back(0, target);
+
+  while (!heap.empty()) {
+    std::pop_heap(heap.begin(), heap.end(), Compare());
+    uint32_t d = heap.back().first;
+    uint32_t v = heap.back().second;
+    heap.pop_back();
+    if (d > distance[v]) {
+      continue;
+    }
+
+    for (uint32_t i = m_reverseOffsets[v]; i < m_reverseOffsets[v + 1]; ++i) {
+      uint32_t edge = m_reverseEdges[i];
+      if (!m_isEdgeUp[edge]) {
+        continue;
+      }
+
+      uint32_t u = m_edgeSources[edge];
+      uint32_t newDistance = d + m_weights[edge];
+      if (newDistance < distance[u]) {
+        distance[u] = newDistance;
+        if (parent != nullptr) {
+          (*parent)[u] = v;
+        }
+        heap.emplace_back(newDistance, u);
+        std::push_heap(heap.begin(), heap.end(), Compare());
+      }
+    }
+  }
+}
+
+void
+GlobalRoutingEngine::findAffectedSources(uint32_t edge, bool isImprovement,
+                                         std::vector<uint8_t>& isAffected) const
+{
+  uint32_t from = m_edgeSources[edge];
+  int32_t toSource = m_vertexSource[m_targets[edge]];
+  if (toSource < 0) {
+    // edges into a multi-access channel are not tracked individually
+    std::fill(isAffected.begin(), isAffected.end(), 1);
+    return;
+  }
+
+  // A shortest path from s to origin o runs over edge (from, to) iff
+  //   dist(s, from) + weight + dist(to, o) == dist(s, o),
+  // and a restored edge shortens it iff the left-hand side is smaller.  Sub-paths of such a
+  // path never use the link itself, so distances before the change can be used for both.
+  std::vector<uint32_t> toFrom;
+  std::vector<std::pair<uint32_t, uint32_t>> heap;
+  reverseDijkstra(from, toFrom, nullptr, heap);
+  const Route* viaTo = &m_routes[toSource * m_origins.size()];
+
+  for (uint32_t source = 0; source < m_sources.size(); ++source) {
+    if (isAffected[source] || toFrom[m_sources[source]] == INFINITE_DISTANCE) {
+      continue;
+    }
+
+    const Route* routes = &m_routes[source * m_origins.size()];
+    for (size_t i = 0; i < m_origins.size(); ++i) {
+      if (viaTo[i].distance == INFINITE_DISTANCE) {
+        continue;
+      }
+
+      uint64_t distance = static_cast<uint64_t>(toFrom[m_sources[source]]) + m_weights[edge] +
+                          viaTo[i].distance;
+      if (isImprovement ? distance < routes[i].distance : distance == routes[i].distance) {
+        isAffected[source] = 1;
+        break;
+      }
+    }
+  }
+}
+
+void
+GlobalRoutingEngine::computeMultipathRoutes(uint32_t origin, size_t maxPaths,
+                                            MultipathWorkspace& ws,
+                                            std::vector<MultipathRoute>& routes) const
+{
+  // Runs on worker threads: touches nothing but the snapshot arrays, ws, and routes
+  typedef std::greater<std::pair<uint32_t, uint32_t>> Compare;
+  static const uint32_t NOT_IN_TREE = std::numeric_limits<uint32_t>::max();
+
+  size_t nVertices = m_routers.size();
+  uint32_t target = m_origins[origin];
+  std::vector<uint32_t>& distance = ws.distance;
+  std::vector<uint32_t>& position = ws.position;
+  std::vector<uint32_t>& subtreeSize = ws.subtreeSize;
+  std::vector<uint32_t>& detour = ws.detour;
+  auto& heap = ws.heap;
+
+  reverseDijkstra(target, distance, &ws.parent, heap);
+
+  // shortest path tree towards the origin, laid out in preorder so that the subtree of v
+  // occupies order[position[v], position[v] + subtreeSize[v])
+  ws.childOffsets.assign(nVertices + 1, 0);
+  for (uint32_t v = 0; v < nVertices; ++v) {
+    if (ws.parent[v] >= 0) {
+      ++ws.childOffsets[ws.parent[v] + 1];
+    }
+  }
+  std::partial_sum(ws.childOffsets.begin(), ws.childOffsets.end(), ws.childOffsets.begin());
+  ws.children.resize(ws.childOffsets.back());
+  std::vector<uint32_t>& next = ws.scratch;
+  next.assign(ws.childOffsets.begin(), ws.childOffsets.end() - 1);
+  for (uint32_t v = 0; v < nVertices; ++v) {
+    if (ws.parent[v] >= 0) {
+      ws.children[next[ws.parent[v]]++] = v;
+    }
+  }
+
+  ws.order.clear();
+  position.assign(nVertices, NOT_IN_TREE);
+  std::vector<uint32_t>& stack = ws.scratch;
+  stack.assign(1, target);
+  while (!stack.empty()) {
+    uint32_t v = stack.back();
+    stack.pop_back();
+    position[v] = ws.order.size();
+    ws.order.push_back(v);
+    for (uint32_t i = ws.childOffsets[v]; i < ws.childOffsets[v + 1]; ++i) {
+      stack.push_back(ws.children[i]);
+    }
+  }
+
+  subtreeSize.assign(nVertices, 1);
+  for (size_t i = ws.order.size(); i-- > 1;) {
+    subtreeSize[ws.parent[ws.order[i]]] += subtreeSize[ws.order[i]];
+  }
+
+  detour.assign(nVertices, INFINITE_DISTANCE);
+
+  for (uint32_t source = 0; source < m_sources.size(); ++source) {
+    uint32_t node = m_sources[source];
+    if (node == target || distance[node] == INFINITE_DISTANCE) {
+      continue;
+    }
+
+    uint32_t first = position[node];
+    uint32_t last = first + subtreeSize[node];
+    auto isInSubtree = [&] (uint32_t v) {
+      return position[v] != NOT_IN_TREE && position[v] >= first && position[v] < last;
+    };
+
+    if (last - first > 1) {
+      // Shortest paths of the subtree run through the node; find the best ones that do not,
+      // starting from edges that leave the subtree (whose far ends have such paths already)
+      heap.clear();
+      for (uint32_t i = first + 1; i < last; ++i) {
+        uint32_t u = ws.order[i];
+        detour[u] = INFINITE_DISTANCE;
+        for (uint32_t edge = m_offsets[u]; edge < m_offsets[u + 1]; ++edge) {
+          uint32_t x = m_targets[edge];
+          if (m_isEdgeUp[edge] && !isInSubtree(x) && distance[x] != INFINITE_DISTANCE) {
+            detour[u] = std::min(detour[u], distance[x] + m_weights[edge]);
+          }
+        }
+        if (detour[u] != INFINITE_DISTANCE) {
+          heap.emplace_back(detour[u], u);
+        }
+      }
+      std::make_heap(heap.begin(), heap.end(), Compare());
+
+      while (!heap.empty()) {
+        std::pop_heap(heap.begin(), heap.end(), Compare());
+        uint32_t d = heap.back().first;
+        uint32_t v = heap.back().second;
+        heap.pop_back();
+        if (d > detour[v]) {
+          continue;
+        }
+
+        for (uint32_t i = m_reverseOffsets[v]; i < m_reverseOffsets[v + 1]; ++i) {
+          uint32_t edge = m_reverseEdges[i];
+          uint32_t u = m_edgeSources[edge];
+          if (!m_isEdgeUp[edge] || u == node || !isInSubtree(u)) {
+            continue;
+          }
+
+          uint32_t newDistance = d + m_weights[edge];
+          if (newDistance < detour[u]) {
+            detour[u] = newDistance;
+            heap.emplace_back(newDistance, u);
+            std::push_heap(heap.begin(), heap.end(), Compare());
+          }
+        }
+      }
+    }
+
+    ws.candidates.clear();
+    for (uint32_t edge = m_offsets[node]; edge < m_offsets[node + 1]; ++edge) {
+      if (!m_isEdgeUp[edge] || m_edgeFaces[edge] < 0) {
+        continue;
+      }
+
+      uint32_t v = m_targets[edge];
+      uint32_t remaining = isInSubtree(v) ? detour[v] : distance[v];
+      if (remaining != INFINITE_DISTANCE) {
+        ws.candidates.emplace_back(remaining + m_weights[edge], m_edgeFaces[edge]);
+      }
+    }
+
+    std::sort(ws.candidates.begin(), ws.candidates.end());
+    if (maxPaths > 0 && ws.candidates.size() > maxPaths) {
+      ws.candidates.resize(maxPaths);
+    }
+    for (const auto& candidate : ws.candidates) {
+      routes.push_back({source, candidate.second, candidate.first});
+    }
+  }
+}
+
+void
+GlobalRoutingEngine::installRoutes(const std::vector<uint32_t>& sources)
+{
+  FibHelper::InstallStats before = FibHelper::GetInstallStats();
+
+  for (uint32_t source : sources) {
+    // several origins of the same prefix reachable via the same face: keep the best metric
+    RouteSet routes;
+    const Route* row = &m_routes[source * m_origins.size()];
+    for (size_t i = 0; i < m_origins.size(); ++i) {
+      if (row[i].face < 0) {
+        continue; // unreachable, or the node itself
+      }
+
+      const shared_ptr<Face>& face = m_faces[row[i].face];
+      for (const auto& prefix : m_routers[m_origins[i]]->GetLocalPrefixes()) {
+        auto route = routes.emplace(std::make_pair(*prefix, face), row[i].distance);
+        if (!route.second) {
+          route.first->second = std::min(route.first->second, row[i].distance);
+        }
+      }
+    }
+
+    applyRoutes(source, routes);
+  }
+
+  logInstallStats(before);
+}
+
+void
+GlobalRoutingEngine::applyRoutes(uint32_t source, RouteSet& routes)
+{
+  Ptr<Node> node = m_routers[m_sources[source]]->GetObject<Node>();
+  NS_LOG_DEBUG("Reachability from Node: " << node->GetId());
+
+  RouteSet& installed = m_installed[node->GetId()];
+
+  std::vector<FibHelper::Route> removed;
+  for (const auto& route : installed) {
+    if (routes.count(route.first) == 0) {
+      NS_LOG_DEBUG(" prefix " << route.first.first << " no longer reachable via face "
+                   << *route.first.second);
+      removed.emplace_back(route.first.first, route.first.second, 0);
+    }
+  }
+
+  std::vector<FibHelper::Route> added;
+  for (const auto& route : routes) {
+    auto previous = installed.find(route.first);
+    if (previous != installed.end() && previous->second == route.second) {
+      continue;
+    }
+
+    NS_LOG_DEBUG(" prefix " << route.first.first << " reachable via face "
+                 << *route.first.second << " with distance " << route.second);
+    added.emplace_back(route.first.first, route.first.second, static_cast<int32_t>(route.second));
+  }
+
+  if (!removed.empty()) {
+    FibHelper::RemoveRoutes(node, removed);
+  }
+  if (!added.empty()) {
+    FibHelper::AddRoutes(node, added);
+  }
+
+  installed.swap(routes);
+}
+
+void
+GlobalRoutingEngine::scheduleCleanup()
+{
+  if (!m_isCleanupScheduled) {
+    Simulator::ScheduleDestroy(&GlobalRoutingEngine::Clear, this);
+    m_isCleanupScheduled = true;
+  }
+}
+
+} // namespace ndn
+} // namespace ns3
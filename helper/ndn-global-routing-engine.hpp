@@ -0,0 +1,251 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDNSIM_NDN_GLOBAL_ROUTING_ENGINE_HPP
+#define NDNSIM_NDN_GLOBAL_ROUTING_ENGINE_HPP
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ns3/ptr.h"
+
+#include <map>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+class GlobalRouter;
+
+/**
+ * @ingroup ndn-helpers
+ * @brief Shortest-path route computation backing GlobalRoutingHelper
+ *
+ * The topology exported by GlobalRouter objects is snapshotted into a compressed sparse
+ * row (CSR) adjacency array: vertices are GlobalRouters of nodes and multi-access channels,
+ * edge weights are face metrics (zero for channel-to-node edges).  One Dijkstra per node
+ * is then run over the plain arrays on a pool of NdnGlobalRoutingThreads worker threads
+ * (0, the default, uses one thread per hardware core), keeping for every node only the
+ * first-hop face and distance towards each prefix origin.  FIB entries are installed from
+ * the simulation thread in one batch per node afterwards (FibHelper::AddRoutes).
+ *
+ * Multipath routes (CalculateAllPossibleRoutes) are computed from the same snapshot with
+ * one reverse Dijkstra per origin instead of one Dijkstra per face of every node.
+ *
+ * The engine remembers the routes it installed.  Link failures and restorations reported
+ * by LinkControlHelper are queued; RecalculateRoutes re-runs Dijkstra only for the nodes
+ * whose shortest path towards some origin may have changed and updates their FIB entries.
+ * Any other change (new nodes, origins, or face metrics) requires a full CalculateRoutes.
+ *
+ * The engine is reset automatically when the simulator is destroyed.
+ */
+class GlobalRoutingEngine : boost::noncopyable
+{
+public:
+  /**
+   * @brief Get the simulation-wide engine
+   */
+  static GlobalRoutingEngine&
+  Get();
+
+  GlobalRoutingEngine();
+
+  /**
+   * @brief Snapshot the topology, compute routes from every node, and install them
+   *
+   * Routes installed by a previous calculation that are no longer shortest are removed.
+   */
+  void
+  CalculateRoutes();
+
+  /**
+   * @brief Snapshot the topology and install on every node a route towards each origin via
+   *        every face that leads to the origin without coming back to the node
+   *
+   * The cost of the route via a face is the face metric plus the distance from the
+   * neighbor to the origin over paths that avoid the node.  At most NdnGlobalRoutingMaxPaths
+   * cheapest faces (0, the default, for no limit) are used towards each origin.
+   *
+   * For every origin, one reverse Dijkstra gives the distances of all vertices to the
+   * origin.  Vertices whose shortest path runs through the node are exactly its subtree in
+   * the resulting shortest path tree; only their distances are recomputed, with a Dijkstra
+   * restricted to the subtree and seeded from edges that leave it.
+   */
+  void
+  CalculateAllPossibleRoutes();
+
+  /**
+   * @brief Apply the link status changes reported since the last calculation
+   *
+   * Only nodes affected by the changes are recomputed.  If no snapshot has been taken yet,
+   * this is the same as CalculateRoutes; after CalculateAllPossibleRoutes, all multipath
+   * routes are recalculated.
+   */
+  void
+  RecalculateRoutes();
+
+  /**
+   * @brief Record that the link between @p face1 and @p face2 (the faces on either side of a
+   *        point-to-point link) went down or came back up
+   *
+   * Links that are down are excluded from all subsequent calculations.
+   */
+  void
+  NotifyLinkStatus(const Face& face1, const Face& face2, bool isUp);
+
+  /**
+   * @brief Number of nodes recomputed by the last (re)calculation
+   */
+  size_t
+  GetNRecomputed() const;
+
+  /**
+   * @brief Drop the snapshot, computed routes, and recorded link state
+   */
+  void
+  Clear();
+
+private:
+  struct Route
+  {
+    uint32_t distance;
+    int32_t face; ///< index into m_faces, or -1 if the origin is unreachable
+  };
+
+  struct Workspace
+  {
+    std::vector<uint32_t> distance;
+    std::vector<int32_t> face;
+    std::vector<std::pair<uint32_t, uint32_t>> heap;
+  };
+
+  struct MultipathRoute
+  {
+    uint32_t source;
+    int32_t face;
+    uint32_t cost;
+  };
+
+  struct MultipathWorkspace
+  {
+    std::vector<uint32_t> distance;
+    std::vector<int32_t> parent;
+    std::vector<uint32_t> childOffsets;
+    std::vector<uint32_t> children;
+    std::vector<uint32_t> order;    ///< preorder of the shortest path tree
+    std::vector<uint32_t> position; ///< position of each vertex in order
+    std::vector<uint32_t> subtreeSize;
+    std::vector<uint32_t> detour;   ///< distance avoiding the current node
+    std::vector<uint32_t> scratch;
+    std::vector<std::pair<uint32_t, uint32_t>> heap;
+    std::vector<std::pair<uint32_t, int32_t>> candidates;
+  };
+
+  struct LinkChange
+  {
+    const Face* face1;
+    const Face* face2;
+    bool isUp;
+  };
+
+  typedef std::map<std::pair<Name, shared_ptr<Face>>, uint32_t> RouteSet;
+
+  void
+  takeSnapshot();
+
+  /** @brief run Dijkstra from all @p sources (indices into m_sources) in parallel
+   */
+  void
+  computeSources(const std::vector<uint32_t>& sources);
+
+  void
+  runDijkstra(uint32_t source, Workspace& ws);
+
+  /** @brief distances from every vertex to @p target over links that are up
+   *  @param[out] parent if not null, next vertex on the shortest path towards @p target
+   */
+  void
+  reverseDijkstra(uint32_t target, std::vector<uint32_t>& distance, std::vector<int32_t>* parent,
+                  std::vector<std::pair<uint32_t, uint32_t>>& heap) const;
+
+  /** @brief best routes via each face of every node towards origin @p origin (index into
+   *         m_origins)
+   */
+  void
+  computeMultipathRoutes(uint32_t origin, size_t maxPaths, MultipathWorkspace& ws,
+                         std::vector<MultipathRoute>& routes) const;
+
+  /** @brief sources whose route towards some origin could use edge @p edge, or could be
+   *         improved by it if @p isImprovement
+   */
+  void
+  findAffectedSources(uint32_t edge, bool isImprovement, std::vector<uint8_t>& isAffected) const;
+
+  /** @brief bring FIB of @p sources in line with computed shortest path routes
+   */
+  void
+  installRoutes(const std::vector<uint32_t>& sources);
+
+  /** @brief bring FIB of @p source in line with @p routes
+   */
+  void
+  applyRoutes(uint32_t source, RouteSet& routes);
+
+  void
+  scheduleCleanup();
+
+private:
+  // vertices
+  std::vector<Ptr<GlobalRouter>> m_routers;
+  std::vector<int32_t> m_vertexSource; ///< source index of each vertex, -1 for channels
+  std::vector<uint32_t> m_sources;     ///< vertex index of each node
+  std::vector<uint32_t> m_origins;     ///< vertex index of each node with local prefixes
+
+  // forward CSR adjacency
+  std::vector<uint32_t> m_offsets;
+  std::vector<uint32_t> m_targets;
+  std::vector<uint32_t> m_weights;
+  std::vector<int32_t> m_edgeFaces;
+  std::vector<uint8_t> m_isEdgeUp;
+  std::vector<shared_ptr<Face>> m_faces;
+  std::unordered_map<const Face*, uint32_t> m_faceEdges;
+
+  // reverse CSR adjacency, referring to forward edges
+  std::vector<uint32_t> m_reverseOffsets;
+  std::vector<uint32_t> m_reverseEdges;
+  std::vector<uint32_t> m_edgeSources;
+
+  std::vector<Route> m_routes; ///< m_sources.size() x m_origins.size()
+  bool m_hasSnapshot;
+  bool m_isMultipath;
+
+  std::set<const Face*> m_downFaces;
+  std::vector<LinkChange> m_pendingChanges;
+
+  std::unordered_map<uint32_t, RouteSet> m_installed; ///< by node ID
+  size_t m_nRecomputed;
+
+  bool m_isCleanupScheduled;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDNSIM_NDN_GLOBAL_ROUTING_ENGINE_HPP
@@ -96,17 +96,39 @@ public:
 
   /**
    * @brief Calculate for every node shortest path trees and install routes to all prefix origins
+   *
+   * Shortest paths are computed in parallel by GlobalRoutingEngine (the number of threads is
+   * controlled by the NdnGlobalRoutingThreads global value).  Links that were failed with
+   * LinkControlHelper are not used.
    */
   static void
   CalculateRoutes();
 
+  /**
+   * @brief Update routes after links were failed or restored with LinkControlHelper
+   *
+   * Only routes of nodes whose shortest paths are affected by the link changes since the last
+   * calculation are recomputed and updated.  Any other topology change (including face
+   * metrics and origins) requires CalculateRoutes.
+   *
+   * Routes do not react to LinkControlHelper on their own; to emulate routing convergence,
+   * schedule this method after the link change:
+   *
+   *     Simulator::Schedule(Seconds(10.0), ndn::LinkControlHelper::FailLink, node1, node2);
+   *     Simulator::Schedule(Seconds(10.1), ndn::GlobalRoutingHelper::RecalculateRoutes);
+   */
+  static void
+  RecalculateRoutes();
+
   /**
    * @brief Calculate all possible next-hop independent alternative routes
    *
-   * Refer to the implementation for more details.
+   * Every node gets a route towards each prefix origin via each of its faces from which the
+   * origin can be reached without coming back to the node.  The cost of such a route is the
+   * face metric plus the length of the shortest such path.  The number of faces used towards
+   * each origin can be limited with the NdnGlobalRoutingMaxPaths global value.
    *
-   * Note that this method is highly experimental and should be used with caution (very time
-   *consuming).
+   * See GlobalRoutingEngine::CalculateAllPossibleRoutes for details.
    */
   static void
   CalculateAllPossibleRoutes();
@@ -33,6 +33,7 @@
 
 #include "model/ndn-l3-protocol.hpp"
 #include "model/ndn-net-device-transport.hpp"
+#include "helper/ndn-global-routing-engine.hpp"
 #include "NFD/daemon/face/face.hpp"
 
 #include "fw/forwarder.hpp"
@@ -85,6 +86,12 @@ LinkControlHelper::setErrorRate(Ptr<Node> node1, Ptr<Node> node2, double errorRa
 
       nd1->SetAttribute("ReceiveErrorModel", PointerValue(errorFactory.Create<ErrorModel>()));
       nd2->SetAttribute("ReceiveErrorModel", PointerValue(errorFactory.Create<ErrorModel>()));
+
+      // let global routing know, so that GlobalRoutingHelper::RecalculateRoutes can react
+      shared_ptr<Face> face2 = ndn2->getFaceByNetDevice(nd2);
+      if (face2 != nullptr) {
+        GlobalRoutingEngine::Get().NotifyLinkStatus(face, *face2, errorRate < 1.0);
+      }
       return;
     }
   }
@@ -43,6 +43,10 @@ public:
    *
    * Note that only PointToPointChannels are supported by this helper method
    *
+   * Routes are not changed; the failure is recorded for global routing, which avoids the
+   * link in subsequent GlobalRoutingHelper::CalculateRoutes and
+   * GlobalRoutingHelper::RecalculateRoutes calls.
+   *
    * @param node1 one node
    * @param node2 another node
    */
@@ -19,16 +19,13 @@
 
 #include "ndn-block-header.hpp"
 
-#include <iosfwd>
-#include <boost/iostreams/concepts.hpp>
-#include <boost/iostreams/stream.hpp>
+#include <limits>
 
 #include <ndn-cxx/encoding/tlv.hpp>
 #include <ndn-cxx/interest.hpp>
 #include <ndn-cxx/data.hpp>
 #include <ndn-cxx/lp/packet.hpp>
 
-namespace io = boost::iostreams;
 namespace nfdFace = nfd::face;
 
 namespace ns3 {
@@ -73,37 +70,60 @@ BlockHeader::Serialize(ns3::Buffer::Iterator start) const
   start.Write(m_block.wire(), m_block.size());
 }
 
-class Ns3BufferIteratorSource : public io::source {
-public:
-  Ns3BufferIteratorSource(ns3::Buffer::Iterator& is)
-    : m_is(is)
-  {
+/**
+ * @brief Read TLV VAR-NUMBER directly from ns3::Buffer::Iterator
+ * @return false if the buffer ends before the number is complete
+ */
+static bool
+readVarNumber(ns3::Buffer::Iterator& is, uint64_t& number)
+{
+  if (is.IsEnd()) {
+    return false;
   }
 
-  std::streamsize
-  read(char* buf, std::streamsize nMaxRead)
-  {
-    std::streamsize i = 0;
-    for (; i < nMaxRead && !m_is.IsEnd(); ++i) {
-      buf[i] = m_is.ReadU8();
-    }
-    if (i == 0) {
-      return -1;
-    }
-    else {
-      return i;
-    }
+  uint8_t firstOctet = is.ReadU8();
+  if (firstOctet < 253) {
+    number = firstOctet;
+    return true;
+  }
+
+  uint32_t size = firstOctet == 253 ? 2 : (firstOctet == 254 ? 4 : 8);
+  if (is.GetRemainingSize() < size) {
+    return false;
   }
 
-private:
-  ns3::Buffer::Iterator& m_is;
-};
+  number = 0;
+  for (uint32_t i = 0; i < size; ++i) {
+    number = (number << 8) | is.ReadU8();
+  }
+  return true;
+}
 
 uint32_t
 BlockHeader::Deserialize(ns3::Buffer::Iterator start)
 {
-  io::stream<Ns3BufferIteratorSource> is(start);
-  m_block = ::ndn::Block::fromStream(is);
+  // Parse TLV-TYPE and TLV-LENGTH in place, then copy the whole element into a single
+  // contiguous buffer that the Block (and all its sub-elements) will share
+  ns3::Buffer::Iterator i = start;
+
+  uint64_t type = 0;
+  uint64_t length = 0;
+  if (!readVarNumber(i, type) || type > std::numeric_limits<uint32_t>::max() ||
+      !readVarNumber(i, length)) {
+    BOOST_THROW_EXCEPTION(::ndn::tlv::Error("Insufficient data during TLV processing"));
+  }
+
+  if (length > i.GetRemainingSize()) {
+    BOOST_THROW_EXCEPTION(::ndn::tlv::Error("Not enough data in the buffer to fully parse TLV"));
+  }
+
+  uint32_t headerSize = i.GetDistanceFrom(start);
+  auto buffer = make_shared<::ndn::Buffer>(headerSize + length);
+  start.Read(buffer->get(), buffer->size());
+
+  m_block = Block(buffer, static_cast<uint32_t>(type),
+                  buffer->begin(), buffer->end(),
+                  buffer->begin() + headerSize, buffer->end());
   return m_block.size();
 }
 
@@ -28,6 +28,8 @@
 #include "ns3/object-vector.h"
 #include "ns3/pointer.h"
 #include "ns3/simulator.h"
+#include "ns3/global-value.h"
+#include "ns3/nstime.h"
 
 #include "ndn-net-device-transport.hpp"
 
@@ -56,6 +58,9 @@
 
 #include <ndn-cxx/mgmt/dispatcher.hpp>
 
+#include <array>
+#include <unordered_map>
+
 NS_LOG_COMPONENT_DEFINE("ndn.L3Protocol");
 
 namespace ns3 {
@@ -64,6 +69,12 @@ namespace ndn {
 const uint16_t L3Protocol::ETHERNET_FRAME_TYPE = 0x7777;
 const uint16_t L3Protocol::IP_STACK_PORT = 9695;
 
+static GlobalValue g_measurementsSweepInterval("NdnMeasurementsSweepInterval",
+                                               "Interval of the sweep that erases expired "
+                                               "Measurements entries; 0 schedules a cleanup "
+                                               "event per entry instead",
+                                               TimeValue(Seconds(0)), MakeTimeChecker());
+
 NS_OBJECT_ENSURE_REGISTERED(L3Protocol);
 
 TypeId
@@ -188,12 +199,40 @@ private:
 
   Ptr<ContentStore> m_csFromNdnSim;
   PolicyCreationCallback m_policy;
+
+  struct FaceTraces
+  {
+    Face* face;
+    std::array<::ndn::util::signal::ScopedConnection, N_PACKET_TRACES> connections;
+  };
+  std::unordered_map<nfd::FaceId, FaceTraces> m_faceTraces; ///< faces added with addFace
 };
 
 L3Protocol::L3Protocol()
   : m_impl(new Impl())
 {
   NS_LOG_FUNCTION(this);
+
+#ifndef NDNSIM_DISABLE_PACKET_TRACES
+  m_inInterests.SetSubscriptionCallback([this] (bool hasSinks) {
+      this->updatePacketTrace(IN_INTEREST, hasSinks);
+    });
+  m_inData.SetSubscriptionCallback([this] (bool hasSinks) {
+      this->updatePacketTrace(IN_DATA, hasSinks);
+    });
+  m_inNack.SetSubscriptionCallback([this] (bool hasSinks) {
+      this->updatePacketTrace(IN_NACK, hasSinks);
+    });
+  m_outInterests.SetSubscriptionCallback([this] (bool hasSinks) {
+      this->updatePacketTrace(OUT_INTEREST, hasSinks);
+    });
+  m_outData.SetSubscriptionCallback([this] (bool hasSinks) {
+      this->updatePacketTrace(OUT_DATA, hasSinks);
+    });
+  m_outNack.SetSubscriptionCallback([this] (bool hasSinks) {
+      this->updatePacketTrace(OUT_NACK, hasSinks);
+    });
+#endif // NDNSIM_DISABLE_PACKET_TRACES
 }
 
 L3Protocol::~L3Protocol()
@@ -206,6 +245,11 @@ L3Protocol::initialize()
 {
   m_impl->m_forwarder = make_shared<nfd::Forwarder>();
 
+  TimeValue sweepInterval;
+  g_measurementsSweepInterval.GetValue(sweepInterval);
+  m_impl->m_forwarder->getMeasurements()
+    .setSweepInterval(time::nanoseconds(sweepInterval.Get().GetNanoSeconds()));
+
   initializeManagement();
 
   nfd::FaceTable& faceTable = m_impl->m_forwarder->getFaceTable();
@@ -216,8 +260,14 @@ L3Protocol::initialize()
     Simulator::ScheduleWithContext(m_node->GetId(), Seconds(0), &L3Protocol::initializeRibManager, this);
   }
 
+#ifndef NDNSIM_DISABLE_PACKET_TRACES
   m_impl->m_forwarder->beforeSatisfyInterest.connect(std::ref(m_satisfiedInterests));
   m_impl->m_forwarder->beforeExpirePendingInterest.connect(std::ref(m_timedOutInterests));
+
+  faceTable.beforeRemove.connect([this] (Face& face) {
+      m_impl->m_faceTraces.erase(face.getId());
+    });
+#endif // NDNSIM_DISABLE_PACKET_TRACES
 }
 
 class IgnoreSections
@@ -425,54 +475,91 @@ L3Protocol::addFace(shared_ptr<Face> face)
 
   m_impl->m_forwarder->addFace(face);
 
-  std::weak_ptr<Face> weakFace = face;
-
-  // // Connect Signals to TraceSource
-  face->afterReceiveInterest.connect([this, weakFace](const Interest& interest) {
-      shared_ptr<Face> face = weakFace.lock();
-      if (face != nullptr) {
-        this->m_inInterests(interest, *face);
-      }
-    });
-
-  face->afterReceiveData.connect([this, weakFace](const Data& data) {
-      shared_ptr<Face> face = weakFace.lock();
-      if (face != nullptr) {
-        this->m_inData(data, *face);
-      }
-    });
+#ifndef NDNSIM_DISABLE_PACKET_TRACES
+  // Connect Signals to TraceSource, only for trace sources that have sinks
+  Impl::FaceTraces& traces = m_impl->m_faceTraces[face->getId()];
+  traces.face = face.get();
 
-  face->afterReceiveNack.connect([this, weakFace](const lp::Nack& nack) {
-      shared_ptr<Face> face = weakFace.lock();
-      if (face != nullptr) {
-        this->m_inNack(nack, *face);
-      }
-    });
+  for (int trace = 0; trace < N_PACKET_TRACES; ++trace) {
+    traces.connections[trace] = connectPacketTrace(*face, static_cast<PacketTrace>(trace));
+  }
+#endif // NDNSIM_DISABLE_PACKET_TRACES
 
-  auto tracingLink = face->getLinkService();
-  NS_LOG_LOGIC("Adding trace sources for afterSendInterest and afterSendData");
-  tracingLink->afterSendInterest.connect([this, weakFace](const Interest& interest) {
-      shared_ptr<Face> face = weakFace.lock();
-      if (face != nullptr) {
-        this->m_outInterests(interest, *face);
-      }
-    });
+  return face->getId();
+}
 
-  tracingLink->afterSendData.connect([this, weakFace](const Data& data) {
-      shared_ptr<Face> face = weakFace.lock();
-      if (face != nullptr) {
-        this->m_outData(data, *face);
-      }
-    });
+void
+L3Protocol::updatePacketTrace(PacketTrace trace, bool hasSinks)
+{
+  if (m_impl == nullptr) { // disposed
+    return;
+  }
 
-  tracingLink->afterSendNack.connect([this, weakFace](const lp::Nack& nack) {
-      shared_ptr<Face> face = weakFace.lock();
-      if (face != nullptr) {
-        this->m_outNack(nack, *face);
-      }
-    });
+  NS_LOG_LOGIC((hasSinks ? "Connecting" : "Disconnecting") << " packet trace " << trace);
+  for (auto& i : m_impl->m_faceTraces) {
+    if (hasSinks) {
+      i.second.connections[trace] = connectPacketTrace(*i.second.face, trace);
+    }
+    else {
+      i.second.connections[trace].disconnect();
+    }
+  }
+}
 
-  return face->getId();
+::ndn::util::signal::Connection
+L3Protocol::connectPacketTrace(Face& face, PacketTrace trace)
+{
+  // Signals are members of the face (or of its link service), so the handlers cannot outlive it
+  switch (trace) {
+  case IN_INTEREST:
+    if (m_inInterests.HasSinks()) {
+      return face.afterReceiveInterest.connect([this, &face] (const Interest& interest) {
+          this->m_inInterests(interest, face);
+        });
+    }
+    break;
+  case IN_DATA:
+    if (m_inData.HasSinks()) {
+      return face.afterReceiveData.connect([this, &face] (const Data& data) {
+          this->m_inData(data, face);
+        });
+    }
+    break;
+  case IN_NACK:
+    if (m_inNack.HasSinks()) {
+      return face.afterReceiveNack.connect([this, &face] (const lp::Nack& nack) {
+          this->m_inNack(nack, face);
+        });
+    }
+    break;
+  case OUT_INTEREST:
+    if (m_outInterests.HasSinks()) {
+      return face.getLinkService()->afterSendInterest.connect(
+        [this, &face] (const Interest& interest) {
+          this->m_outInterests(interest, face);
+        });
+    }
+    break;
+  case OUT_DATA:
+    if (m_outData.HasSinks()) {
+      return face.getLinkService()->afterSendData.connect(
+        [this, &face] (const Data& data) {
+          this->m_outData(data, face);
+        });
+    }
+    break;
+  case OUT_NACK:
+    if (m_outNack.HasSinks()) {
+      return face.getLinkService()->afterSendNack.connect(
+        [this, &face] (const lp::Nack& nack) {
+          this->m_outNack(nack, face);
+        });
+    }
+    break;
+  default:
+    break;
+  }
+  return ::ndn::util::signal::Connection();
 }
 
 shared_ptr<Face>
@@ -495,6 +582,47 @@ L3Protocol::getFaceByNetDevice(Ptr<NetDevice> netDevice) const
   return nullptr;
 }
 
+size_t
+L3Protocol::addNextHops(const std::vector<NextHop>& nextHops)
+{
+  nfd::FaceTable& faceTable = m_impl->m_forwarder->getFaceTable();
+  nfd::Fib& fib = m_impl->m_forwarder->getFib();
+
+  size_t nAdded = 0;
+  for (const auto& nextHop : nextHops) {
+    Face* face = faceTable.get(std::get<1>(nextHop));
+    if (face == nullptr) {
+      NS_LOG_DEBUG("Face " << std::get<1>(nextHop) << " not found, skipping next hop for "
+                   << std::get<0>(nextHop));
+      continue;
+    }
+
+    fib.insert(std::get<0>(nextHop)).first->addNextHop(*face, std::get<2>(nextHop));
+    ++nAdded;
+  }
+  return nAdded;
+}
+
+size_t
+L3Protocol::removeNextHops(const std::vector<NextHop>& nextHops)
+{
+  nfd::FaceTable& faceTable = m_impl->m_forwarder->getFaceTable();
+  nfd::Fib& fib = m_impl->m_forwarder->getFib();
+
+  size_t nRemoved = 0;
+  for (const auto& nextHop : nextHops) {
+    Face* face = faceTable.get(std::get<1>(nextHop));
+    nfd::fib::Entry* entry = fib.findExactMatch(std::get<0>(nextHop));
+    if (face == nullptr || entry == nullptr || !entry->hasNextHop(*face)) {
+      continue;
+    }
+
+    fib.removeNextHop(*entry, *face);
+    ++nRemoved;
+  }
+  return nRemoved;
+}
+
 Ptr<L3Protocol>
 L3Protocol::getL3Protocol(Ptr<Object> node)
 {
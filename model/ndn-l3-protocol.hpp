@@ -21,8 +21,10 @@
 #define NDN_L3_PROTOCOL_H
 
 #include "ns3/ndnSIM/model/ndn-common.hpp"
+#include "ns3/ndnSIM/model/ndn-packet-trace-source.hpp"
 
 #include <list>
+#include <tuple>
 #include <vector>
 
 #include "ns3/ptr.h"
@@ -72,6 +74,11 @@ namespace ndn {
  *
  * In addition, this class defines NDN packet coding constants
  *
+ * Per-face packet trace sources (InInterests, OutData, etc.) hook into the signals of faces
+ * only while at least one sink is connected to them, so that unused trace sources add no
+ * per-packet overhead.  When ndnSIM is configured with --disable-packet-traces
+ * (NDNSIM_DISABLE_PACKET_TRACES), all trace sources stay registered but never fire.
+ *
  * \see Face, ForwardingStrategy
  */
 class L3Protocol : boost::noncopyable, public Object {
@@ -144,6 +151,33 @@ public:
   shared_ptr<Face>
   getFaceByNetDevice(Ptr<NetDevice> netDevice) const;
 
+  /**
+   * \brief FIB next hop: prefix, face ID, and cost
+   */
+  typedef std::tuple<Name, nfd::FaceId, uint64_t> NextHop;
+
+  /**
+   * \brief Add next hops straight into the FIB
+   *
+   * Has the same effect as an add-nexthop command for every element, but bypasses the
+   * management protocol: no command Interests are created, signed, or dispatched.  Next
+   * hops via faces that are not in the face table are skipped.
+   *
+   * \return number of next hops that were added or updated
+   */
+  size_t
+  addNextHops(const std::vector<NextHop>& nextHops);
+
+  /**
+   * \brief Remove next hops straight from the FIB (costs are ignored)
+   *
+   * FIB entries left without next hops are erased, as with the remove-nexthop command.
+   *
+   * \return number of next hops that were removed
+   */
+  size_t
+  removeNextHops(const std::vector<NextHop>& nextHops);
+
   /**
    * \brief Get NFD config (boost::property_tree)
    */
@@ -198,6 +232,25 @@ private:
   void
   initializeRibManager();
 
+  enum PacketTrace {
+    IN_INTEREST,
+    IN_DATA,
+    IN_NACK,
+    OUT_INTEREST,
+    OUT_DATA,
+    OUT_NACK,
+    N_PACKET_TRACES
+  };
+
+  /**
+   * \brief Hook @p trace into (or unhook it from) all faces added with addFace
+   */
+  void
+  updatePacketTrace(PacketTrace trace, bool hasSinks);
+
+  ::ndn::util::signal::Connection
+  connectPacketTrace(Face& face, PacketTrace trace);
+
 private:
   class Impl;
   std::unique_ptr<Impl> m_impl;
@@ -205,16 +258,14 @@ private:
   // These objects are aggregated, but for optimization, get them here
   Ptr<Node> m_node; ///< \brief node on which ndn stack is installed
 
-  TracedCallback<const Interest&, const Face&>
-    m_inInterests; ///< @brief trace of incoming Interests
-  TracedCallback<const Interest&, const Face&>
-    m_outInterests; ///< @brief Transmitted interests trace
+  PacketTraceSource<Interest> m_inInterests;  ///< @brief trace of incoming Interests
+  PacketTraceSource<Interest> m_outInterests; ///< @brief Transmitted interests trace
 
-  TracedCallback<const Data&, const Face&> m_outData; ///< @brief trace of outgoing Data
-  TracedCallback<const Data&, const Face&> m_inData;  ///< @brief trace of incoming Data
+  PacketTraceSource<Data> m_outData; ///< @brief trace of outgoing Data
+  PacketTraceSource<Data> m_inData;  ///< @brief trace of incoming Data
 
-  TracedCallback<const lp::Nack&, const Face&> m_outNack; ///< @brief trace of outgoing Nack
-  TracedCallback<const lp::Nack&, const Face&> m_inNack;  ///< @brief trace of incoming Nack
+  PacketTraceSource<lp::Nack> m_outNack; ///< @brief trace of outgoing Nack
+  PacketTraceSource<lp::Nack> m_inNack;  ///< @brief trace of incoming Nack
 
   TracedCallback<const nfd::pit::Entry&, const Face&/*in face*/, const Data&> m_satisfiedInterests;
   TracedCallback<const nfd::pit::Entry&> m_timedOutInterests;
@@ -0,0 +1,134 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2016  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDNSIM_NDN_PACKET_TRACE_SOURCE_HPP
+#define NDNSIM_NDN_PACKET_TRACE_SOURCE_HPP
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ns3/callback.h"
+
+#include <list>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * \ingroup ndn
+ * \brief Trace source of packets passing through a face, which knows whether anybody listens
+ *
+ * Can be used in place of TracedCallback<const Packet&, const Face&> with
+ * MakeTraceSourceAccessor.  In addition, the owner is notified when the first sink gets
+ * connected and when the last sink gets disconnected, so that it can hook into per-face
+ * signals only while the trace source is in use.
+ */
+template<class Packet>
+class PacketTraceSource : boost::noncopyable
+{
+public:
+  typedef Callback<void, const Packet&, const Face&> Sink;
+
+  /**
+   * \brief Callback invoked with true when the first sink is connected, and with false when
+   *        the last sink is disconnected
+   */
+  typedef std::function<void(bool hasSinks)> SubscriptionCallback;
+
+  void
+  SetSubscriptionCallback(const SubscriptionCallback& callback)
+  {
+    m_subscriptionCallback = callback;
+  }
+
+  bool
+  HasSinks() const
+  {
+    return !m_sinks.empty();
+  }
+
+  void
+  ConnectWithoutContext(const CallbackBase& callback)
+  {
+    Sink sink;
+    sink.Assign(callback);
+    add(sink);
+  }
+
+  void
+  Connect(const CallbackBase& callback, std::string path)
+  {
+    Callback<void, std::string, const Packet&, const Face&> realCallback;
+    realCallback.Assign(callback);
+    add(realCallback.Bind(path));
+  }
+
+  void
+  DisconnectWithoutContext(const CallbackBase& callback)
+  {
+    remove(callback);
+  }
+
+  void
+  Disconnect(const CallbackBase& callback, std::string path)
+  {
+    Callback<void, std::string, const Packet&, const Face&> realCallback;
+    realCallback.Assign(callback);
+    remove(realCallback.Bind(path));
+  }
+
+  void
+  operator()(const Packet& packet, const Face& face) const
+  {
+    for (const auto& sink : m_sinks) {
+      sink(packet, face);
+    }
+  }
+
+private:
+  void
+  add(const Sink& sink)
+  {
+    m_sinks.push_back(sink);
+    if (m_sinks.size() == 1 && m_subscriptionCallback != nullptr) {
+      m_subscriptionCallback(true);
+    }
+  }
+
+  void
+  remove(const CallbackBase& callback)
+  {
+    if (m_sinks.empty()) {
+      return;
+    }
+
+    m_sinks.remove_if([&callback] (const Sink& sink) { return sink.IsEqual(callback); });
+    if (m_sinks.empty() && m_subscriptionCallback != nullptr) {
+      m_subscriptionCallback(false);
+    }
+  }
+
+private:
+  std::list<Sink> m_sinks;
+  SubscriptionCallback m_subscriptionCallback;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDNSIM_NDN_PACKET_TRACE_SOURCE_HPP
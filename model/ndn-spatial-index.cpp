@@ -0,0 +1,322 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-spatial-index.hpp"
+
+#include "ns3/mobility-model.h"
+#include "ns3/node-list.h"
+#include "ns3/simulator.h"
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <cmath>
+
+NS_LOG_COMPONENT_DEFINE("ndn.SpatialIndex");
+
+namespace ns3 {
+namespace ndn {
+
+static double
+getLength(const Vector& v)
+{
+  return std::sqrt(v.x * v.x + v.y * v.y + v.z * v.z);
+}
+
+SpatialIndex&
+SpatialIndex::Get()
+{
+  static SpatialIndex instance;
+  return instance;
+}
+
+SpatialIndex::SpatialIndex()
+  : m_nRegistered(0)
+  , m_cellSize(150.0)
+  , m_maxSpeed(0.0)
+  , m_isCleanupScheduled(false)
+{
+}
+
+void
+SpatialIndex::SetCellSize(double cellSize)
+{
+  NS_ASSERT(cellSize > 0);
+  m_cellSize = cellSize;
+  rebuild();
+}
+
+double
+SpatialIndex::GetCellSize() const
+{
+  return m_cellSize;
+}
+
+void
+SpatialIndex::Add(Ptr<Node> node)
+{
+  getState(node);
+}
+
+void
+SpatialIndex::AddAll()
+{
+  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
+    if ((*node)->GetObject<MobilityModel>() != 0) {
+      getState(*node);
+    }
+  }
+}
+
+size_t
+SpatialIndex::GetN() const
+{
+  return m_nRegistered;
+}
+
+Vector
+SpatialIndex::GetPosition(Ptr<Node> node)
+{
+  return predictPosition(getState(node));
+}
+
+Vector
+SpatialIndex::GetPosition(uint32_t nodeId)
+{
+  return predictPosition(getState(nodeId));
+}
+
+Vector
+SpatialIndex::GetVelocity(Ptr<Node> node)
+{
+  return getState(node).velocity;
+}
+
+double
+SpatialIndex::GetDistance(Ptr<Node> a, Ptr<Node> b)
+{
+  return CalculateDistance(GetPosition(a), GetPosition(b));
+}
+
+double
+SpatialIndex::GetProgress(Ptr<Node> node, const Vector& from, const Vector& target)
+{
+  return CalculateDistance(from, target) - CalculateDistance(GetPosition(node), target);
+}
+
+void
+SpatialIndex::GetNeighbors(const Vector& center, double radius, std::vector<uint32_t>& nodeIds)
+{
+  double range = radius + getSlack();
+
+  int64_t xMin = getCellIndex(center.x - range);
+  int64_t xMax = getCellIndex(center.x + range);
+  int64_t yMin = getCellIndex(center.y - range);
+  int64_t yMax = getCellIndex(center.y + range);
+
+  for (int64_t cx = xMin; cx <= xMax; ++cx) {
+    for (int64_t cy = yMin; cy <= yMax; ++cy) {
+      auto cell = m_cells.find(getCellKey(cx, cy));
+      if (cell == m_cells.end()) {
+        continue;
+      }
+      for (uint32_t nodeId : cell->second) {
+        if (CalculateDistance(predictPosition(m_nodes[nodeId]), center) <= radius) {
+          nodeIds.push_back(nodeId);
+        }
+      }
+    }
+  }
+}
+
+std::vector<uint32_t>
+SpatialIndex::GetNeighbors(Ptr<Node> node, double radius)
+{
+  std::vector<uint32_t> nodeIds;
+  GetNeighbors(GetPosition(node), radius, nodeIds);
+  nodeIds.erase(std::remove(nodeIds.begin(), nodeIds.end(), node->GetId()), nodeIds.end());
+  return nodeIds;
+}
+
+void
+SpatialIndex::Clear()
+{
+  m_nodes.clear();
+  m_cells.clear();
+  m_nRegistered = 0;
+  m_lastRebuild = Seconds(0);
+  m_maxSpeed = 0.0;
+  m_isCleanupScheduled = false;
+}
+
+SpatialIndex::NodeState&
+SpatialIndex::getState(Ptr<Node> node)
+{
+  uint32_t nodeId = node->GetId();
+  if (nodeId < m_nodes.size() && m_nodes[nodeId].isRegistered) {
+    return m_nodes[nodeId];
+  }
+
+  Ptr<MobilityModel> mobility = node->GetObject<MobilityModel>();
+  if (mobility == 0) {
+    NS_FATAL_ERROR("Mobility model has to be installed on the node");
+  }
+
+  NS_LOG_DEBUG("Registering node " << nodeId);
+  mobility->TraceConnectWithoutContext("CourseChange",
+                                       MakeCallback(&SpatialIndex::notifyCourseChange, this));
+
+  if (!m_isCleanupScheduled) {
+    Simulator::ScheduleDestroy(&SpatialIndex::Clear, this);
+    m_isCleanupScheduled = true;
+  }
+
+  if (nodeId >= m_nodes.size()) {
+    m_nodes.resize(nodeId + 1);
+  }
+  NodeState& state = m_nodes[nodeId];
+  state.isRegistered = true;
+  state.position = mobility->GetPosition();
+  state.velocity = mobility->GetVelocity();
+  state.time = Simulator::Now();
+  insertIntoCell(nodeId, state);
+  ++m_nRegistered;
+
+  // the slack of existing cells must also cover this node from now on
+  m_maxSpeed = std::max(m_maxSpeed, getLength(state.velocity));
+
+  return state;
+}
+
+SpatialIndex::NodeState&
+SpatialIndex::getState(uint32_t nodeId)
+{
+  NS_ASSERT_MSG(nodeId < m_nodes.size() && m_nodes[nodeId].isRegistered,
+                "Node " << nodeId << " is not registered");
+  return m_nodes[nodeId];
+}
+
+Vector
+SpatialIndex::predictPosition(const NodeState& state) const
+{
+  double dt = (Simulator::Now() - state.time).GetSeconds();
+  if (dt == 0) {
+    return state.position;
+  }
+  return Vector(state.position.x + state.velocity.x * dt,
+                state.position.y + state.velocity.y * dt,
+                state.position.z + state.velocity.z * dt);
+}
+
+uint64_t
+SpatialIndex::getCellKey(int64_t cx, int64_t cy) const
+{
+  return (static_cast<uint64_t>(static_cast<uint32_t>(cx)) << 32) | static_cast<uint32_t>(cy);
+}
+
+int64_t
+SpatialIndex::getCellIndex(double coordinate) const
+{
+  return static_cast<int64_t>(std::floor(coordinate / m_cellSize));
+}
+
+void
+SpatialIndex::insertIntoCell(uint32_t nodeId, NodeState& state)
+{
+  state.cell = getCellKey(getCellIndex(state.position.x), getCellIndex(state.position.y));
+  std::vector<uint32_t>& cell = m_cells[state.cell];
+  state.slot = cell.size();
+  cell.push_back(nodeId);
+}
+
+void
+SpatialIndex::removeFromCell(NodeState& state)
+{
+  auto cell = m_cells.find(state.cell);
+  NS_ASSERT(cell != m_cells.end() && state.slot < cell->second.size());
+
+  std::vector<uint32_t>& nodeIds = cell->second;
+  uint32_t last = nodeIds.back();
+  nodeIds[state.slot] = last;
+  m_nodes[last].slot = state.slot;
+  nodeIds.pop_back();
+
+  if (nodeIds.empty()) {
+    m_cells.erase(cell);
+  }
+}
+
+void
+SpatialIndex::update(uint32_t nodeId, const Vector& position, const Vector& velocity)
+{
+  NodeState& state = m_nodes[nodeId];
+  removeFromCell(state);
+
+  state.position = position;
+  state.velocity = velocity;
+  state.time = Simulator::Now();
+  insertIntoCell(nodeId, state);
+
+  m_maxSpeed = std::max(m_maxSpeed, getLength(velocity));
+}
+
+void
+SpatialIndex::notifyCourseChange(Ptr<const MobilityModel> model)
+{
+  Ptr<Node> node = model->GetObject<Node>();
+  if (node == 0 || node->GetId() >= m_nodes.size() || !m_nodes[node->GetId()].isRegistered) {
+    return;
+  }
+
+  update(node->GetId(), model->GetPosition(), model->GetVelocity());
+}
+
+double
+SpatialIndex::getSlack()
+{
+  double slack = m_maxSpeed * (Simulator::Now() - m_lastRebuild).GetSeconds();
+  if (slack > m_cellSize) {
+    rebuild();
+    slack = 0;
+  }
+  return slack;
+}
+
+void
+SpatialIndex::rebuild()
+{
+  NS_LOG_DEBUG("Rebuilding grid of " << m_nRegistered << " nodes");
+
+  m_cells.clear();
+  m_maxSpeed = 0.0;
+  m_lastRebuild = Simulator::Now();
+
+  for (uint32_t nodeId = 0; nodeId < m_nodes.size(); ++nodeId) {
+    NodeState& state = m_nodes[nodeId];
+    if (!state.isRegistered) {
+      continue;
+    }
+    state.position = predictPosition(state);
+    state.time = m_lastRebuild;
+    insertIntoCell(nodeId, state);
+    m_maxSpeed = std::max(m_maxSpeed, getLength(state.velocity));
+  }
+}
+
+} // namespace ndn
+} // namespace ns3
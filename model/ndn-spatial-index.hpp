@@ -0,0 +1,207 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDNSIM_NDN_SPATIAL_INDEX_HPP
+#define NDNSIM_NDN_SPATIAL_INDEX_HPP
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ns3/node.h"
+#include "ns3/nstime.h"
+#include "ns3/vector.h"
+
+#include <unordered_map>
+#include <vector>
+
+namespace ns3 {
+
+class MobilityModel;
+
+namespace ndn {
+
+/**
+ * \ingroup ndn-face
+ * \brief Simulation-wide index of node positions
+ *
+ * Nodes are kept in a uniform grid over the x-y plane.  A node is registered the first
+ * time it is queried (or explicitly with Add/AddAll), which is the only time its
+ * MobilityModel is looked up; after that, position, velocity, and time are refreshed from
+ * the model's CourseChange trace, and the current position is extrapolated from them.
+ * This is exact for models that move with piecewise-constant velocity between course
+ * changes (constant-velocity, waypoint, random walk/waypoint, ns-2 traces).
+ *
+ * Between course changes nodes may drift out of the cell they are filed under; range
+ * queries therefore widen the searched area by the largest possible drift since the grid
+ * was last rebuilt, and the grid is rebuilt once that drift exceeds one cell.
+ *
+ * The index is cleared automatically when the simulator is destroyed.
+ */
+class SpatialIndex : boost::noncopyable
+{
+public:
+  /**
+   * \brief Get the simulation-wide index
+   */
+  static SpatialIndex&
+  Get();
+
+  SpatialIndex();
+
+  /**
+   * \brief Set the grid cell size (in metres), ideally close to the radio range
+   */
+  void
+  SetCellSize(double cellSize);
+
+  double
+  GetCellSize() const;
+
+  /**
+   * \brief Register \p node
+   * \note The node must have a MobilityModel
+   */
+  void
+  Add(Ptr<Node> node);
+
+  /**
+   * \brief Register all nodes in NodeList that have a MobilityModel
+   */
+  void
+  AddAll();
+
+  /**
+   * \brief Get number of registered nodes
+   */
+  size_t
+  GetN() const;
+
+  /**
+   * \brief Get the current position of \p node
+   */
+  Vector
+  GetPosition(Ptr<Node> node);
+
+  /**
+   * \brief Get the current position of the registered node with ID \p nodeId
+   */
+  Vector
+  GetPosition(uint32_t nodeId);
+
+  /**
+   * \brief Get the current velocity of \p node
+   */
+  Vector
+  GetVelocity(Ptr<Node> node);
+
+  /**
+   * \brief Get the current distance between \p a and \p b
+   */
+  double
+  GetDistance(Ptr<Node> a, Ptr<Node> b);
+
+  /**
+   * \brief Get the progress of \p node towards \p target relative to \p from
+   * \return distance(from, target) - distance(node, target); positive if \p node is
+   *         closer to \p target than \p from
+   */
+  double
+  GetProgress(Ptr<Node> node, const Vector& from, const Vector& target);
+
+  /**
+   * \brief Get IDs of registered nodes within \p radius of \p center
+   * \param[out] nodeIds receives the IDs (not cleared)
+   */
+  void
+  GetNeighbors(const Vector& center, double radius, std::vector<uint32_t>& nodeIds);
+
+  /**
+   * \brief Get IDs of registered nodes other than \p node within \p radius of \p node
+   */
+  std::vector<uint32_t>
+  GetNeighbors(Ptr<Node> node, double radius);
+
+  /**
+   * \brief Forget all registered nodes
+   */
+  void
+  Clear();
+
+private:
+  struct NodeState
+  {
+    bool isRegistered = false;
+    Vector position;   ///< \brief position at time
+    Vector velocity;
+    Time time;         ///< \brief time of the last course change (or grid rebuild)
+    uint64_t cell = 0; ///< \brief key of the cell the node is filed under
+    size_t slot = 0;   ///< \brief index of the node within the cell
+  };
+
+  NodeState&
+  getState(Ptr<Node> node);
+
+  NodeState&
+  getState(uint32_t nodeId);
+
+  Vector
+  predictPosition(const NodeState& state) const;
+
+  uint64_t
+  getCellKey(int64_t cx, int64_t cy) const;
+
+  int64_t
+  getCellIndex(double coordinate) const;
+
+  void
+  insertIntoCell(uint32_t nodeId, NodeState& state);
+
+  void
+  removeFromCell(NodeState& state);
+
+  void
+  update(uint32_t nodeId, const Vector& position, const Vector& velocity);
+
+  void
+  notifyCourseChange(Ptr<const MobilityModel> model);
+
+  /** \brief largest distance a node may have moved away from its cell
+   *
+   *  Rebuilds the grid first if that distance exceeds the cell size.
+   */
+  double
+  getSlack();
+
+  void
+  rebuild();
+
+private:
+  std::vector<NodeState> m_nodes; // indexed by node ID
+  std::unordered_map<uint64_t, std::vector<uint32_t>> m_cells;
+  size_t m_nRegistered;
+
+  double m_cellSize;
+  Time m_lastRebuild;
+  double m_maxSpeed; // upper bound of node speeds since m_lastRebuild
+  bool m_isCleanupScheduled;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDNSIM_NDN_SPATIAL_INDEX_HPP
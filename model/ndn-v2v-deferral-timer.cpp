@@ -0,0 +1,203 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-v2v-deferral-timer.hpp"
+
+#include "ns3/double.h"
+#include "ns3/uinteger.h"
+#include "ns3/string.h"
+#include "ns3/global-value.h"
+#include "ns3/object-factory.h"
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+NS_LOG_COMPONENT_DEFINE("ndn.V2VDeferralTimer");
+
+namespace ns3 {
+namespace ndn {
+
+NS_OBJECT_ENSURE_REGISTERED(V2VDeferralTimer);
+NS_OBJECT_ENSURE_REGISTERED(V2VLinearDistanceTimer);
+NS_OBJECT_ENSURE_REGISTERED(V2VSectorTimer);
+NS_OBJECT_ENSURE_REGISTERED(V2VContentionWindowTimer);
+
+static GlobalValue g_v2vDeferralTimer("NdnV2VDeferralTimer",
+                                      "Deferral timer model used by new V2V transports",
+                                      StringValue("ns3::ndn::V2VLinearDistanceTimer"),
+                                      MakeStringChecker());
+
+TypeId
+V2VDeferralTimer::GetTypeId()
+{
+  static TypeId tid =
+    TypeId("ns3::ndn::V2VDeferralTimer")
+      .SetGroupName("Ndn")
+      .SetParent<Object>()
+      .AddAttribute("LocalJitter", "Maximum random deferral of packets originating from the node",
+                    TimeValue(MilliSeconds(2)), MakeTimeAccessor(&V2VDeferralTimer::m_localJitter),
+                    MakeTimeChecker());
+  return tid;
+}
+
+V2VDeferralTimer::V2VDeferralTimer()
+  : m_rand(CreateObject<UniformRandomVariable>())
+{
+}
+
+Ptr<V2VDeferralTimer>
+V2VDeferralTimer::CreateDefault()
+{
+  StringValue type;
+  g_v2vDeferralTimer.GetValue(type);
+
+  ObjectFactory factory;
+  factory.SetTypeId(type.Get());
+  return factory.Create<V2VDeferralTimer>();
+}
+
+Time
+V2VDeferralTimer::GetWaitingTime(const Vector& previousHop, const Vector& self, bool isLocal)
+{
+  if (isLocal) {
+    return GetJitter();
+  }
+
+  double distance = CalculateDistance(previousHop, self);
+  NS_LOG_DEBUG("Distance to previous hop " << distance);
+  return GetForwardingDelay(distance);
+}
+
+int64_t
+V2VDeferralTimer::AssignStreams(int64_t stream)
+{
+  m_rand->SetStream(stream);
+  return 1;
+}
+
+Time
+V2VDeferralTimer::GetJitter()
+{
+  return Seconds(m_rand->GetValue(0, m_localJitter.GetSeconds()));
+}
+
+TypeId
+V2VLinearDistanceTimer::GetTypeId()
+{
+  static TypeId tid =
+    TypeId("ns3::ndn::V2VLinearDistanceTimer")
+      .SetGroupName("Ndn")
+      .SetParent<V2VDeferralTimer>()
+      .AddConstructor<V2VLinearDistanceTimer>()
+      .AddAttribute("MaxDelay", "Delay of a node co-located with the previous hop",
+                    TimeValue(MilliSeconds(5)),
+                    MakeTimeAccessor(&V2VLinearDistanceTimer::m_maxDelay), MakeTimeChecker())
+      .AddAttribute("MaxDistance", "Distance (m) at which the delay reaches zero",
+                    DoubleValue(150.0),
+                    MakeDoubleAccessor(&V2VLinearDistanceTimer::m_maxDistance),
+                    MakeDoubleChecker<double>(std::numeric_limits<double>::min()));
+  return tid;
+}
+
+Time
+V2VLinearDistanceTimer::GetForwardingDelay(double distance)
+{
+  if (distance >= m_maxDistance) {
+    NS_LOG_INFO("Transmission distance is longer than max distance");
+    return GetJitter();
+  }
+
+  return Seconds((m_maxDistance - distance) / m_maxDistance * m_maxDelay.GetSeconds());
+}
+
+TypeId
+V2VSectorTimer::GetTypeId()
+{
+  static TypeId tid =
+    TypeId("ns3::ndn::V2VSectorTimer")
+      .SetGroupName("Ndn")
+      .SetParent<V2VDeferralTimer>()
+      .AddConstructor<V2VSectorTimer>()
+      .AddAttribute("MaxDistance", "Outer radius (m) of the outermost sector",
+                    DoubleValue(150.0),
+                    MakeDoubleAccessor(&V2VSectorTimer::m_maxDistance),
+                    MakeDoubleChecker<double>(std::numeric_limits<double>::min()))
+      .AddAttribute("NumSectors", "Number of sectors", UintegerValue(5),
+                    MakeUintegerAccessor(&V2VSectorTimer::m_nSectors),
+                    MakeUintegerChecker<uint32_t>(1))
+      .AddAttribute("SlotTime", "Length of the transmission slot assigned to each sector",
+                    TimeValue(MilliSeconds(1)),
+                    MakeTimeAccessor(&V2VSectorTimer::m_slotTime), MakeTimeChecker());
+  return tid;
+}
+
+Time
+V2VSectorTimer::GetForwardingDelay(double distance)
+{
+  double width = m_maxDistance / m_nSectors;
+  // clamp before the conversion, which is undefined for values out of uint32_t range
+  uint32_t sector = static_cast<uint32_t>(std::min(distance / width,
+                                                   static_cast<double>(m_nSectors - 1)));
+  uint32_t slot = m_nSectors - 1 - sector;
+
+  return Seconds(m_slotTime.GetSeconds() * slot + m_rand->GetValue(0, m_slotTime.GetSeconds()));
+}
+
+TypeId
+V2VContentionWindowTimer::GetTypeId()
+{
+  static TypeId tid =
+    TypeId("ns3::ndn::V2VContentionWindowTimer")
+      .SetGroupName("Ndn")
+      .SetParent<V2VDeferralTimer>()
+      .AddConstructor<V2VContentionWindowTimer>()
+      .AddAttribute("MaxDistance", "Distance (m) at which the window shrinks to CwMin",
+                    DoubleValue(150.0),
+                    MakeDoubleAccessor(&V2VContentionWindowTimer::m_maxDistance),
+                    MakeDoubleChecker<double>(std::numeric_limits<double>::min()))
+      .AddAttribute("CwMin", "Contention window (in slots) at MaxDistance", UintegerValue(3),
+                    MakeUintegerAccessor(&V2VContentionWindowTimer::m_cwMin),
+                    MakeUintegerChecker<uint32_t>())
+      .AddAttribute("CwMax", "Contention window (in slots) next to the previous hop",
+                    UintegerValue(31),
+                    MakeUintegerAccessor(&V2VContentionWindowTimer::m_cwMax),
+                    MakeUintegerChecker<uint32_t>())
+      .AddAttribute("SlotTime", "Length of a contention slot", TimeValue(MicroSeconds(100)),
+                    MakeTimeAccessor(&V2VContentionWindowTimer::m_slotTime), MakeTimeChecker())
+      .AddAttribute("Jitter", "Maximum random delay added on top of the chosen slot",
+                    TimeValue(MicroSeconds(20)),
+                    MakeTimeAccessor(&V2VContentionWindowTimer::m_jitter), MakeTimeChecker());
+  return tid;
+}
+
+Time
+V2VContentionWindowTimer::GetForwardingDelay(double distance)
+{
+  double closeness = 1.0 - std::min(distance, m_maxDistance) / m_maxDistance;
+  uint32_t cwMax = std::max(m_cwMin, m_cwMax);
+  uint32_t cw = m_cwMin + static_cast<uint32_t>(std::lround((cwMax - m_cwMin) * closeness));
+
+  uint32_t slot = m_rand->GetInteger(0, cw);
+  return Seconds(m_slotTime.GetSeconds() * slot + m_rand->GetValue(0, m_jitter.GetSeconds()));
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,168 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDNSIM_NDN_V2V_DEFERRAL_TIMER_HPP
+#define NDNSIM_NDN_V2V_DEFERRAL_TIMER_HPP
+
+#include "ns3/object.h"
+#include "ns3/nstime.h"
+#include "ns3/vector.h"
+#include "ns3/random-variable-stream.h"
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * \ingroup ndn-face
+ * \brief Base class of models that decide how long V2VNetDeviceTransport defers a broadcast
+ *
+ * Packets originating from the node are deferred by a uniform random jitter in
+ * [0, LocalJitter].  Forwarded packets are deferred by GetForwardingDelay, which
+ * typically shortens the delay for nodes further from the previous hop so that they
+ * rebroadcast first and suppress closer nodes.
+ *
+ * The model used by new V2V transports is selected with the global value
+ * NdnV2VDeferralTimer (e.g., --NdnV2VDeferralTimer=ns3::ndn::V2VSectorTimer on the
+ * command line); model parameters are ordinary attributes.
+ */
+class V2VDeferralTimer : public Object
+{
+public:
+  static TypeId
+  GetTypeId();
+
+  V2VDeferralTimer();
+
+  /**
+   * \brief Create an instance of the model selected by the NdnV2VDeferralTimer global value
+   */
+  static Ptr<V2VDeferralTimer>
+  CreateDefault();
+
+  /**
+   * \brief Get deferral for a packet
+   * \param previousHop position of the node the packet was received from
+   * \param self position of this node
+   * \param isLocal whether the packet originates from this node (previousHop is ignored)
+   */
+  Time
+  GetWaitingTime(const Vector& previousHop, const Vector& self, bool isLocal);
+
+  /**
+   * \brief Assign a fixed random variable stream number to the random variables used by
+   *        this model
+   * \return the number of streams (possibly zero) that have been assigned
+   */
+  int64_t
+  AssignStreams(int64_t stream);
+
+protected:
+  /**
+   * \brief Get deferral for a forwarded packet
+   * \param distance distance between this node and the previous hop
+   */
+  virtual Time
+  GetForwardingDelay(double distance) = 0;
+
+  /**
+   * \brief Uniform random delay in [0, LocalJitter]
+   */
+  Time
+  GetJitter();
+
+protected:
+  Ptr<UniformRandomVariable> m_rand;
+  Time m_localJitter;
+};
+
+/**
+ * \ingroup ndn-face
+ * \brief Delay decreases linearly with the distance to the previous hop
+ *
+ * delay = (MaxDistance - distance) / MaxDistance * MaxDelay; beyond MaxDistance the
+ * packet is treated as local and only jittered.
+ */
+class V2VLinearDistanceTimer : public V2VDeferralTimer
+{
+public:
+  static TypeId
+  GetTypeId();
+
+protected:
+  virtual Time
+  GetForwardingDelay(double distance) override;
+
+private:
+  Time m_maxDelay;
+  double m_maxDistance;
+};
+
+/**
+ * \ingroup ndn-face
+ * \brief Distance to the previous hop is split into NumSectors rings of equal width
+ *
+ * Nodes in the outermost sector transmit in the first slot, the next sector in the second
+ * slot, and so on; within a slot the delay is uniformly random.
+ */
+class V2VSectorTimer : public V2VDeferralTimer
+{
+public:
+  static TypeId
+  GetTypeId();
+
+protected:
+  virtual Time
+  GetForwardingDelay(double distance) override;
+
+private:
+  double m_maxDistance;
+  uint32_t m_nSectors;
+  Time m_slotTime;
+};
+
+/**
+ * \ingroup ndn-face
+ * \brief 802.11-style contention: a random number of slots from a window whose size
+ *        shrinks with the distance to the previous hop
+ *
+ * cw = CwMin + (CwMax - CwMin) * (1 - min(distance, MaxDistance) / MaxDistance), and
+ * delay = uniform{0..cw} * SlotTime + uniform[0, Jitter].
+ */
+class V2VContentionWindowTimer : public V2VDeferralTimer
+{
+public:
+  static TypeId
+  GetTypeId();
+
+protected:
+  virtual Time
+  GetForwardingDelay(double distance) override;
+
+private:
+  double m_maxDistance;
+  uint32_t m_cwMin;
+  uint32_t m_cwMax;
+  Time m_slotTime;
+  Time m_jitter;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDNSIM_NDN_V2V_DEFERRAL_TIMER_HPP
@@ -2,24 +2,66 @@
 
 #include "../helper/ndn-stack-helper.hpp"
 #include "ndn-block-header.hpp"
+#include "ndn-spatial-index.hpp"
 #include "../utils/ndn-ns3-packet-tag.hpp"
-#include "ns3/mobility-model.h"
-
 
 #include <ndn-cxx/encoding/block.hpp>
 #include <ndn-cxx/interest.hpp>
 #include <ndn-cxx/data.hpp>
 #include <ndn-cxx/lp/packet.hpp>
-#include <vector>
-#include <cmath>
-#include "ns3/random-variable-stream.h"
 
+#include <cmath>
 
 NS_LOG_COMPONENT_DEFINE("ndn.V2VNetDeviceTransport");
 
 namespace ns3 {
 namespace ndn {
 
+    /**
+     * \brief extract name and type of the network-layer packet carried in \p lpPacket
+     * \param wire the wire encoding \p lpPacket was decoded from
+     * \return false if \p lpPacket does not carry a complete Interest, Data, or Nack
+     */
+    static bool
+    getNetPacketInfo(const Block& wire, const lp::Packet& lpPacket, Name& name, uint32_t& type)
+    {
+      if (!lpPacket.has<lp::FragmentField>() ||
+          lpPacket.has<lp::FragIndexField>() || lpPacket.has<lp::FragCountField>()) {
+        return false;
+      }
+
+      try {
+        // refer to the network-layer packet without copying the parsed elements of wire
+        Block fragment;
+        const Block* netPkt = &wire;
+        if (wire.type() == lp::tlv::LpPacket) {
+          ::ndn::Buffer::const_iterator first, last;
+          std::tie(first, last) = lpPacket.get<lp::FragmentField>(0);
+          fragment = Block(wire, first, last);
+          netPkt = &fragment;
+        }
+
+        // Name is the first element of Interest and Data; the rest is not needed
+        for (const Block::LazyElement& element : netPkt->lazy_elements()) {
+          if (element.type() == ::ndn::tlv::Name) {
+            name = Name(element.block());
+            type = lpPacket.has<lp::NackField>() ? static_cast<uint32_t>(lp::tlv::Nack) :
+                                                   netPkt->type();
+            return true;
+          }
+        }
+      }
+      catch (const ::ndn::tlv::Error&) {
+      }
+      return false;
+    }
+
+    static Vector
+    getPosition(const lp::GeoTag& geoTag)
+    {
+      return Vector(geoTag.getPosX(), geoTag.getPosY(), 0);
+    }
+
     V2VNetDeviceTransport::V2VNetDeviceTransport(Ptr<Node> node,
                                            const Ptr<NetDevice>& netDevice,
                                            const std::string& localUri,
@@ -29,6 +71,9 @@ namespace ndn {
                                            ::ndn::nfd::LinkType linkType)
     : m_netDevice(netDevice)
     , m_node(node)
+    , m_maxRetxCounter(3)
+    , m_retxTime(Seconds(0.05))
+    , m_deferralTimer(V2VDeferralTimer::CreateDefault())
     {
       this->setLocalUri(FaceUri(localUri));
       this->setRemoteUri(FaceUri(remoteUri));
@@ -46,14 +91,13 @@ namespace ndn {
       m_node->RegisterProtocolHandler(MakeCallback(&V2VNetDeviceTransport::receiveFromNetDevice, this),
                                       L3Protocol::ETHERNET_FRAME_TYPE, m_netDevice,
                                       true /*promiscuous mode*/);
-
-      m_maxRetxCounter = 3;
-      m_retxTime = Seconds(0.05);
     }
 
     V2VNetDeviceTransport::~V2VNetDeviceTransport()
     {
       NS_LOG_FUNCTION_NOARGS();
+
+      Simulator::Cancel(m_scheduledSend);
     }
 
     void
@@ -70,6 +114,9 @@ namespace ndn {
       NS_LOG_FUNCTION(this << "Closing transport for netDevice with URI"
                       << this->getLocalUri());
 
+      Simulator::Cancel(m_scheduledSend);
+      m_queue.clear();
+
       // set the state of the transport to "CLOSED"
       this->setState(nfd::face::TransportState::CLOSED);
     }
@@ -80,59 +127,38 @@ namespace ndn {
       NS_LOG_FUNCTION(this << "Sending packet from netDevice with URI"
                       << this->getLocalUri());
 
-      //adding v2v header
-
-      bool isLocal = false;
-
-      Ptr<MobilityModel> mobility = m_node->GetObject<MobilityModel> ();
-      if (mobility == 0) {
-        NS_FATAL_ERROR("Mobility model has to be installed on the node");
+      lp::Packet lpPacket(packet.packet);
+      V2VPendingTransmission item;
+      if (!getNetPacketInfo(packet.packet, lpPacket, item.name, item.type)) {
+        NS_LOG_DEBUG("Packet does not carry a complete network-layer packet, DROP");
         return;
       }
-      //todo add tag (we may need to remove previous tag if present)
-      ::ndn::lp::Packet lpPacket = ::ndn::lp::Packet(packet.packet);
-
-      //::ndn::lp::GeoTag geoCordTag = lpPacket.get<::ndn::lp::GeoTagField>();
+      item.nTransmissions = 0;
 
-      if (!lpPacket.has<::ndn::lp::GeoTagField>()) {
-        isLocal = true;
+      // packets without GeoTag originate from this node
+      item.isLocal = !lpPacket.has<lp::GeoTagField>();
+      if (!item.isLocal) {
+        item.previousHop = getPosition(lpPacket.get<lp::GeoTagField>());
       }
-      
 
-      // convert NFD packet to NS3 packet
-      BlockHeader header(packet);
-
-      Ptr<ns3::Packet> ns3Packet = Create<ns3::Packet>();
-      ns3Packet->AddHeader(header);
+      // Encode the packet once with a placeholder GeoTag; sendPacketOut overwrites the
+      // fixed-length GeoTag value in place before every (re)transmission
+      lpPacket.set<lp::GeoTagField>(m_geoTag);
+      Block wire = lpPacket.wireEncode();
+      wire.parse();
+      Block::element_const_iterator geoTag = wire.find(lp::tlv::GeoTag);
+      BOOST_ASSERT(geoTag != wire.elements_end() &&
+                   geoTag->value_size() == lp::GeoTag::VALUE_LENGTH);
 
+      item.wire = make_shared<::ndn::Buffer>(wire.begin(), wire.end());
+      item.geoTagOffset = geoTag->value_begin() - wire.begin();
 
-      //computing waiting time
-      Time waitingTime;
-      
       //todo: we need to check the hop count (should we do this in the forwarding strategy?)
 
-      // send the NS3 packet (we need to add the packet to the pending pkts queue)
+      Time waitingTime = computeWaitingTime(item.previousHop, item.isLocal);
+      m_queue.enqueue(Simulator::Now() + waitingTime, std::move(item));
 
-      //add pkt to queue
-      Name name = Name(packet.packet.get(::ndn::tlv::Name));
-
-      // let's lookup the queue
-
-
-      std::tuple<lp::Packet, Name, uint64_t, int> t(lpPacket, name,
-        (Simulator::Now() + computeWaitingTime(lpPacket.get<::ndn::lp::GeoTagField>(), ns3Packet, isLocal)).GetMilliSeconds(), 1);
-
-      m_queue.insert(t);
-
-
-      if(!m_scheduledSend.IsRunning()){
-        m_scheduledSend =  Simulator::Schedule(waitingTime, &V2VNetDeviceTransport::SendFromQueue, this);
-      } else {
-        Simulator::Cancel(m_scheduledSend);
-        m_scheduledSend =  Simulator::Schedule( std::get<3>(*m_queue.begin()) > Simulator::Now() ?
-                                               Seconds(std::get<3>(*m_queue.begin()) - Simulator::Now()) : Seconds(0),
-                                               &V2VNetDeviceTransport::SendFromQueue, this);
-      }
+      ScheduleNextSend();
     }
 
     // callback
@@ -145,159 +171,186 @@ namespace ndn {
     {
       NS_LOG_FUNCTION(device << p << protocol << from << to << packetType);
 
-
-      
       // Convert NS3 packet to NFD packet
       Ptr<ns3::Packet> packet = p->Copy();
 
       BlockHeader header;
       packet->RemoveHeader(header);
 
-
-      //TODO if needed, extracts previous hop coordinates and create a new tag; check if the packet acks (with push progress) any of the pending packets (interest/interest - content/content - interest/content). We need prefix matching here. (remove pending packet if needed)
-      //pass the pkt to the upper layer
-
       auto nfdPacket = Packet(std::move(header.getBlock()));
 
-      ::ndn::lp::Packet lpPacket = ::ndn::lp::Packet(nfdPacket.packet);
+      processImplicitAck(nfdPacket.packet);
 
-      Name name = Name(nfdPacket.packet.get(::ndn::tlv::Name));
-      
-      //todo extract the GeoTag set by the sender
-      //check if this packet acks any packets in the queue:
-      //same name and type (anything about location of the sender?). probably we need to store somewhere the location of the  previous hop to evalaute if there is any push progress
-      //decide if we need to forward the packet to the upper layer
-      
       this->receive(std::move(nfdPacket));
     }
 
+    void
+    V2VNetDeviceTransport::processImplicitAck(const Block& wire)
+    {
+      if (m_queue.empty()) {
+        return;
+      }
+
+      lp::Packet lpPacket;
+      Name name;
+      uint32_t type = 0;
+      try {
+        lpPacket.wireDecode(wire);
+      }
+      catch (const ::ndn::tlv::Error&) {
+        return;
+      }
+      if (!getNetPacketInfo(wire, lpPacket, name, type)) {
+        return;
+      }
+
+      size_t nCancelled = 0;
+
+      // overheard Data satisfies pending Interests for any of its prefixes
+      if (type == ::ndn::tlv::Data) {
+        for (size_t prefixLen = 0; prefixLen <= name.size(); ++prefixLen) {
+          nCancelled += m_queue.cancel(name.getPrefix(prefixLen), ::ndn::tlv::Interest);
+        }
+      }
+
+      if (lpPacket.has<lp::GeoTagField>() && m_queue.contains(name, type)) {
+        Vector sender = getPosition(lpPacket.get<lp::GeoTagField>());
+
+        Vector self = SpatialIndex::Get().GetPosition(m_node);
+        self.z = 0;
+
+        nCancelled += m_queue.cancel(name, type, [&] (const V2VPendingTransmission& item) {
+            // any rebroadcast acknowledges our own packet; otherwise the neighbour must have
+            // pushed the packet further away from the previous hop than we would
+            return item.isLocal ||
+                   CalculateDistance(item.previousHop, sender) >
+                     CalculateDistance(item.previousHop, self);
+          });
+      }
+
+      if (nCancelled > 0) {
+        NS_LOG_DEBUG("Suppressed " << nCancelled << " pending transmission(s) of " << name);
+        this->nSuppressed.set(this->nSuppressed + nCancelled);
+        ScheduleNextSend();
+      }
+    }
+
     Ptr<NetDevice>
     V2VNetDeviceTransport::GetNetDevice() const
     {
       return m_netDevice;
     }
 
+    const V2VNetDeviceTransport::Counters&
+    V2VNetDeviceTransport::getCounters() const
+    {
+      return *this;
+    }
+
+    void
+    V2VNetDeviceTransport::SetDeferralTimer(Ptr<V2VDeferralTimer> timer)
+    {
+      NS_ASSERT(timer != nullptr);
+      m_deferralTimer = timer;
+    }
+
+    Ptr<V2VDeferralTimer>
+    V2VNetDeviceTransport::GetDeferralTimer() const
+    {
+      return m_deferralTimer;
+    }
 
+    int64_t
+    V2VNetDeviceTransport::AssignStreams(int64_t stream)
+    {
+      return m_deferralTimer->AssignStreams(stream);
+    }
 
     void
-    V2VNetDeviceTransport::sendPacketOut(lp::Packet packet)
+    V2VNetDeviceTransport::sendPacketOut(V2VPendingTransmission& item)
     {
-      Ptr<MobilityModel> mobility = m_node->GetObject<MobilityModel> ();
-      if (mobility == 0) {
-        NS_FATAL_ERROR("Mobility model has to be installed on the node");
-        return;
-      }
-      Vector3D currentPosition = mobility->GetPosition();
-      
-      ::ndn::lp::Packet lpPacket = std::get<0>(*m_queue.begin());
-
-      m_geoTag.setPosX(currentPosition.x);
-      m_geoTag.setPosY(currentPosition.y);
-      lpPacket.set<::ndn::lp::GeoTagField>(m_geoTag);
-
-      
-      
-      
-      Packet p = Packet(lpPacket.wireEncode());
-      BlockHeader header(p);
-      
+      SpatialIndex& index = SpatialIndex::Get();
+      Vector position = index.GetPosition(m_node);
+      Vector velocity = index.GetVelocity(m_node);
+
+      m_geoTag.setPosX(position.x);
+      m_geoTag.setPosY(position.y);
+      m_geoTag.setPosZ(position.z);
+      m_geoTag.setSpeed(std::hypot(velocity.x, velocity.y));
+      m_geoTag.setHeading(std::atan2(velocity.y, velocity.x) * 180.0 / M_PI);
+      m_geoTag.wireEncodeValue(item.wire->buf() + item.geoTagOffset);
+
+      BlockHeader header(Packet(Block(item.wire)));
+
       Ptr<ns3::Packet> ns3Packet = Create<ns3::Packet>();
       ns3Packet->AddHeader(header);
 
-      
-    
       m_netDevice->Send(ns3Packet, m_netDevice->GetBroadcast(),
                         L3Protocol::ETHERNET_FRAME_TYPE);
     }
-  
 
     void
     V2VNetDeviceTransport::SendFromQueue()
     {
-      //todo
-      //look at the queue and send pkt that have an expired transmission time
-      //increment retx counter and remove pkt with retx counter > m_maxRetxCounter;
-
-      //schedule next SendFromQueue
-      
-      
-      
-      while(m_queue.begin()!= m_queue.end())
-      {
-        if(std::get<3>(*m_queue.begin())<=Simulator::Now())
-        {
-          sendPacketOut(std::get<0>(*m_queue.begin()));
+      Time now = Simulator::Now();
+
+      while (!m_queue.empty() && m_queue.getNextDue() <= now) {
+        V2VTransmissionQueue::EntryId id = m_queue.front();
+        V2VPendingTransmission& item = m_queue.get(id);
+
+        sendPacketOut(item);
+
+        if (item.nTransmissions == 0) {
+          ++this->nSent;
         }
-        
-        std::tuple<lp::Packet, Name, uint64_t, int> el = *m_queue.begin();
-        m_queue.erase(m_queue.begin());
-
-        //increment retx
-        int retx = std::get<3>(el)+1;
-        
-        if(retx <= m_maxRetxCounter)
-        {
-          std::tuple<lp::Packet, Name, uint64_t, int> newEl(std::get<0>(el), std::get<1>(el),
-            (Simulator::Now() + m_retxTime).GetMilliSeconds(), retx);
-
-          m_queue.insert(newEl);
+        else {
+          ++this->nRetransmitted;
+        }
+
+        ++item.nTransmissions;
+        if (item.nTransmissions < m_maxRetxCounter) {
+          m_queue.reschedule(id, now + m_retxTime);
+        }
+        else {
+          m_queue.erase(id);
         }
-        break;
-      }
-      
-      if(m_queue.size()>0){
-        m_scheduledSend =  Simulator::Schedule( std::get<3>(*m_queue.begin()) > Simulator::Now() ?
-                                               Seconds(std::get<3>(*m_queue.begin()) - Simulator::Now()) : Seconds(0),
-                                               &V2VNetDeviceTransport::SendFromQueue, this);
       }
+
+      ScheduleNextSend();
     }
 
+    void
+    V2VNetDeviceTransport::ScheduleNextSend()
+    {
+      if (m_queue.empty()) {
+        Simulator::Cancel(m_scheduledSend);
+        return;
+      }
+
+      Time nextDue = m_queue.getNextDue();
+      if (m_scheduledSend.IsRunning()) {
+        if (m_scheduledSend.GetTs() <= static_cast<uint64_t>(nextDue.GetTimeStep())) {
+          return; // already scheduled early enough
+        }
+        Simulator::Cancel(m_scheduledSend);
+      }
+
+      Time delay = std::max(nextDue - Simulator::Now(), Seconds(0));
+      m_scheduledSend = Simulator::Schedule(delay, &V2VNetDeviceTransport::SendFromQueue, this);
+    }
 
     Time
-    V2VNetDeviceTransport::computeWaitingTime(lp::GeoTag previousHop, Ptr<ns3::Packet> Packet, bool isLocal)
+    V2VNetDeviceTransport::computeWaitingTime(const Vector& previousHop, bool isLocal)
     {
-            double maxRandomTimer = 0.002; // HARD CORDED FOR NOW
-            UniformRandomVariable randomVariable;
-            Time randomTimer = Seconds(randomVariable.GetValue(0, maxRandomTimer));
-
-            if(isLocal) {
-                    return randomTimer;
-            }
-
-            // compute waiting time according to its own position and last hop's position
-
-            // last hop position
-            Vector3D lastHopPosition = Vector3D(previousHop.getPosX(), previousHop.getPosY(), 0);
-
-            // own position
-            Ptr<MobilityModel> mobility = m_node->GetObject<MobilityModel> ();
-            if (mobility == 0) {
-                    NS_FATAL_ERROR("Mobility model has to be installed on the node");
-                    return randomTimer;
-            }
-            Vector3D currentPosition = mobility->GetPosition();
-
-            // calculate distance
-            double distToLastHop = CalculateDistance(lastHopPosition, currentPosition);
-            if (distToLastHop < 0) {
-                    NS_FATAL_ERROR("Mobility model is not valid");
-                    return randomTimer;
-            }
-
-            Time waitingTimer;
-            double minDelay = 0.005, maxDist = 150; // HARD CODED FOR NOW according to the "Rapid ... "" paper
-
-            if (distToLastHop < maxDist) {
-                    waitingTimer = Seconds(((maxDist - distToLastHop) / maxDist) * minDelay);
-            }
-            else {
-                    NS_LOG_INFO("Tranmission distance is longer than max distance");
-                    return randomTimer;
-            }
-
-            return waitingTimer;
-    }
+      if (isLocal) {
+        return m_deferralTimer->GetWaitingTime(previousHop, previousHop, true);
+      }
+
+      Vector currentPosition = SpatialIndex::Get().GetPosition(m_node);
+      currentPosition.z = 0;
 
+      return m_deferralTimer->GetWaitingTime(previousHop, currentPosition, false);
+    }
 
 } // namespace ndn
 } // namespace ns3
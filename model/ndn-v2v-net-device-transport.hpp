@@ -2,6 +2,8 @@
 #define NDN_V2V_NET_DEVICE_TRANSPORT_HPP
 
 #include "ns3/ndnSIM/model/ndn-common.hpp"
+#include "ns3/ndnSIM/model/ndn-v2v-transmission-queue.hpp"
+#include "ns3/ndnSIM/model/ndn-v2v-deferral-timer.hpp"
 #include "ns3/ndnSIM/NFD/daemon/face/transport.hpp"
 #include "ns3/ndnSIM/ndn-cxx/lp/geo-tag.hpp"
 
@@ -16,18 +18,55 @@
 
 #include "ns3/point-to-point-net-device.h"
 #include "ns3/channel.h"
+
 namespace ns3 {
 namespace ndn {
 
-using namespace ::ndn::lp;
+    /**
+     * \ingroup ndn-face
+     * \brief counters provided by V2VNetDeviceTransport
+     * \note The type name 'V2VNetDeviceTransportCounters' is implementation detail.
+     *       Use 'V2VNetDeviceTransport::Counters' in public API.
+     */
+    class V2VNetDeviceTransportCounters : public virtual nfd::face::Transport::Counters
+    {
+    public:
+      /** \brief count of first transmissions of queued packets
+       */
+      nfd::PacketCounter nSent;
+
+      /** \brief count of repeated transmissions of queued packets
+       */
+      nfd::PacketCounter nRetransmitted;
+
+      /** \brief count of queued packets cancelled because a neighbour was overheard forwarding
+       *         them further, or because the Data for a queued Interest was overheard
+       */
+      nfd::PacketCounter nSuppressed;
+    };
 
     /**
      * \ingroup ndn-face
      * \brief ndnSIM-specific V2V transport
+     *
+     * Every outgoing packet is deferred according to a V2VDeferralTimer model and broadcast up
+     * to m_maxRetxCounter times, m_retxTime apart, from a V2VTransmissionQueue.
+     *
+     * Overheard packets act as implicit acknowledgements: a pending packet is cancelled when a
+     * neighbour is heard broadcasting the same packet (same name and type) from a position that
+     * is further from the previous hop than this node, or, for packets originating from this
+     * node, from anywhere.  A pending Interest is also cancelled when Data under its name is
+     * overheard.
+     *
+     * The previous hop of a forwarded packet is known only if the GenericLinkService of the
+     * face enables Options::allowGeoTag; otherwise every packet is treated as local.
      */
     class V2VNetDeviceTransport : public nfd::face::Transport
+                                , protected virtual V2VNetDeviceTransportCounters
     {
     public:
+      typedef V2VNetDeviceTransportCounters Counters;
+
       V2VNetDeviceTransport(Ptr<Node> node, const Ptr<NetDevice>& netDevice,
                          const std::string& localUri,
                          const std::string& remoteUri,
@@ -40,6 +79,27 @@ using namespace ::ndn::lp;
       Ptr<NetDevice>
       GetNetDevice() const;
 
+      virtual const Counters&
+      getCounters() const override;
+
+      /**
+       * \brief Replace the deferral timer model
+       *
+       * By default, the model selected by the NdnV2VDeferralTimer global value is used.
+       */
+      void
+      SetDeferralTimer(Ptr<V2VDeferralTimer> timer);
+
+      Ptr<V2VDeferralTimer>
+      GetDeferralTimer() const;
+
+      /**
+       * \brief Assign a fixed random variable stream number to the deferral timer model
+       * \return the number of streams that have been assigned
+       */
+      int64_t
+      AssignStreams(int64_t stream);
+
     private:
       virtual void
       beforeChangePersistency(::ndn::nfd::FacePersistency newPersistency) override;
@@ -57,52 +117,43 @@ using namespace ::ndn::lp;
                            const Address& from, const Address& to,
                            NetDevice::PacketType packetType);
 
-      virtual Time
-      computeWaitingTime(lp::GeoTag previousHop, Ptr<ns3::Packet> Packet, bool isLocal);
+      /** \brief cancel pending transmissions acknowledged by an overheard packet
+       */
+      void
+      processImplicitAck(const Block& wire);
 
+      Time
+      computeWaitingTime(const Vector& previousHop, bool isLocal);
 
       void
-      sendPacketOut(lp::Packet packet);
-      
+      sendPacketOut(V2VPendingTransmission& item);
 
-      //virtual void
-      //retransmitPacket(Ptr<ns3::Packet> packet);
-
-      virtual void
+      /** \brief send all queued packets that are due and schedule the next wakeup
+       */
+      void
       SendFromQueue();
 
+      /** \brief (re)schedule SendFromQueue for the earliest due time in the queue
+       */
+      void
+      ScheduleNextSend();
+
+    private:
       Ptr<NetDevice> m_netDevice; ///< \brief Smart pointer to NetDevice
       Ptr<Node> m_node;
 
       EventId m_scheduledSend;
 
       int m_maxRetxCounter;
+      Time m_retxTime;
 
       lp::GeoTag m_geoTag; // GeoTag object
 
-      struct comp
-      {
-        bool operator() (std::tuple<lp::Packet, Name, uint64_t, int> a, std::tuple<lp::Packet, Name, uint64_t, int> b) const
-        {
-          return std::get<2>(a) < std::get<2>(b);
-        }
-      };
+      Ptr<V2VDeferralTimer> m_deferralTimer;
 
-      std::set<std::tuple<lp::Packet, Name, uint64_t, int>, comp> m_queue; // packet queue
-      
-      Time m_retxTime;
+      V2VTransmissionQueue m_queue; // pending transmissions
     };
 
-
-
-    class Item
-    {
-      public:
-        Ptr<ns3::Packet> packet;
-      Time nextTranmissionTime;
-      uint32_t m_retxCount;
-
-    };
   } // namespace ndn
 } // namespace ns3
 
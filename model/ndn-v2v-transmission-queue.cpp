@@ -0,0 +1,173 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-v2v-transmission-queue.hpp"
+
+#include <algorithm>
+#include <functional>
+
+namespace ns3 {
+namespace ndn {
+
+V2VTransmissionQueue::EntryId
+V2VTransmissionQueue::enqueue(Time due, V2VPendingTransmission&& item)
+{
+  EntryId id = ++m_lastId;
+  m_nameIndex.emplace(item.name, id);
+
+  Entry& entry = m_entries[id];
+  entry.item = std::move(item);
+  pushKey(id, due.GetNanoSeconds());
+  return id;
+}
+
+void
+V2VTransmissionQueue::reschedule(EntryId id, Time due)
+{
+  BOOST_ASSERT(m_entries.count(id) > 0);
+  // the old key becomes stale because its seq no longer matches the entry
+  pushKey(id, due.GetNanoSeconds());
+}
+
+void
+V2VTransmissionQueue::erase(EntryId id)
+{
+  auto it = m_entries.find(id);
+  if (it == m_entries.end()) {
+    return;
+  }
+
+  eraseFromIndex(it->second.item.name, id);
+  m_entries.erase(it);
+}
+
+size_t
+V2VTransmissionQueue::cancel(const Name& name, uint32_t type, const Filter& filter)
+{
+  size_t nCancelled = 0;
+  auto range = m_nameIndex.equal_range(name);
+  for (auto it = range.first; it != range.second;) {
+    auto entry = m_entries.find(it->second);
+    BOOST_ASSERT(entry != m_entries.end());
+    if (entry->second.item.type == type && (filter == nullptr || filter(entry->second.item))) {
+      m_entries.erase(entry);
+      it = m_nameIndex.erase(it);
+      ++nCancelled;
+    }
+    else {
+      ++it;
+    }
+  }
+  return nCancelled;
+}
+
+bool
+V2VTransmissionQueue::contains(const Name& name, uint32_t type) const
+{
+  auto range = m_nameIndex.equal_range(name);
+  return std::any_of(range.first, range.second,
+                     [this, type] (const std::pair<const Name, EntryId>& indexEntry) {
+                       return m_entries.at(indexEntry.second).item.type == type;
+                     });
+}
+
+void
+V2VTransmissionQueue::clear()
+{
+  m_heap.clear();
+  m_entries.clear();
+  m_nameIndex.clear();
+}
+
+V2VTransmissionQueue::EntryId
+V2VTransmissionQueue::front()
+{
+  purgeStaleKeys();
+  BOOST_ASSERT(!m_heap.empty());
+  return m_heap.front().id;
+}
+
+Time
+V2VTransmissionQueue::getNextDue()
+{
+  purgeStaleKeys();
+  BOOST_ASSERT(!m_heap.empty());
+  return NanoSeconds(m_heap.front().due);
+}
+
+V2VPendingTransmission&
+V2VTransmissionQueue::get(EntryId id)
+{
+  BOOST_ASSERT(m_entries.count(id) > 0);
+  return m_entries.find(id)->second.item;
+}
+
+void
+V2VTransmissionQueue::pushKey(EntryId id, int64_t due)
+{
+  uint64_t seq = ++m_lastSeq;
+  m_entries.find(id)->second.seq = seq;
+
+  m_heap.push_back({due, seq, id});
+  std::push_heap(m_heap.begin(), m_heap.end(), std::greater<Key>());
+
+  if (m_heap.size() > 2 * m_entries.size() + 16) {
+    compactHeap();
+  }
+}
+
+bool
+V2VTransmissionQueue::isStale(const Key& key) const
+{
+  auto entry = m_entries.find(key.id);
+  return entry == m_entries.end() || entry->second.seq != key.seq;
+}
+
+void
+V2VTransmissionQueue::purgeStaleKeys()
+{
+  while (!m_heap.empty() && isStale(m_heap.front())) {
+    std::pop_heap(m_heap.begin(), m_heap.end(), std::greater<Key>());
+    m_heap.pop_back();
+  }
+}
+
+void
+V2VTransmissionQueue::compactHeap()
+{
+  m_heap.erase(std::remove_if(m_heap.begin(), m_heap.end(),
+                              [this] (const Key& key) { return isStale(key); }),
+               m_heap.end());
+  std::make_heap(m_heap.begin(), m_heap.end(), std::greater<Key>());
+}
+
+void
+V2VTransmissionQueue::eraseFromIndex(const Name& name, EntryId id)
+{
+  auto range = m_nameIndex.equal_range(name);
+  for (auto it = range.first; it != range.second; ++it) {
+    if (it->second == id) {
+      m_nameIndex.erase(it);
+      return;
+    }
+  }
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,176 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDNSIM_NDN_V2V_TRANSMISSION_QUEUE_HPP
+#define NDNSIM_NDN_V2V_TRANSMISSION_QUEUE_HPP
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include <ndn-cxx/encoding/buffer.hpp>
+
+#include "ns3/vector.h"
+
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * \ingroup ndn-face
+ * \brief A packet waiting in V2VTransmissionQueue
+ */
+struct V2VPendingTransmission
+{
+  shared_ptr<::ndn::Buffer> wire; ///< \brief encoded LpPacket
+  size_t geoTagOffset; ///< \brief offset of the GeoTag TLV-VALUE in \p wire
+  Name name;           ///< \brief name of the network-layer packet
+  uint32_t type;       ///< \brief tlv::Interest, tlv::Data, or lp::tlv::Nack
+  int nTransmissions;  ///< \brief number of times the packet has already been sent
+  bool isLocal;        ///< \brief whether the packet originates from this node
+  Vector previousHop;  ///< \brief position of the node the packet was received from
+};
+
+/**
+ * \ingroup ndn-face
+ * \brief Pending-transmission queue of V2VNetDeviceTransport
+ *
+ * Entries are ordered in a binary min-heap by their due time in nanoseconds; entries due at
+ * the same time are served in insertion order.  The heap holds only (due, id) keys, so
+ * rescheduling an entry never copies its packet.  A name index allows all pending copies of
+ * a packet to be cancelled without scanning the queue; cancelled keys are discarded lazily
+ * when they reach the top of the heap.
+ */
+class V2VTransmissionQueue : boost::noncopyable
+{
+public:
+  typedef uint64_t EntryId;
+
+  /** \brief enqueue \p item to be sent at \p due
+   *  \return id that refers to the entry until it is erased or cancelled
+   */
+  EntryId
+  enqueue(Time due, V2VPendingTransmission&& item);
+
+  /** \brief move an existing entry to a new due time
+   */
+  void
+  reschedule(EntryId id, Time due);
+
+  /** \brief remove an entry
+   */
+  void
+  erase(EntryId id);
+
+  typedef std::function<bool(const V2VPendingTransmission&)> Filter;
+
+  /** \brief remove all entries for a packet with \p name and \p type
+   *  \param filter if set, only entries for which it returns true are removed
+   *  \return number of removed entries
+   */
+  size_t
+  cancel(const Name& name, uint32_t type, const Filter& filter = nullptr);
+
+  /** \return whether there is a pending entry for a packet with \p name and \p type
+   */
+  bool
+  contains(const Name& name, uint32_t type) const;
+
+  void
+  clear();
+
+  bool
+  empty() const
+  {
+    return m_entries.empty();
+  }
+
+  size_t
+  size() const
+  {
+    return m_entries.size();
+  }
+
+  /** \return id of the entry with the earliest due time
+   *  \pre !empty()
+   */
+  EntryId
+  front();
+
+  /** \return due time of the entry with the earliest due time
+   *  \pre !empty()
+   */
+  Time
+  getNextDue();
+
+  V2VPendingTransmission&
+  get(EntryId id);
+
+private:
+  struct Key
+  {
+    int64_t due; ///< \brief nanoseconds
+    uint64_t seq;
+    EntryId id;
+
+    bool
+    operator>(const Key& other) const
+    {
+      return due > other.due || (due == other.due && seq > other.seq);
+    }
+  };
+
+  struct Entry
+  {
+    V2VPendingTransmission item;
+    uint64_t seq; ///< \brief sequence number of the only valid Key for this entry
+  };
+
+  void
+  pushKey(EntryId id, int64_t due);
+
+  bool
+  isStale(const Key& key) const;
+
+  /** \brief drop keys of erased or rescheduled entries from the top of the heap
+   */
+  void
+  purgeStaleKeys();
+
+  /** \brief drop all stale keys once they outnumber live entries
+   */
+  void
+  compactHeap();
+
+  void
+  eraseFromIndex(const Name& name, EntryId id);
+
+private:
+  std::vector<Key> m_heap;
+  std::unordered_map<EntryId, Entry> m_entries;
+  std::unordered_multimap<Name, EntryId> m_nameIndex;
+  EntryId m_lastId = 0;
+  uint64_t m_lastSeq = 0;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDNSIM_NDN_V2V_TRANSMISSION_QUEUE_HPP
@@ -121,14 +121,28 @@ Data::wireEncode() const
   if (m_wire.hasWire())
     return m_wire;
 
-  EncodingEstimator estimator;
-  size_t estimatedSize = wireEncode(estimator);
+  const_cast<Data*>(this)->setEncodedWire(
+    encoding::encodeInArena<Data>([this] (EncodingBuffer& encoder) {
+        wireEncode(encoder);
+      }));
+  return m_wire;
+}
 
-  EncodingBuffer buffer(estimatedSize, 0);
-  wireEncode(buffer);
+void
+Data::setEncodedWire(const Block& wire)
+{
+  m_fullName.clear();
+  m_wire = wire;
+  m_wire.parse();
 
-  const_cast<Data*>(this)->wireDecode(buffer.block());
-  return m_wire;
+  // Content and SignatureValue are made to point into the wire, so that their own buffers
+  // can be released.  Name, MetaInfo, and SignatureInfo have just been encoded from this
+  // object and are not decoded again.
+  m_content = m_wire.get(tlv::Content);
+
+  Block::element_const_iterator val = m_wire.find(tlv::SignatureValue);
+  if (val != m_wire.elements_end())
+    m_signature.setValue(*val);
 }
 
 void
@@ -295,6 +295,13 @@ protected:
   void
   onChanged();
 
+private:
+  /**
+   * @brief Adopt the wire encoding just produced from this Data
+   */
+  void
+  setEncodedWire(const Block& wire);
+
 private:
   Name m_name;
   MetaInfo m_metaInfo;
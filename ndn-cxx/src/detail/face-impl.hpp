@@ -88,12 +88,12 @@ public: // consumer
 
     lp::Packet packet;
 
-    shared_ptr<lp::NextHopFaceIdTag> nextHopFaceIdTag = interest->getTag<lp::NextHopFaceIdTag>();
+    const lp::NextHopFaceIdTag* nextHopFaceIdTag = interest->peekTag<lp::NextHopFaceIdTag>();
     if (nextHopFaceIdTag != nullptr) {
       packet.add<lp::NextHopFaceIdField>(*nextHopFaceIdTag);
     }
 
-    shared_ptr<lp::CongestionMarkTag> congestionMarkTag = interest->getTag<lp::CongestionMarkTag>();
+    const lp::CongestionMarkTag* congestionMarkTag = interest->peekTag<lp::CongestionMarkTag>();
     if (congestionMarkTag != nullptr) {
       packet.add<lp::CongestionMarkField>(*congestionMarkTag);
     }
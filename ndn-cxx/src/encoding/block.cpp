@@ -324,31 +324,17 @@ Block::parse() const
   if (!m_subBlocks.empty() || value_size() == 0)
     return;
 
-  Buffer::const_iterator begin = value_begin();
-  Buffer::const_iterator end = value_end();
-
-  while (begin != end)
-    {
-      Buffer::const_iterator element_begin = begin;
-
-      uint32_t type = tlv::readType(begin, end);
-      uint64_t length = tlv::readVarNumber(begin, end);
-
-      if (length > static_cast<uint64_t>(end - begin))
-        {
-          m_subBlocks.clear();
-          BOOST_THROW_EXCEPTION(tlv::Error("TLV length exceeds buffer length"));
-        }
-      Buffer::const_iterator element_end = begin + length;
-
-      m_subBlocks.push_back(Block(m_buffer,
-                                  type,
-                                  element_begin, element_end,
-                                  begin, element_end));
-
-      begin = element_end;
-      // don't do recursive parsing, just the top level
-    }
+  // count subelements first, so that they are stored without reallocating m_subBlocks;
+  // this also validates all of them before m_subBlocks is modified
+  auto elements = lazy_elements();
+  m_subBlocks.reserve(std::distance(elements.begin(), elements.end()));
+
+  for (const LazyElement& element : elements) {
+    m_subBlocks.emplace_back(m_buffer, element.type(),
+                             element.begin(), element.end(),
+                             element.value_begin(), element.value_end());
+    // don't do recursive parsing, just the top level
+  }
 }
 
 void
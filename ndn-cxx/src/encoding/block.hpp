@@ -30,6 +30,8 @@
 #include "tlv.hpp"
 #include "encoding-buffer-fwd.hpp"
 
+#include <boost/range/iterator_range.hpp>
+
 namespace boost {
 namespace asio {
 class const_buffer;
@@ -276,6 +278,20 @@ public: // sub elements
   size_t
   elements_size() const;
 
+  class LazyElement;
+  class LazyElementIterator;
+
+  /** @brief Get subelements decoded on demand
+   *
+   *  Unlike parse(), this neither creates a Block for every subelement nor modifies this Block.
+   *  Each subelement is decoded when an iterator reaches it, which suits code that looks for
+   *  a single subelement or counts them.
+   *
+   *  @throw tlv::Error when an iterator reaches a malformed subelement
+   */
+  boost::iterator_range<LazyElementIterator>
+  lazy_elements() const;
+
   Block
   blockFromValue() const;
 
@@ -310,10 +326,159 @@ protected:
   mutable element_container m_subBlocks;
 };
 
+/** @brief A subelement of a Block, referring to the buffer of the Block
+ *  @sa Block::lazy_elements
+ */
+class Block::LazyElement
+{
+public:
+  uint32_t
+  type() const
+  {
+    return m_type;
+  }
+
+  Buffer::const_iterator
+  begin() const
+  {
+    return m_begin;
+  }
+
+  Buffer::const_iterator
+  end() const
+  {
+    return m_end;
+  }
+
+  Buffer::const_iterator
+  value_begin() const
+  {
+    return m_valueBegin;
+  }
+
+  Buffer::const_iterator
+  value_end() const
+  {
+    return m_end;
+  }
+
+  size_t
+  value_size() const
+  {
+    return m_end - m_valueBegin;
+  }
+
+  /** @brief Create a Block for this subelement, sharing the buffer of the parent Block
+   */
+  Block
+  block() const
+  {
+    return Block(m_parent->m_buffer, m_type, m_begin, m_end, m_valueBegin, m_end);
+  }
+
+private:
+  const Block* m_parent;
+  uint32_t m_type;
+  Buffer::const_iterator m_begin;
+  Buffer::const_iterator m_valueBegin;
+  Buffer::const_iterator m_end;
+
+  friend class LazyElementIterator;
+};
+
+/** @brief Forward iterator over subelements of a Block that decodes them on demand
+ *  @sa Block::lazy_elements
+ */
+class Block::LazyElementIterator : public std::iterator<std::forward_iterator_tag,
+                                                        const LazyElement>
+{
+public:
+  LazyElementIterator() = default;
+
+  /** @param parent the Block whose value is iterated
+   *  @param position beginning of a subelement, or the end of the value of @p parent
+   */
+  LazyElementIterator(const Block& parent, Buffer::const_iterator position)
+    : m_valueEnd(parent.value_end())
+  {
+    m_element.m_parent = &parent;
+    m_element.m_begin = position;
+    decode();
+  }
+
+  const LazyElement&
+  operator*() const
+  {
+    return m_element;
+  }
+
+  const LazyElement*
+  operator->() const
+  {
+    return &m_element;
+  }
+
+  LazyElementIterator&
+  operator++()
+  {
+    m_element.m_begin = m_element.m_end;
+    decode();
+    return *this;
+  }
+
+  LazyElementIterator
+  operator++(int)
+  {
+    LazyElementIterator copy(*this);
+    ++*this;
+    return copy;
+  }
+
+  bool
+  operator==(const LazyElementIterator& other) const
+  {
+    return m_element.m_begin == other.m_element.m_begin;
+  }
+
+  bool
+  operator!=(const LazyElementIterator& other) const
+  {
+    return !(*this == other);
+  }
+
+private:
+  void
+  decode()
+  {
+    if (m_element.m_begin == m_valueEnd) {
+      return;
+    }
+
+    Buffer::const_iterator position = m_element.m_begin;
+    m_element.m_type = tlv::readType(position, m_valueEnd);
+    uint64_t length = tlv::readVarNumber(position, m_valueEnd);
+    if (length > static_cast<uint64_t>(m_valueEnd - position)) {
+      BOOST_THROW_EXCEPTION(tlv::Error("TLV length exceeds buffer length"));
+    }
+    m_element.m_valueBegin = position;
+    m_element.m_end = position + length;
+  }
+
+private:
+  LazyElement m_element;
+  Buffer::const_iterator m_valueEnd;
+};
+
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
+inline boost::iterator_range<Block::LazyElementIterator>
+Block::lazy_elements() const
+{
+  return {LazyElementIterator(*this, m_value_begin), LazyElementIterator(*this, m_value_end)};
+}
+
 inline shared_ptr<const Buffer>
 Block::getBuffer() const
 {
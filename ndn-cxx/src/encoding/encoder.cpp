@@ -55,6 +55,11 @@ Encoder::reserveFront(size_t size)
     reserve(m_buffer->size() * 2 + size, true);
 }
 
+void
+Encoder::clear()
+{
+  m_begin = m_end = m_buffer->end();
+}
 
 Block
 Encoder::block(bool verifyLength/* = true*/) const
@@ -197,6 +197,14 @@ public: // unique interface to the Encoder
   shared_ptr<Buffer>
   getBuffer();
 
+  /**
+   * @brief Discard the encoded bytes, making the whole buffer available to prepend* operations
+   * @warning Blocks previously created with block() share the buffer; their contents will be
+   *          overwritten by subsequent encoding
+   */
+  void
+  clear();
+
 public: // accessors
 
   /**
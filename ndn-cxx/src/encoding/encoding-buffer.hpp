@@ -64,6 +64,85 @@ public:
   }
 };
 
+namespace detail {
+
+/**
+ * @brief EncodingBuffer retained between encodings by encodeInArena
+ */
+class EncodingArena : noncopyable
+{
+public:
+  EncodingArena()
+    : m_buffer(INITIAL_SIZE, 0)
+    , m_isInUse(false)
+  {
+  }
+
+  template<typename F>
+  Block
+  encode(const F& encode)
+  {
+    if (m_isInUse) {
+      EncodingBuffer buffer(INITIAL_SIZE, 0);
+      encode(buffer);
+      return copyOut(buffer);
+    }
+
+    m_isInUse = true;
+    try {
+      encode(m_buffer);
+    }
+    catch (...) {
+      m_buffer.clear();
+      m_isInUse = false;
+      throw;
+    }
+
+    Block block = copyOut(m_buffer);
+    m_buffer.clear();
+    m_isInUse = false;
+    return block;
+  }
+
+private:
+  static Block
+  copyOut(const EncodingBuffer& buffer)
+  {
+    return Block(make_shared<Buffer>(buffer.buf(), buffer.size()));
+  }
+
+private:
+  static const size_t INITIAL_SIZE = 1024;
+
+  EncodingBuffer m_buffer;
+  bool m_isInUse;
+};
+
+} // namespace detail
+
+/**
+ * @brief Encode a packet in one pass into a reusable buffer
+ * @tparam T packet type; each packet type has its own buffer
+ * @param encode function that prepends the TLV of the packet to the supplied EncodingBuffer
+ * @return the encoded TLV, copied into a buffer of its own of exactly the right size
+ *
+ * The usual way to encode a packet is to compute its size with EncodingEstimator, and then
+ * encode it into an EncodingBuffer of that size, which walks the packet structure twice.
+ * Instead, the packet is encoded into a thread-local EncodingBuffer kept for packets of type T.
+ * The headroom of this buffer grows to the largest packet of type T encoded so far by the thread,
+ * so that it does not need to grow again for typical packets.
+ *
+ * If @p encode itself encodes another packet of type T with this function, the inner packet
+ * is encoded into a temporary EncodingBuffer.
+ */
+template<typename T, typename F>
+Block
+encodeInArena(const F& encode)
+{
+  static thread_local detail::EncodingArena arena;
+  return arena.encode(encode);
+}
+
 } // namespace encoding
 } // namespace ndn
 
@@ -208,13 +208,13 @@ Face::put(const Data& data)
   lp::Packet packet;
   bool hasLpFields = false;
 
-  shared_ptr<lp::CachePolicyTag> cachePolicyTag = data.getTag<lp::CachePolicyTag>();
+  const lp::CachePolicyTag* cachePolicyTag = data.peekTag<lp::CachePolicyTag>();
   if (cachePolicyTag != nullptr) {
     packet.add<lp::CachePolicyField>(*cachePolicyTag);
     hasLpFields = true;
   }
 
-  shared_ptr<lp::CongestionMarkTag> congestionMarkTag = data.getTag<lp::CongestionMarkTag>();
+  const lp::CongestionMarkTag* congestionMarkTag = data.peekTag<lp::CongestionMarkTag>();
   if (congestionMarkTag != nullptr) {
     packet.add<lp::CongestionMarkField>(*congestionMarkTag);
     hasLpFields = true;
@@ -241,7 +241,7 @@ Face::put(const lp::Nack& nack)
   const Block& interestWire = nack.getInterest().wireEncode();
   packet.add<lp::FragmentField>(std::make_pair(interestWire.begin(), interestWire.end()));
 
-  shared_ptr<lp::CongestionMarkTag> congestionMarkTag = nack.getTag<lp::CongestionMarkTag>();
+  const lp::CongestionMarkTag* congestionMarkTag = nack.peekTag<lp::CongestionMarkTag>();
   if (congestionMarkTag != nullptr) {
     packet.add<lp::CongestionMarkField>(*congestionMarkTag);
   }
@@ -451,15 +451,15 @@ static void
 extractLpLocalFields(NetPkt& netPacket, const lp::Packet& lpPacket)
 {
   if (lpPacket.has<lp::IncomingFaceIdField>()) {
-    netPacket.setTag(make_shared<lp::IncomingFaceIdTag>(lpPacket.get<lp::IncomingFaceIdField>()));
+    netPacket.template emplaceTag<lp::IncomingFaceIdTag>(lpPacket.get<lp::IncomingFaceIdField>());
   }
 
   if (lpPacket.has<lp::CongestionMarkField>()) {
-    netPacket.setTag(make_shared<lp::CongestionMarkTag>(lpPacket.get<lp::CongestionMarkField>()));
+    netPacket.template emplaceTag<lp::CongestionMarkTag>(lpPacket.get<lp::CongestionMarkField>());
   }
 
   if (lpPacket.has<lp::HopCountTagField>()) {
-    netPacket.setTag(make_shared<lp::HopCountTag>(lpPacket.get<lp::HopCountTagField>() + 1));
+    netPacket.template emplaceTag<lp::HopCountTag>(lpPacket.get<lp::HopCountTagField>() + 1);
   }
 }
 
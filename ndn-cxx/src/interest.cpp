@@ -279,18 +279,30 @@ Interest::wireEncode() const
   if (m_wire.hasWire())
     return m_wire;
 
-  EncodingEstimator estimator;
-  size_t estimatedSize = wireEncode(estimator);
+  m_wire = encoding::encodeInArena<Interest>([this] (EncodingBuffer& encoder) {
+      wireEncode(encoder);
+    });
 
-  EncodingBuffer buffer(estimatedSize, 0);
-  wireEncode(buffer);
-
-  // to ensure that Nonce block points to the right memory location
-  const_cast<Interest*>(this)->wireDecode(buffer.block());
+  // Nonce block must point into the wire, so that setNonce can update the wire in place
+  m_nonce = findNonce(m_wire);
 
   return m_wire;
 }
 
+Block
+Interest::findNonce(const Block& wire)
+{
+  // Nonce follows Name and Selectors, so only the TLV-TYPE and TLV-LENGTH of the elements
+  // before it need to be read
+  for (const Block::LazyElement& element : wire.lazy_elements()) {
+    if (element.type() == tlv::Nonce) {
+      return element.block();
+    }
+  }
+
+  BOOST_THROW_EXCEPTION(Error("Nonce element is missing"));
+}
+
 void
 Interest::wireDecode(const Block& wire)
 {
@@ -393,6 +393,12 @@ public: // EqualityComparable concept
     return !(*this == other);
   }
 
+private:
+  /** @brief get the Nonce element of an encoded Interest, sharing its buffer
+   */
+  static Block
+  findNonce(const Block& wire);
+
 private:
   Name m_name;
   Selectors m_selectors;
@@ -220,10 +220,16 @@ Link::findDelegationFromWire(const Block& block, const Name& delegationName)
 ssize_t
 Link::countDelegationsFromWire(const Block& block)
 {
-  block.parse();
-  const Block& contentBlock = block.get(tlv::Content);
-  contentBlock.parse();
-  return contentBlock.elements_size();
+  // called for every Interest carrying SelectedDelegation, so avoid parsing the Link
+  for (const Block::LazyElement& element : block.lazy_elements()) {
+    if (element.type() == tlv::Content) {
+      Block contentBlock = element.block();
+      auto delegations = contentBlock.lazy_elements();
+      return std::distance(delegations.begin(), delegations.end());
+    }
+  }
+
+  BOOST_THROW_EXCEPTION(Block::Error("Link does not contain Content"));
 }
 
 bool
@@ -23,12 +23,55 @@
 
 #include "geo-tag.hpp"
 
+#include <cmath>
+#include <limits>
+
 namespace ndn {
 namespace lp {
 
+static int32_t
+toFixedPoint(double value)
+{
+  double scaled = std::round(value * 100);
+  if (!(scaled >= std::numeric_limits<int32_t>::min() &&
+        scaled <= std::numeric_limits<int32_t>::max())) {
+    BOOST_THROW_EXCEPTION(GeoTag::Error("GeoTag value is out of range"));
+  }
+  return static_cast<int32_t>(scaled);
+}
+
+static double
+fromFixedPoint(int32_t value)
+{
+  return value / 100.0;
+}
+
+static void
+writeInt32(uint8_t* dest, int32_t value)
+{
+  uint32_t v = static_cast<uint32_t>(value);
+  dest[0] = static_cast<uint8_t>(v >> 24);
+  dest[1] = static_cast<uint8_t>(v >> 16);
+  dest[2] = static_cast<uint8_t>(v >> 8);
+  dest[3] = static_cast<uint8_t>(v);
+}
+
+static int32_t
+readInt32(const uint8_t* src)
+{
+  uint32_t v = (static_cast<uint32_t>(src[0]) << 24) | (static_cast<uint32_t>(src[1]) << 16) |
+               (static_cast<uint32_t>(src[2]) << 8) | static_cast<uint32_t>(src[3]);
+  return static_cast<int32_t>(v);
+}
+
+const size_t GeoTag::VALUE_LENGTH;
+
 GeoTag::GeoTag()
-  : m_pos_x(0.0)
-  , m_pos_y(0.0)
+  : m_pos_x(0)
+  , m_pos_y(0)
+  , m_pos_z(0)
+  , m_speed(0)
+  , m_heading(0)
 {
 }
 
@@ -41,19 +84,10 @@ template<encoding::Tag TAG>
 size_t
 GeoTag::wireEncode(EncodingImpl<TAG>& encoder) const
 {
-  if (m_pos_x == 0.0 && m_pos_y == 0.0) {
-    BOOST_THROW_EXCEPTION(Error("Positions must be set"));
-  }
-  size_t length = 0;
-  // encode position X
-  length += prependNonNegativeIntegerBlock(encoder, tlv::GeoTagPos,
-                                           static_cast<uint32_t>(m_pos_x * 10));
-  // encode position Y
-  length += prependNonNegativeIntegerBlock(encoder, tlv::GeoTagPos,
-                                           static_cast<uint32_t>(m_pos_y * 10));
-  length += encoder.prependVarNumber(length);
-  length += encoder.prependVarNumber(tlv::GeoTag);
-  return length;
+  uint8_t value[VALUE_LENGTH];
+  wireEncodeValue(value);
+
+  return encoder.prependByteArrayBlock(tlv::GeoTag, value, VALUE_LENGTH);
 }
 
 template size_t
@@ -65,10 +99,6 @@ GeoTag::wireEncode<encoding::EstimatorTag>(EncodingImpl<encoding::EstimatorTag>&
 const Block&
 GeoTag::wireEncode() const
 {
-  if (m_pos_x == 0.0 && m_pos_y == 0.0) {
-    BOOST_THROW_EXCEPTION(Error("Positions must be set"));
-  }
-
   if (m_wire.hasWire()) {
     return m_wire;
   }
@@ -84,60 +114,99 @@ GeoTag::wireEncode() const
   return m_wire;
 }
 
+void
+GeoTag::wireEncodeValue(uint8_t* value) const
+{
+  writeInt32(value, m_pos_x);
+  writeInt32(value + 4, m_pos_y);
+  writeInt32(value + 8, m_pos_z);
+  writeInt32(value + 12, m_speed);
+  writeInt32(value + 16, m_heading);
+}
+
 void
 GeoTag::wireDecode(const Block& wire)
 {
   if (wire.type() != tlv::GeoTag) {
     BOOST_THROW_EXCEPTION(Error("expecting GeoTag block"));
   }
+  if (wire.value_size() != VALUE_LENGTH) {
+    BOOST_THROW_EXCEPTION(Error("GeoTag has invalid length"));
+  }
 
-  m_wire = wire;
-  m_wire.parse();
+  const uint8_t* value = wire.value();
+  m_pos_x = readInt32(value);
+  m_pos_y = readInt32(value + 4);
+  m_pos_z = readInt32(value + 8);
+  m_speed = readInt32(value + 12);
+  m_heading = readInt32(value + 16);
 
-  Block::element_const_iterator it = m_wire.elements_begin();
-  // decode position y first
-  if (it != m_wire.elements_end() && it->type() == tlv::GeoTagPos) {
-    m_pos_y = static_cast<uint32_t>(readNonNegativeInteger(*it)) / 10.0;
-  }
-  else {
-    BOOST_THROW_EXCEPTION(Error("expecting CachePolicyType block for position Y"));
-  }
-  // move and decode position x then
-  it++;
-  if (it != m_wire.elements_end() && it->type() == tlv::GeoTagPos) {
-    m_pos_x = static_cast<uint32_t>(readNonNegativeInteger(*it)) / 10.0;
-  }
-  else {
-    BOOST_THROW_EXCEPTION(Error("expecting CachePolicyType block for position X"));
-  }
-  // if both positions are 0
-  if (m_pos_x == 0.0 && m_pos_y == 0.0) {
-    BOOST_THROW_EXCEPTION(Error("positions must be set"));
-  }
+  m_wire = wire;
 }
 
 double
 GeoTag::getPosX() const
 {
-  return m_pos_x;
+  return fromFixedPoint(m_pos_x);
 }
 
 double
 GeoTag::getPosY() const
 {
-  return m_pos_y;
+  return fromFixedPoint(m_pos_y);
+}
+
+double
+GeoTag::getPosZ() const
+{
+  return fromFixedPoint(m_pos_z);
+}
+
+double
+GeoTag::getSpeed() const
+{
+  return fromFixedPoint(m_speed);
+}
+
+double
+GeoTag::getHeading() const
+{
+  return fromFixedPoint(m_heading);
 }
 
 void
 GeoTag::setPosX(double pos_x)
 {
-  m_pos_x = pos_x;
+  m_pos_x = toFixedPoint(pos_x);
+  m_wire.reset();
 }
 
 void
 GeoTag::setPosY(double pos_y)
 {
-  m_pos_y = pos_y;
+  m_pos_y = toFixedPoint(pos_y);
+  m_wire.reset();
+}
+
+void
+GeoTag::setPosZ(double pos_z)
+{
+  m_pos_z = toFixedPoint(pos_z);
+  m_wire.reset();
+}
+
+void
+GeoTag::setSpeed(double speed)
+{
+  m_speed = toFixedPoint(speed);
+  m_wire.reset();
+}
+
+void
+GeoTag::setHeading(double heading)
+{
+  m_heading = toFixedPoint(heading);
+  m_wire.reset();
 }
 
 } // namespace lp
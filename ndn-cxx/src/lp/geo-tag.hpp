@@ -35,7 +35,18 @@ namespace ndn {
 namespace lp {
 
 /**
- * \brief represents a CachePolicy header field
+ * \brief represents a GeoTag header field
+ *
+ * GeoTag carries the position, speed, and heading of the node that transmitted the packet.
+ * Each quantity is encoded as a 32-bit big-endian two's complement integer in hundredths of
+ * its unit (centimetres, centimetres per second, hundredths of a degree), so the TLV-VALUE
+ * always has length VALUE_LENGTH:
+ *
+ *     GeoTag ::= GEO-TAG-TYPE TLV-LENGTH(=20)
+ *                  PosX PosY PosZ Speed Heading
+ *
+ * The fixed length allows a GeoTag in an already encoded LpPacket to be overwritten in place
+ * with wireEncodeValue, without re-encoding the enclosing packet.
  */
 class GeoTag
 {
@@ -50,6 +61,11 @@ public:
     }
   };
 
+  /**
+   * \brief length of the TLV-VALUE of an encoded GeoTag
+   */
+  static const size_t VALUE_LENGTH = 20;
+
   GeoTag();
 
   explicit
@@ -68,6 +84,14 @@ public:
   const Block&
   wireEncode() const;
 
+  /**
+   * \brief write the TLV-VALUE of GeoTag
+   * \param value points to VALUE_LENGTH writable octets, usually the TLV-VALUE of a GeoTag
+   *        element inside an encoded LpPacket
+   */
+  void
+  wireEncodeValue(uint8_t* value) const;
+
   /**
    * \brief get GeoTag from wire format
    */
@@ -76,17 +100,35 @@ public:
 
 public: // get & set GeoTag
   /**
-   * \return position x of GeoTag
+   * \return position x of GeoTag, in metres
    */
   double
   getPosX() const;
 
   /**
-   * \return position y of GeoTag
+   * \return position y of GeoTag, in metres
    */
   double
   getPosY() const;
 
+  /**
+   * \return position z of GeoTag, in metres
+   */
+  double
+  getPosZ() const;
+
+  /**
+   * \return speed of the transmitting node, in metres per second
+   */
+  double
+  getSpeed() const;
+
+  /**
+   * \return heading of the transmitting node, in degrees
+   */
+  double
+  getHeading() const;
+
   /**
    * \brief set position x
    */
@@ -99,9 +141,31 @@ public: // get & set GeoTag
   void
   setPosY(double pos_y);
 
+  /**
+   * \brief set position z
+   */
+  void
+  setPosZ(double pos_z);
+
+  /**
+   * \brief set speed
+   */
+  void
+  setSpeed(double speed);
+
+  /**
+   * \brief set heading
+   */
+  void
+  setHeading(double heading);
+
 private:
-  double m_pos_x;
-  double m_pos_y;
+  // fixed-point values, in hundredths of the unit
+  int32_t m_pos_x;
+  int32_t m_pos_y;
+  int32_t m_pos_z;
+  int32_t m_speed;
+  int32_t m_heading;
   mutable Block m_wire;
 };
 
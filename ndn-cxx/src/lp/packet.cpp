@@ -78,13 +78,9 @@ Packet::wireEncode() const
     return elements.front().elements().front();
   }
 
-  EncodingEstimator estimator;
-  size_t estimatedSize = wireEncode(estimator);
-
-  EncodingBuffer buffer(estimatedSize, 0);
-  wireEncode(buffer);
-
-  m_wire = buffer.block();
+  m_wire = encoding::encodeInArena<Packet>([this] (EncodingBuffer& encoder) {
+      wireEncode(encoder);
+    });
   return m_wire;
 }
 
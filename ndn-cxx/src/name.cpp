@@ -165,6 +165,7 @@ Name::wireDecode(const Block& wire)
 
   m_nameBlock = wire;
   m_nameBlock.parse();
+  m_prefixHashes.reset();
 }
 
 std::string
@@ -191,6 +192,7 @@ Name::append(const PartialName& name)
 Name&
 Name::appendNumber(uint64_t number)
 {
+  beforeAppend();
   m_nameBlock.push_back(Component::fromNumber(number));
   return *this;
 }
@@ -198,6 +200,7 @@ Name::appendNumber(uint64_t number)
 Name&
 Name::appendNumberWithMarker(uint8_t marker, uint64_t number)
 {
+  beforeAppend();
   m_nameBlock.push_back(Component::fromNumberWithMarker(marker, number));
   return *this;
 }
@@ -205,6 +208,7 @@ Name::appendNumberWithMarker(uint8_t marker, uint64_t number)
 Name&
 Name::appendVersion(uint64_t version)
 {
+  beforeAppend();
   m_nameBlock.push_back(Component::fromVersion(version));
   return *this;
 }
@@ -219,6 +223,7 @@ Name::appendVersion()
 Name&
 Name::appendSegment(uint64_t segmentNo)
 {
+  beforeAppend();
   m_nameBlock.push_back(Component::fromSegment(segmentNo));
   return *this;
 }
@@ -226,6 +231,7 @@ Name::appendSegment(uint64_t segmentNo)
 Name&
 Name::appendSegmentOffset(uint64_t offset)
 {
+  beforeAppend();
   m_nameBlock.push_back(Component::fromSegmentOffset(offset));
   return *this;
 }
@@ -233,6 +239,7 @@ Name::appendSegmentOffset(uint64_t offset)
 Name&
 Name::appendTimestamp(const time::system_clock::TimePoint& timePoint)
 {
+  beforeAppend();
   m_nameBlock.push_back(Component::fromTimestamp(timePoint));
   return *this;
 }
@@ -240,6 +247,7 @@ Name::appendTimestamp(const time::system_clock::TimePoint& timePoint)
 Name&
 Name::appendSequenceNumber(uint64_t seqNo)
 {
+  beforeAppend();
   m_nameBlock.push_back(Component::fromSequenceNumber(seqNo));
   return *this;
 }
@@ -247,6 +255,7 @@ Name::appendSequenceNumber(uint64_t seqNo)
 Name&
 Name::appendImplicitSha256Digest(const ConstBufferPtr& digest)
 {
+  beforeAppend();
   m_nameBlock.push_back(Component::fromImplicitSha256Digest(digest));
   return *this;
 }
@@ -254,6 +263,7 @@ Name::appendImplicitSha256Digest(const ConstBufferPtr& digest)
 Name&
 Name::appendImplicitSha256Digest(const uint8_t* digest, size_t digestSize)
 {
+  beforeAppend();
   m_nameBlock.push_back(Component::fromImplicitSha256Digest(digest, digestSize));
   return *this;
 }
@@ -274,6 +284,11 @@ Name::getSubName(ssize_t iStartComponent, size_t nComponents) const
   for (size_t i = iStart; i < iEnd; ++i)
     result.append(at(i));
 
+  if (iStart == 0) {
+    // hashes of the prefixes of a prefix are the same
+    result.m_prefixHashes = m_prefixHashes;
+  }
+
   return result;
 }
 
@@ -139,6 +139,7 @@ public:
   Name&
   append(const uint8_t* value, size_t valueLength)
   {
+    beforeAppend();
     m_nameBlock.push_back(Component(value, valueLength));
     return *this;
   }
@@ -156,6 +157,7 @@ public:
   Name&
   append(Iterator first, Iterator last)
   {
+    beforeAppend();
     m_nameBlock.push_back(Component(first, last));
     return *this;
   }
@@ -166,6 +168,7 @@ public:
   Name&
   append(const Component& value)
   {
+    beforeAppend();
     m_nameBlock.push_back(value);
     return *this;
   }
@@ -180,6 +183,7 @@ public:
   Name&
   append(const char* value)
   {
+    beforeAppend();
     m_nameBlock.push_back(Component(value));
     return *this;
   }
@@ -187,6 +191,7 @@ public:
   Name&
   append(const Block& value)
   {
+    beforeAppend();
     if (value.type() == tlv::NameComponent)
       m_nameBlock.push_back(value);
     else
@@ -210,6 +215,7 @@ public:
   clear()
   {
     m_nameBlock = Block(tlv::Name);
+    m_prefixHashes.reset();
   }
 
   /**
@@ -599,13 +605,56 @@ public:
     return const_reverse_iterator(begin());
   }
 
+public:
+  /** \brief hash values of the prefixes of a name; the i-th value belongs to getPrefix(i)
+   */
+  typedef std::vector<size_t> PrefixHashes;
+
+  /** \brief get the prefix hash values cached on this name
+   *  \return the cached values, or nullptr if none are cached
+   *
+   *  The sequence may be shorter or longer than size() + 1: appending components keeps the
+   *  values of the existing prefixes, and getPrefix/getSubName(0, n) share the cache of the
+   *  original name.  Values beyond size() must be ignored.  Any other modification of the
+   *  name drops the cache.
+   *
+   *  Name does not compute the values itself.  The cache is filled by its user (e.g., the
+   *  NFD name tree), and there can only be one hash function in use per process.
+   */
+  const shared_ptr<const PrefixHashes>&
+  getCachedPrefixHashes() const
+  {
+    return m_prefixHashes;
+  }
+
+  /** \brief cache prefix hash values on this name
+   *  \pre the values up to size() are the hashes of the corresponding prefixes
+   */
+  void
+  setCachedPrefixHashes(shared_ptr<const PrefixHashes> hashes) const
+  {
+    m_prefixHashes = std::move(hashes);
+  }
+
 public:
   /** \brief indicates "until the end" in getSubName and compare
    */
   static const size_t npos;
 
+private:
+  /** \brief drop cached prefix hashes that become invalid when a component is appended
+   */
+  void
+  beforeAppend()
+  {
+    if (m_prefixHashes != nullptr && m_prefixHashes->size() > size() + 1) {
+      m_prefixHashes.reset();
+    }
+  }
+
 private:
   mutable Block m_nameBlock;
+  mutable shared_ptr<const PrefixHashes> m_prefixHashes;
 };
 
 std::ostream&
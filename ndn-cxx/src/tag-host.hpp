@@ -25,11 +25,204 @@
 #include "common.hpp"
 #include "tag.hpp"
 
+#include <array>
 #include <map>
 
 namespace ndn {
+namespace detail {
+
+/** \brief number of fixed slots in TagHost
+ */
+static constexpr size_t N_TAG_SLOTS = 6;
+
+/** \return the fixed TagHost slot of tags with type ID \p typeId,
+ *          or N_TAG_SLOTS if such tags are kept in the fallback map
+ *  \sa lp/tags.hpp
+ */
+constexpr size_t
+getTagSlot(uint64_t typeId)
+{
+  return typeId >= 10 && typeId <= 13 ? static_cast<size_t>(typeId - 10) : // lp tags
+         typeId == 0x60000000 ? 4 : // lp::HopCountTag
+         typeId == 0x60000001 ? 5 : // lp::GeoCordTag
+         N_TAG_SLOTS;
+}
+
+/** \brief a TagHost slot, holding either nothing, a shared_ptr to a tag, or a small tag inline
+ */
+class TagSlot
+{
+public:
+  TagSlot() noexcept
+    : m_ops(nullptr)
+  {
+  }
+
+  TagSlot(const TagSlot& other)
+    : m_ops(nullptr)
+  {
+    *this = other;
+  }
+
+  TagSlot&
+  operator=(const TagSlot& other)
+  {
+    if (this != &other) {
+      reset();
+      if (other.m_ops != nullptr) {
+        other.m_ops->copy(&other.m_storage, &m_storage);
+        m_ops = other.m_ops;
+      }
+    }
+    return *this;
+  }
+
+  ~TagSlot()
+  {
+    reset();
+  }
+
+  bool
+  empty() const noexcept
+  {
+    return m_ops == nullptr;
+  }
+
+  /** \return the stored tag, or nullptr if the slot is empty
+   */
+  Tag*
+  get() const noexcept
+  {
+    return m_ops == nullptr ? nullptr : m_ops->get(const_cast<Storage*>(&m_storage));
+  }
+
+  /** \return the stored tag as shared_ptr
+   *
+   *  An inline tag is moved into a shared_ptr first, so that the same tag is returned by
+   *  subsequent calls.
+   */
+  template<typename T>
+  shared_ptr<T>
+  getShared()
+  {
+    if (m_ops == nullptr) {
+      return nullptr;
+    }
+    if (m_ops != &SharedOps::ops) {
+      auto tag = make_shared<T>(std::move(*static_cast<T*>(get())));
+      setShared(tag);
+    }
+    return static_pointer_cast<T>(*reinterpret_cast<shared_ptr<Tag>*>(&m_storage));
+  }
+
+  void
+  setShared(shared_ptr<Tag> tag)
+  {
+    reset();
+    if (tag != nullptr) {
+      new (&m_storage) shared_ptr<Tag>(std::move(tag));
+      m_ops = &SharedOps::ops;
+    }
+  }
+
+  /** \brief whether a tag of type T can be stored inline
+   */
+  template<typename T>
+  static constexpr bool
+  canStoreInline()
+  {
+    return sizeof(T) <= sizeof(Storage) && alignof(T) <= alignof(Storage) &&
+           std::is_nothrow_move_constructible<T>::value;
+  }
+
+  template<typename T, typename... Args>
+  void
+  emplace(Args&&... args)
+  {
+    static_assert(canStoreInline<T>(), "T cannot be stored inline");
+
+    reset();
+    new (&m_storage) T(std::forward<Args>(args)...);
+    m_ops = &InlineOps<T>::ops;
+  }
+
+  void
+  reset() noexcept
+  {
+    if (m_ops != nullptr) {
+      m_ops->destroy(&m_storage);
+      m_ops = nullptr;
+    }
+  }
+
+private:
+  typedef std::aligned_storage<sizeof(shared_ptr<Tag>), alignof(shared_ptr<Tag>)>::type Storage;
+
+  struct Ops
+  {
+    Tag* (*get)(void* storage);
+    void (*copy)(const void* from, void* to);
+    void (*destroy)(void* storage);
+  };
+
+  template<typename T>
+  struct InlineOps
+  {
+    static Tag*
+    get(void* storage)
+    {
+      return toTag(static_cast<T*>(storage));
+    }
+
+    static void
+    copy(const void* from, void* to)
+    {
+      new (to) T(*static_cast<const T*>(from));
+    }
+
+    static void
+    destroy(void* storage)
+    {
+      static_cast<T*>(storage)->~T();
+    }
+
+    static const Ops ops;
+  };
+
+  // a shared_ptr is stored like an inline tag, except for how the tag is obtained
+  typedef InlineOps<shared_ptr<Tag>> SharedOps;
+
+  static Tag*
+  toTag(Tag* tag)
+  {
+    return tag;
+  }
+
+  static Tag*
+  toTag(shared_ptr<Tag>* tag)
+  {
+    return tag->get();
+  }
+
+  Storage m_storage;
+  const Ops* m_ops;
+};
+
+template<typename T>
+const TagSlot::Ops TagSlot::InlineOps<T>::ops = {
+  &InlineOps<T>::get,
+  &InlineOps<T>::copy,
+  &InlineOps<T>::destroy
+};
+
+} // namespace detail
 
 /** \brief Base class to store tag information (e.g., inside Interest and Data packets)
+ *
+ *  Tags defined in lp/tags.hpp have fixed slots, found without a lookup; other tags are kept
+ *  in a map by type ID.  Small tags with a fixed slot, such as lp::IncomingFaceIdTag, can be
+ *  stored inline with emplaceTag and read with peekTag, which avoids allocating a shared_ptr
+ *  for every packet.
  */
 class TagHost
 {
@@ -37,11 +230,24 @@ public:
   /** \brief get a tag item
    *  \tparam T type of the tag, which must be a subclass of ndn::Tag
    *  \retval nullptr if no Tag of type T is stored
+   *  \note If the tag is stored inline, it is moved onto the heap first; use peekTag to
+   *        read it without allocation.
    */
   template<typename T>
   shared_ptr<T>
   getTag() const;
 
+  /** \brief get a tag item without taking ownership
+   *  \tparam T type of the tag, which must be a subclass of ndn::Tag
+   *  \retval nullptr if no Tag of type T is stored
+   *  \warning The returned pointer is invalidated when the tag is set or removed, when
+   *           getTag<T>() moves an inline tag onto the heap, or when the tag host is
+   *           destroyed.
+   */
+  template<typename T>
+  const T*
+  peekTag() const;
+
   /** \brief set a tag item
    *  \tparam T type of the tag, which must be a subclass of ndn::Tag
    *  \note Tag can be set even on a const tag host instance
@@ -50,6 +256,18 @@ public:
   void
   setTag(shared_ptr<T> tag) const;
 
+  /** \brief construct a tag item in place
+   *  \tparam T type of the tag, which must be a subclass of ndn::Tag
+   *  \param args arguments to the constructor of T
+   *
+   *  The tag is stored inline if T has a fixed slot and is small enough,
+   *  otherwise it is allocated with make_shared.
+   *  \note Tag can be set even on a const tag host instance
+   */
+  template<typename T, typename... Args>
+  void
+  emplaceTag(Args&&... args) const;
+
   /** \brief remove tag item
    *  \note Tag can be removed even on a const tag host instance
    */
@@ -58,7 +276,30 @@ public:
   removeTag() const;
 
 private:
-  mutable std::map<size_t, shared_ptr<Tag>> m_tags;
+  template<typename T>
+  static constexpr size_t
+  getSlot()
+  {
+    return detail::getTagSlot(T::getTypeId());
+  }
+
+  template<typename T, typename... Args>
+  void
+  emplaceTagImpl(std::true_type, Args&&... args) const
+  {
+    m_slots[getSlot<T>()].template emplace<T>(std::forward<Args>(args)...);
+  }
+
+  template<typename T, typename... Args>
+  void
+  emplaceTagImpl(std::false_type, Args&&... args) const
+  {
+    setTag(make_shared<T>(std::forward<Args>(args)...));
+  }
+
+private:
+  mutable std::array<detail::TagSlot, detail::N_TAG_SLOTS> m_slots;
+  mutable std::map<size_t, shared_ptr<Tag>> m_tags; ///< tags without a fixed slot
 };
 
 
@@ -68,6 +309,10 @@ TagHost::getTag() const
 {
   static_assert(std::is_base_of<Tag, T>::value, "T must inherit from Tag");
 
+  if (getSlot<T>() < detail::N_TAG_SLOTS) {
+    return m_slots[getSlot<T>()].template getShared<T>();
+  }
+
   auto it = m_tags.find(T::getTypeId());
   if (it == m_tags.end()) {
     return nullptr;
@@ -75,12 +320,34 @@ TagHost::getTag() const
   return static_pointer_cast<T>(it->second);
 }
 
+template<typename T>
+inline const T*
+TagHost::peekTag() const
+{
+  static_assert(std::is_base_of<Tag, T>::value, "T must inherit from Tag");
+
+  if (getSlot<T>() < detail::N_TAG_SLOTS) {
+    return static_cast<const T*>(m_slots[getSlot<T>()].get());
+  }
+
+  auto it = m_tags.find(T::getTypeId());
+  if (it == m_tags.end()) {
+    return nullptr;
+  }
+  return static_cast<const T*>(it->second.get());
+}
+
 template<typename T>
 inline void
 TagHost::setTag(shared_ptr<T> tag) const
 {
   static_assert(std::is_base_of<Tag, T>::value, "T must inherit from Tag");
 
+  if (getSlot<T>() < detail::N_TAG_SLOTS) {
+    m_slots[getSlot<T>()].setShared(std::move(tag));
+    return;
+  }
+
   if (tag == nullptr) {
     m_tags.erase(T::getTypeId());
     return;
@@ -89,6 +356,17 @@ TagHost::setTag(shared_ptr<T> tag) const
   m_tags[T::getTypeId()] = tag;
 }
 
+template<typename T, typename... Args>
+inline void
+TagHost::emplaceTag(Args&&... args) const
+{
+  static_assert(std::is_base_of<Tag, T>::value, "T must inherit from Tag");
+
+  emplaceTagImpl<T>(std::integral_constant<bool, getSlot<T>() < detail::N_TAG_SLOTS &&
+                                                 detail::TagSlot::canStoreInline<T>()>(),
+                    std::forward<Args>(args)...);
+}
+
 template<typename T>
 inline void
 TagHost::removeTag() const
@@ -221,7 +221,7 @@ template<typename Packet, typename Field, typename Tag>
 static void
 addFieldFromTag(lp::Packet& lpPacket, const Packet& packet)
 {
-  shared_ptr<Tag> tag = static_cast<const TagHost&>(packet).getTag<Tag>();
+  const Tag* tag = static_cast<const TagHost&>(packet).peekTag<Tag>();
   if (tag != nullptr) {
     lpPacket.add<Field>(*tag);
   }
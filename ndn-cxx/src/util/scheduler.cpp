@@ -20,32 +20,108 @@
  */
 
 #include "scheduler.hpp"
-#include <boost/scope_exit.hpp>
 
-namespace ns3 {
+#include <memory>
 
-/// @cond include_hidden
+namespace ndn {
+namespace util {
+namespace scheduler {
+
+namespace detail {
+
+EventInfo::EventInfo()
+  : generation(0)
+  , scheduler(nullptr)
+  , prev(nullptr)
+  , next(nullptr)
+  , m_invoke(nullptr)
+  , m_destroy(nullptr)
+{
+}
+
+EventInfo::~EventInfo()
+{
+  clearCallback();
+}
+
+void
+EventInfo::clearCallback()
+{
+  if (m_destroy != nullptr) {
+    m_destroy(&m_storage);
+    m_invoke = nullptr;
+    m_destroy = nullptr;
+  }
+}
 
-template<>
-struct EventMemberImplObjTraits<std::function<void()>> {
-  typedef std::function<void()> T;
-  static T&
-  GetReference(T& p)
+/** \brief slab allocator of EventInfo slots shared by all schedulers
+ */
+class EventPool : noncopyable
+{
+public:
+  EventPool()
+    : m_free(nullptr)
+  {
+  }
+
+  EventInfo*
+  allocate()
+  {
+    if (m_free == nullptr) {
+      grow();
+    }
+    EventInfo* info = m_free;
+    m_free = info->next;
+    info->next = nullptr;
+    return info;
+  }
+
+  void
+  release(EventInfo* info)
   {
-    return p;
+    info->next = m_free;
+    m_free = info;
   }
+
+private:
+  void
+  grow()
+  {
+    static const size_t SLAB_SIZE = 256;
+
+    m_slabs.emplace_back(new EventInfo[SLAB_SIZE]);
+    EventInfo* slab = m_slabs.back().get();
+    for (size_t i = 0; i < SLAB_SIZE; ++i) {
+      release(&slab[i]);
+    }
+  }
+
+private:
+  std::vector<std::unique_ptr<EventInfo[]>> m_slabs;
+  EventInfo* m_free;
 };
 
-/// @endcond
+static EventPool&
+getEventPool()
+{
+  // never destructed: EventIds and schedulers may outlive static destruction
+  static EventPool* pool = new EventPool;
+  return *pool;
+}
 
-} // namespace ns3
+} // namespace detail
 
-namespace ndn {
-namespace util {
-namespace scheduler {
+std::ostream&
+operator<<(std::ostream& os, const EventId& eventId)
+{
+  if (!eventId) {
+    return os << "(expired)";
+  }
+  return os << eventId.m_info << ":" << eventId.m_generation;
+}
 
 Scheduler::Scheduler(boost::asio::io_service& ioService)
-  : m_scheduledEvent(m_events.end())
+  : m_events(nullptr)
 {
 }
 
@@ -54,50 +130,88 @@ Scheduler::~Scheduler()
   cancelAllEvents();
 }
 
+detail::EventInfo*
+Scheduler::allocateEvent()
+{
+  return detail::getEventPool().allocate();
+}
+
 EventId
-Scheduler::scheduleEvent(const time::nanoseconds& after, const Event& event)
+Scheduler::schedule(const time::nanoseconds& after, detail::EventInfo* info)
 {
-  EventId eventId = std::make_shared<ns3::EventId>();
-  weak_ptr<ns3::EventId> eventWeak = eventId;
-  std::function<void()> eventWithCleanup = [this, event, eventWeak] () {
-    event();
-    shared_ptr<ns3::EventId> eventId = eventWeak.lock();
-    if (eventId != nullptr) {
-      this->m_events.erase(eventId); // remove the event from the set after it is executed
-    }
-  };
+  info->scheduler = this;
+  info->nsEventId = ns3::Simulator::Schedule(ns3::NanoSeconds(after.count()),
+                                             &Scheduler::executeEvent, this, info);
+
+  info->prev = nullptr;
+  info->next = m_events;
+  if (m_events != nullptr) {
+    m_events->prev = info;
+  }
+  m_events = info;
+
+  return EventId(info);
+}
 
-  ns3::EventId id = ns3::Simulator::Schedule(ns3::NanoSeconds(after.count()),
-                                             &std::function<void()>::operator(), eventWithCleanup);
-  *eventId = std::move(id);
-  m_events.insert(eventId);
+void
+Scheduler::executeEvent(detail::EventInfo* info)
+{
+  unlink(info);
+  ++info->generation; // the event is expired during its own callback
 
-  return eventId;
+  info->invoke();
+  releaseEvent(info);
 }
 
 void
 Scheduler::cancelEvent(const EventId& eventId)
 {
-  if (eventId != nullptr) {
-    ns3::Simulator::Remove(*eventId);
-    const_cast<EventId&>(eventId).reset();
-    m_events.erase(eventId);
+  if (!eventId) {
+    return;
   }
+
+  // the event may belong to another scheduler; it must leave that scheduler's list
+  detail::EventInfo* info = eventId.m_info;
+  ns3::Simulator::Remove(info->nsEventId);
+  info->scheduler->unlink(info);
+  releaseEvent(info);
+  const_cast<EventId&>(eventId).reset();
 }
 
 void
 Scheduler::cancelAllEvents()
 {
-  for (auto i = m_events.begin(); i != m_events.end(); ) {
-    auto next = i;
-    ++next; // ns3::Simulator::Remove can call cancelEvent
-    if ((*i) != nullptr) {
-      ns3::Simulator::Remove((**i));
-      const_cast<EventId&>(*i).reset();
-    }
-    i = next;
+  while (m_events != nullptr) {
+    detail::EventInfo* info = m_events;
+    ns3::Simulator::Remove(info->nsEventId);
+    unlink(info);
+    releaseEvent(info);
   }
-  m_events.clear();
+}
+
+void
+Scheduler::unlink(detail::EventInfo* info)
+{
+  if (info->prev != nullptr) {
+    info->prev->next = info->next;
+  }
+  else {
+    m_events = info->next;
+  }
+  if (info->next != nullptr) {
+    info->next->prev = info->prev;
+  }
+  info->prev = info->next = nullptr;
+}
+
+void
+Scheduler::releaseEvent(detail::EventInfo* info)
+{
+  ++info->generation;
+  info->clearCallback();
+  info->nsEventId = ns3::EventId();
+  info->scheduler = nullptr;
+  detail::getEventPool().release(info);
 }
 
 } // namespace scheduler
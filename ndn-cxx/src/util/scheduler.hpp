@@ -27,19 +27,190 @@
 
 #include "ns3/simulator.h"
 
-#include <set>
+#include <type_traits>
 
 namespace ndn {
 namespace util {
 namespace scheduler {
 
-/** \class EventId
- *  \brief Opaque type (shared_ptr) representing ID of a scheduled event
+class Scheduler;
+class EventId;
+
+namespace detail {
+
+/**
+ * \brief Storage of a scheduled event
+ *
+ * EventInfo slots are allocated from a pool shared by all schedulers and are never returned
+ * to the system, so an EventId may safely refer to a slot after its event has expired or
+ * its scheduler has been destroyed.  The slot generation is incremented whenever the slot
+ * expires, which invalidates all EventIds issued for it.
+ *
+ * Callbacks that fit into INLINE_SIZE octets are stored inside the slot; larger ones are
+ * allocated separately.
  */
-typedef std::shared_ptr<ns3::EventId> EventId;
+class EventInfo : noncopyable
+{
+public:
+  static const size_t INLINE_SIZE = 48;
+
+  EventInfo();
+
+  ~EventInfo();
+
+  template<typename F>
+  void
+  setCallback(F&& callback);
+
+  void
+  invoke()
+  {
+    m_invoke(&m_storage);
+  }
+
+  void
+  clearCallback();
+
+private:
+  template<typename Callback, typename F>
+  void
+  doSetCallback(F&& callback, std::true_type isInline);
+
+  template<typename Callback, typename F>
+  void
+  doSetCallback(F&& callback, std::false_type isInline);
+
+public:
+  uint64_t generation;
+  Scheduler* scheduler;
+  EventInfo* prev; ///< \brief previous pending event of the scheduler
+  EventInfo* next; ///< \brief next pending event of the scheduler, or next free slot
+  ns3::EventId nsEventId;
+
+private:
+  typedef std::aligned_storage<INLINE_SIZE>::type Storage;
+  Storage m_storage;
+  void (*m_invoke)(void* storage);
+  void (*m_destroy)(void* storage);
+};
+
+template<typename F>
+void
+EventInfo::setCallback(F&& callback)
+{
+  typedef typename std::decay<F>::type Callback;
+  typedef std::integral_constant<bool, sizeof(Callback) <= INLINE_SIZE &&
+                                       alignof(Callback) <= alignof(Storage)> IsInline;
+
+  BOOST_ASSERT(m_destroy == nullptr);
+  doSetCallback<Callback>(std::forward<F>(callback), IsInline());
+}
+
+template<typename Callback, typename F>
+void
+EventInfo::doSetCallback(F&& callback, std::true_type)
+{
+  new (&m_storage) Callback(std::forward<F>(callback));
+  m_invoke = [] (void* storage) { (*static_cast<Callback*>(storage))(); };
+  m_destroy = [] (void* storage) { static_cast<Callback*>(storage)->~Callback(); };
+}
+
+template<typename Callback, typename F>
+void
+EventInfo::doSetCallback(F&& callback, std::false_type)
+{
+  new (&m_storage) Callback*(new Callback(std::forward<F>(callback)));
+  m_invoke = [] (void* storage) { (**static_cast<Callback**>(storage))(); };
+  m_destroy = [] (void* storage) { delete *static_cast<Callback**>(storage); };
+}
+
+} // namespace detail
+
+/** \brief Identifies a scheduled event
+ *
+ *  EventId evaluates to false, and compares equal to nullptr, once the event has been
+ *  executed (including during its callback) or cancelled.
+ */
+class EventId
+{
+public:
+  EventId() noexcept
+    : m_info(nullptr)
+    , m_generation(0)
+  {
+  }
+
+  EventId(std::nullptr_t) noexcept
+    : EventId()
+  {
+  }
+
+  /** \retval true the event is still pending
+   */
+  explicit
+  operator bool() const noexcept
+  {
+    return m_info != nullptr && m_info->generation == m_generation;
+  }
+
+  bool
+  operator!() const noexcept
+  {
+    return !static_cast<bool>(*this);
+  }
+
+  /** \return whether both EventIds refer to the same pending event, or both are expired
+   */
+  bool
+  operator==(const EventId& other) const noexcept
+  {
+    bool isPending = static_cast<bool>(*this);
+    if (isPending != static_cast<bool>(other)) {
+      return false;
+    }
+    return !isPending || (m_info == other.m_info && m_generation == other.m_generation);
+  }
+
+  bool
+  operator!=(const EventId& other) const noexcept
+  {
+    return !(*this == other);
+  }
+
+  /** \brief clear this EventId
+   *  \note This does not cancel the event.
+   */
+  void
+  reset() noexcept
+  {
+    m_info = nullptr;
+    m_generation = 0;
+  }
+
+private:
+  EventId(detail::EventInfo* info) noexcept
+    : m_info(info)
+    , m_generation(info->generation)
+  {
+  }
+
+private:
+  detail::EventInfo* m_info;
+  uint64_t m_generation;
+
+  friend class Scheduler;
+  friend std::ostream& operator<<(std::ostream& os, const EventId& eventId);
+};
+
+std::ostream&
+operator<<(std::ostream& os, const EventId& eventId);
 
 /**
  * \brief Generic scheduler
+ *
+ * Every event is backed by an ns-3 event.  Event storage is pooled, and pending events are
+ * kept in an intrusive list, so scheduling and cancelling do not allocate apart from the
+ * ns-3 event itself (and callbacks larger than detail::EventInfo::INLINE_SIZE).
  */
 class Scheduler : noncopyable
 {
@@ -56,10 +227,18 @@ public:
 
   /**
    * \brief Schedule a one-time event after the specified delay
+   * \param callback a callable object with signature void(); it is moved or copied into the
+   *        event storage
    * \return EventId that can be used to cancel the scheduled event
    */
+  template<typename F>
   EventId
-  scheduleEvent(const time::nanoseconds& after, const Event& event);
+  scheduleEvent(const time::nanoseconds& after, F&& callback)
+  {
+    detail::EventInfo* info = allocateEvent();
+    info->setCallback(std::forward<F>(callback));
+    return schedule(after, info);
+  }
 
   /**
    * \brief Cancel a scheduled event
@@ -74,36 +253,23 @@ public:
   cancelAllEvents();
 
 private:
-  struct EventInfo
-  {
-    EventInfo(const time::nanoseconds& after, const Event& event);
+  detail::EventInfo*
+  allocateEvent();
 
-    EventInfo(const time::steady_clock::TimePoint& when, const EventInfo& previousEvent);
-
-    bool
-    operator <=(const EventInfo& other) const
-    {
-      return this->m_scheduledTime <= other.m_scheduledTime;
-    }
-
-    bool
-    operator <(const EventInfo& other) const
-    {
-      return this->m_scheduledTime < other.m_scheduledTime;
-    }
+  EventId
+  schedule(const time::nanoseconds& after, detail::EventInfo* info);
 
-    time::nanoseconds
-    expiresFromNow() const;
+  void
+  executeEvent(detail::EventInfo* info);
 
-    time::steady_clock::TimePoint m_scheduledTime;
-    Event m_event;
-    mutable EventId m_eventId;
-  };
+  void
+  unlink(detail::EventInfo* info);
 
-  typedef std::multiset<EventId> EventQueue;
+  void
+  releaseEvent(detail::EventInfo* info);
 
-  EventQueue m_events;
-  EventQueue::iterator m_scheduledEvent;
+private:
+  detail::EventInfo* m_events; // head of the list of pending events
 };
 
 } // namespace scheduler
@@ -0,0 +1,146 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2016 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#define BOOST_TEST_MAIN 1
+#define BOOST_TEST_DYN_LINK 1
+#define BOOST_TEST_MODULE Block Decode Benchmark
+
+#include "interest.hpp"
+#include "data.hpp"
+#include "lp/packet.hpp"
+#include "encoding/block-helpers.hpp"
+
+#include "boost-test.hpp"
+
+namespace ndn {
+namespace tests {
+
+/** \brief wire encodings of Interests, Data, and LpPackets carrying either of them,
+ *         in the proportions seen by a forwarder
+ */
+class BlockDecodeBenchmarkFixture
+{
+protected:
+  BlockDecodeBenchmarkFixture()
+  {
+    static const uint8_t SIGNATURE[32] = {};
+    std::vector<uint8_t> content(1024);
+
+    for (size_t i = 0; i < N_PACKETS; ++i) {
+      Name name("/benchmark/video");
+      name.appendNumber(i % 64).append("segment").appendSegment(i);
+
+      Interest interest(name);
+      interest.setInterestLifetime(time::seconds(2));
+      interest.setNonce(i);
+
+      Data data(name);
+      data.setFreshnessPeriod(time::seconds(10));
+      data.setContent(content.data(), content.size());
+      data.setSignature(Signature(SignatureInfo(tlv::DigestSha256),
+                                  makeBinaryBlock(tlv::SignatureValue, SIGNATURE, sizeof(SIGNATURE))));
+
+      const Block& netPkt = i % 2 == 0 ? interest.wireEncode() : data.wireEncode();
+      lp::Packet lpPacket(netPkt);
+      lpPacket.add<lp::SequenceField>(i);
+      lpPackets.push_back(lpPacket.wireEncode());
+
+      netPackets.push_back(netPkt);
+    }
+  }
+
+  template<typename F>
+  void
+  run(const std::string& label, const F& decode)
+  {
+    size_t nDecoded = 0;
+    time::steady_clock::TimePoint t1 = time::steady_clock::now();
+    for (size_t round = 0; round < N_ROUNDS; ++round) {
+      for (size_t i = 0; i < N_PACKETS; ++i) {
+        nDecoded += decode(i);
+      }
+    }
+    time::steady_clock::TimePoint t2 = time::steady_clock::now();
+
+    BOOST_CHECK_EQUAL(nDecoded, N_PACKETS * N_ROUNDS);
+    double seconds = time::duration_cast<time::microseconds>(t2 - t1).count() / 1e6;
+    BOOST_TEST_MESSAGE(label << ": " << static_cast<uint64_t>(nDecoded / seconds) << " packets/s");
+  }
+
+protected:
+  static const size_t N_PACKETS = 100000;
+  static const size_t N_ROUNDS = 10;
+
+  std::vector<Block> netPackets;
+  std::vector<Block> lpPackets;
+};
+
+const size_t BlockDecodeBenchmarkFixture::N_PACKETS;
+const size_t BlockDecodeBenchmarkFixture::N_ROUNDS;
+
+BOOST_FIXTURE_TEST_CASE(Decode, BlockDecodeBenchmarkFixture)
+{
+  // as done by a face: decode LpPacket, then the Interest or Data in its fragment
+  run("LpPacket + Interest/Data", [this] (size_t i) {
+    Block wire(lpPackets[i].getBuffer());
+    lp::Packet lpPacket(wire);
+    Buffer::const_iterator first, last;
+    std::tie(first, last) = lpPacket.get<lp::FragmentField>();
+    Block netPkt(wire, first, last);
+    if (netPkt.type() == tlv::Interest) {
+      Interest interest(netPkt);
+      return interest.getName().size() == 5;
+    }
+    Data data(netPkt);
+    return data.getName().size() == 5;
+  });
+}
+
+BOOST_FIXTURE_TEST_CASE(FindName, BlockDecodeBenchmarkFixture)
+{
+  run("parse + get", [this] (size_t i) {
+    Block netPkt(netPackets[i].getBuffer());
+    netPkt.parse();
+    return netPkt.get(tlv::Name).value_size() > 0;
+  });
+
+  run("lazy_elements", [this] (size_t i) {
+    Block netPkt(netPackets[i].getBuffer());
+    for (const Block::LazyElement& element : netPkt.lazy_elements()) {
+      if (element.type() == tlv::Name) {
+        return element.value_size() > 0;
+      }
+    }
+    return false;
+  });
+}
+
+BOOST_FIXTURE_TEST_CASE(ParseName, BlockDecodeBenchmarkFixture)
+{
+  run("Name::wireDecode", [this] (size_t i) {
+    Block netPkt(netPackets[i].getBuffer());
+    Name name(netPkt.lazy_elements().begin()->block());
+    return name.size() == 5;
+  });
+}
+
+} // namespace tests
+} // namespace ndn
@@ -306,6 +306,10 @@ BOOST_FIXTURE_TEST_CASE(Encode, TestDataFixture)
   BOOST_REQUIRE_EQUAL_COLLECTIONS(Data1, Data1+sizeof(Data1),
                                   dataBlock.begin(), dataBlock.end());
 
+  // Content and SignatureValue refer to the wire encoding
+  BOOST_CHECK(d.getContent().getBuffer() == dataBlock.getBuffer());
+  BOOST_CHECK(d.getSignature().getValue().getBuffer() == dataBlock.getBuffer());
+
   std::ostringstream strStream;
   BOOST_CHECK_NO_THROW(strStream << d);
 
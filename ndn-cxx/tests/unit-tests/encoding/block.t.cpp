@@ -421,6 +421,84 @@ BOOST_AUTO_TEST_CASE(Equality)
   BOOST_CHECK_EQUAL(e != f, true);
 }
 
+BOOST_AUTO_TEST_CASE(Parse)
+{
+  static const uint8_t BUFFER[] = {
+    0x07, 0x0b, // Name
+      0x08, 0x01, 0x41, // NameComponent
+      0x08, 0x02, 0x42, 0x43, // NameComponent
+      0x08, 0x00, // NameComponent
+      0x80, 0x00 // unrecognized
+  };
+
+  Block block(BUFFER, sizeof(BUFFER));
+  block.parse();
+  BOOST_REQUIRE_EQUAL(block.elements_size(), 4);
+  BOOST_CHECK_EQUAL(block.elements()[1].type(), tlv::NameComponent);
+  BOOST_CHECK_EQUAL(block.elements()[1].value_size(), 2);
+  BOOST_CHECK(block.elements()[1].getBuffer() == block.getBuffer());
+  BOOST_CHECK_EQUAL(block.elements()[2].value_size(), 0);
+  BOOST_CHECK_EQUAL(block.elements()[3].type(), 0x80U);
+
+  static const uint8_t MALFORMED[] = {
+    0x07, 0x06,
+      0x08, 0x01, 0x41,
+      0x08, 0x05, 0x42 // exceeds parent
+  };
+  Block malformed(MALFORMED, sizeof(MALFORMED));
+  BOOST_CHECK_THROW(malformed.parse(), tlv::Error);
+  BOOST_CHECK_EQUAL(malformed.elements_size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(LazyElements)
+{
+  static const uint8_t BUFFER[] = {
+    0x05, 0x0d, // Interest
+      0x07, 0x03, // Name
+        0x08, 0x01, 0x41, // NameComponent
+      0x0a, 0x04, 0x01, 0x02, 0x03, 0x04, // Nonce
+      0x0c, 0x00 // InterestLifetime
+  };
+
+  Block block(BUFFER, sizeof(BUFFER));
+  std::vector<uint32_t> types;
+  for (const Block::LazyElement& element : block.lazy_elements()) {
+    types.push_back(element.type());
+  }
+  std::vector<uint32_t> expectedTypes{tlv::Name, tlv::Nonce, tlv::InterestLifetime};
+  BOOST_CHECK_EQUAL_COLLECTIONS(types.begin(), types.end(),
+                                expectedTypes.begin(), expectedTypes.end());
+  BOOST_CHECK_EQUAL(block.elements_size(), 0); // not parsed
+
+  auto it = block.lazy_elements().begin();
+  ++it;
+  BOOST_CHECK_EQUAL(it->type(), tlv::Nonce);
+  BOOST_CHECK_EQUAL(it->value_size(), 4);
+  BOOST_CHECK_EQUAL(it->end() - it->begin(), 6);
+  Block nonce = it->block();
+  BOOST_CHECK_EQUAL(nonce.type(), tlv::Nonce);
+  BOOST_CHECK(nonce.getBuffer() == block.getBuffer());
+  BOOST_CHECK_EQUAL_COLLECTIONS(nonce.value_begin(), nonce.value_end(),
+                                BUFFER + 9, BUFFER + 13);
+  BOOST_CHECK(++(++it) == block.lazy_elements().end());
+
+  Block name = block.lazy_elements().begin()->block();
+  BOOST_CHECK_EQUAL(std::distance(name.lazy_elements().begin(), name.lazy_elements().end()), 1);
+
+  Block empty(tlv::Name);
+  BOOST_CHECK(empty.lazy_elements().begin() == empty.lazy_elements().end());
+
+  static const uint8_t MALFORMED[] = {
+    0x07, 0x06,
+      0x08, 0x01, 0x41,
+      0x08, 0x05, 0x42 // exceeds parent
+  };
+  Block malformed(MALFORMED, sizeof(MALFORMED));
+  auto malformedIt = malformed.lazy_elements().begin();
+  BOOST_CHECK_EQUAL(malformedIt->type(), tlv::NameComponent);
+  BOOST_CHECK_THROW(++malformedIt, tlv::Error);
+}
+
 BOOST_AUTO_TEST_CASE(InsertBeginning)
 {
   Block masterBlock(tlv::Name);
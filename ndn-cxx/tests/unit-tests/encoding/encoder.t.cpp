@@ -20,6 +20,8 @@
  */
 
 #include "encoding/encoder.hpp"
+#include "encoding/encoding-buffer.hpp"
+#include "encoding/block-helpers.hpp"
 
 #include "boost-test.hpp"
 
@@ -164,6 +166,64 @@ BOOST_AUTO_TEST_CASE(Reserve)
   BOOST_CHECK_GT(e.capacity(), 2000);
 }
 
+BOOST_AUTO_TEST_CASE(Clear)
+{
+  Encoder e(100, 0);
+  e.prependByteArray(reinterpret_cast<const uint8_t*>("abcd"), 4);
+  BOOST_CHECK_EQUAL(e.size(), 4);
+
+  e.clear();
+  BOOST_CHECK_EQUAL(e.size(), 0);
+  BOOST_CHECK_EQUAL(e.capacity(), 100);
+  BOOST_CHECK(e.end() == e.getBuffer()->end());
+
+  e.prependByte(1);
+  BOOST_CHECK_EQUAL(e.size(), 1);
+  BOOST_CHECK_EQUAL(*e.buf(), 1);
+}
+
+struct ArenaTestPacket;
+
+BOOST_AUTO_TEST_CASE(EncodeInArena)
+{
+  auto encodeString = [] (const std::string& value) {
+    return [value] (EncodingBuffer& encoder) {
+      prependStringBlock(encoder, 8, value);
+    };
+  };
+
+  Block block1 = encodeInArena<ArenaTestPacket>(encodeString("first"));
+  Block block2 = encodeInArena<ArenaTestPacket>(encodeString(std::string(5000, 'x')));
+  Block block3 = encodeInArena<ArenaTestPacket>(encodeString("third"));
+
+  // each Block has its own exactly sized buffer
+  BOOST_CHECK_EQUAL(readString(block1), "first");
+  BOOST_CHECK_EQUAL(block1.getBuffer()->size(), block1.size());
+  BOOST_CHECK_EQUAL(readString(block2), std::string(5000, 'x'));
+  BOOST_CHECK_EQUAL(block2.getBuffer()->size(), block2.size());
+  BOOST_CHECK_EQUAL(readString(block3), "third");
+  BOOST_CHECK_EQUAL(block3.getBuffer()->size(), block3.size());
+
+  // nested encoding of the same packet type
+  Block inner;
+  Block outer = encodeInArena<ArenaTestPacket>([&] (EncodingBuffer& encoder) {
+      inner = encodeInArena<ArenaTestPacket>(encodeString("inner"));
+      prependStringBlock(encoder, 8, "outer");
+    });
+  BOOST_CHECK_EQUAL(readString(inner), "inner");
+  BOOST_CHECK_EQUAL(readString(outer), "outer");
+
+  // arena is usable after an exception
+  BOOST_CHECK_THROW(encodeInArena<ArenaTestPacket>([] (EncodingBuffer& encoder) {
+                      prependStringBlock(encoder, 8, "partial");
+                      BOOST_THROW_EXCEPTION(tlv::Error("encoding failed"));
+                    }),
+                    tlv::Error);
+  Block block4 = encodeInArena<ArenaTestPacket>(encodeString("fourth"));
+  BOOST_CHECK_EQUAL(readString(block4), "fourth");
+  BOOST_CHECK_EQUAL(block4.size(), 8);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // EncodingEncoder
 
 } // namespace tests
@@ -0,0 +1,129 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "lp/geo-tag.hpp"
+#include "lp/packet.hpp"
+
+#include "boost-test.hpp"
+
+namespace ndn {
+namespace lp {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(LpGeoTag)
+
+BOOST_AUTO_TEST_CASE(Encode)
+{
+  GeoTag geoTag;
+  geoTag.setPosX(-1.5);
+  geoTag.setPosY(0);
+  geoTag.setPosZ(2.01);
+  geoTag.setSpeed(13.89);
+  geoTag.setHeading(-90);
+
+  Block wire;
+  BOOST_REQUIRE_NO_THROW(wire = geoTag.wireEncode());
+
+  static const uint8_t expectedBlock[] = {
+    0x55, 0x14,
+    0xff, 0xff, 0xff, 0x6a, // -150
+    0x00, 0x00, 0x00, 0x00, // 0
+    0x00, 0x00, 0x00, 0xc9, // 201
+    0x00, 0x00, 0x05, 0x6d, // 1389
+    0xff, 0xff, 0xdc, 0xd8  // -9000
+  };
+
+  BOOST_CHECK_EQUAL_COLLECTIONS(expectedBlock, expectedBlock + sizeof(expectedBlock),
+                                wire.begin(), wire.end());
+
+  GeoTag decoded(wire);
+  BOOST_CHECK_EQUAL(decoded.getPosX(), -1.5);
+  BOOST_CHECK_EQUAL(decoded.getPosY(), 0.0);
+  BOOST_CHECK_EQUAL(decoded.getPosZ(), 2.01);
+  BOOST_CHECK_EQUAL(decoded.getSpeed(), 13.89);
+  BOOST_CHECK_EQUAL(decoded.getHeading(), -90.0);
+}
+
+BOOST_AUTO_TEST_CASE(Setters)
+{
+  GeoTag geoTag;
+  Block first = geoTag.wireEncode();
+
+  geoTag.setPosX(10.004); // rounded to centimetres
+  BOOST_CHECK_EQUAL(geoTag.getPosX(), 10.0);
+
+  Block second = geoTag.wireEncode();
+  BOOST_CHECK(first != second);
+  BOOST_CHECK_EQUAL(GeoTag(second).getPosX(), 10.0);
+
+  BOOST_CHECK_THROW(geoTag.setPosY(1e8), GeoTag::Error);
+}
+
+BOOST_AUTO_TEST_CASE(DecodeInvalidLength)
+{
+  static const uint8_t inputBlock[] = {
+    0x55, 0x04, 0x00, 0x00, 0x00, 0x01
+  };
+
+  GeoTag geoTag;
+  Block wire(inputBlock, sizeof(inputBlock));
+  BOOST_CHECK_THROW(geoTag.wireDecode(wire), GeoTag::Error);
+}
+
+BOOST_AUTO_TEST_CASE(PatchInPlace)
+{
+  static const uint8_t interest[] = {
+    0x05, 0x0b, 0x07, 0x03, 0x08, 0x01, 0x41, 0x0a, 0x04, 0x01, 0x02, 0x03, 0x04
+  };
+
+  GeoTag geoTag;
+  geoTag.setPosX(1);
+  Packet packet(Block(interest, sizeof(interest)));
+  packet.set<GeoTagField>(geoTag);
+
+  Block wire = packet.wireEncode();
+  wire.parse();
+  Block::element_const_iterator it = wire.find(tlv::GeoTag);
+  BOOST_REQUIRE(it != wire.elements_end());
+
+  auto buffer = make_shared<Buffer>(wire.begin(), wire.end());
+  size_t offset = it->value_begin() - wire.begin();
+
+  geoTag.setPosX(-250.25);
+  geoTag.setHeading(45);
+  geoTag.wireEncodeValue(buffer->buf() + offset);
+
+  Packet patched(Block(buffer, buffer->begin(), buffer->end()));
+  BOOST_REQUIRE(patched.has<GeoTagField>());
+  BOOST_CHECK_EQUAL(patched.get<GeoTagField>().getPosX(), -250.25);
+  BOOST_CHECK_EQUAL(patched.get<GeoTagField>().getHeading(), 45.0);
+
+  packet.set<GeoTagField>(geoTag);
+  Block reencoded = packet.wireEncode();
+  BOOST_CHECK_EQUAL_COLLECTIONS(reencoded.begin(), reencoded.end(),
+                                buffer->begin(), buffer->end());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace lp
+} // namespace ndn
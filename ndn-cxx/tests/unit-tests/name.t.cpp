@@ -483,6 +483,32 @@ BOOST_AUTO_TEST_CASE(SubNameOutOfRangeIndexes)
   BOOST_CHECK_EQUAL("/first/second/last", name.getSubName(-10, 10));
 }
 
+BOOST_AUTO_TEST_CASE(CachedPrefixHashes)
+{
+  Name name("/A/B");
+  auto hashes = make_shared<Name::PrefixHashes>(Name::PrefixHashes{0, 1, 2});
+  name.setCachedPrefixHashes(hashes);
+
+  // copies and prefixes share the cache
+  BOOST_CHECK_EQUAL(Name(name).getCachedPrefixHashes(), hashes);
+  BOOST_CHECK_EQUAL(name.getPrefix(1).getCachedPrefixHashes(), hashes);
+  BOOST_CHECK(name.getSubName(1).getCachedPrefixHashes() == nullptr);
+
+  // appending keeps values of existing prefixes only
+  name.append("C");
+  BOOST_CHECK_EQUAL(name.getCachedPrefixHashes(), hashes);
+  Name prefix = name.getPrefix(1);
+  prefix.append("D");
+  BOOST_CHECK(prefix.getCachedPrefixHashes() == nullptr);
+
+  name.wireDecode(Name("/A/B").wireEncode());
+  BOOST_CHECK(name.getCachedPrefixHashes() == nullptr);
+
+  name.setCachedPrefixHashes(hashes);
+  name.clear();
+  BOOST_CHECK(name.getCachedPrefixHashes() == nullptr);
+}
+
 BOOST_AUTO_TEST_CASE(DeepCopy)
 {
   Name n1("/hello/world");
@@ -24,6 +24,7 @@
 #include "boost-test.hpp"
 #include "interest.hpp"
 #include "data.hpp"
+#include "lp/tags.hpp"
 
 #include <boost/mpl/vector.hpp>
 
@@ -80,6 +81,76 @@ BOOST_FIXTURE_TEST_CASE_TEMPLATE(Basic, T, Fixtures, T)
   BOOST_CHECK(this->template getTag<TestTag2>() == nullptr);
 }
 
+BOOST_FIXTURE_TEST_CASE_TEMPLATE(FixedSlot, T, Fixtures, T)
+{
+  BOOST_CHECK(this->template getTag<lp::IncomingFaceIdTag>() == nullptr);
+  BOOST_CHECK(this->template peekTag<lp::IncomingFaceIdTag>() == nullptr);
+
+  auto tag = make_shared<lp::IncomingFaceIdTag>(1);
+  this->setTag(tag);
+  this->setTag(make_shared<lp::NextHopFaceIdTag>(2));
+  this->setTag(make_shared<TestTag>());
+
+  BOOST_CHECK_EQUAL(this->template getTag<lp::IncomingFaceIdTag>(), tag);
+  BOOST_CHECK_EQUAL(this->template peekTag<lp::IncomingFaceIdTag>(), tag.get());
+  BOOST_CHECK_EQUAL(this->template peekTag<lp::NextHopFaceIdTag>()->get(), 2);
+  BOOST_CHECK(this->template peekTag<lp::CongestionMarkTag>() == nullptr);
+  BOOST_CHECK(this->template peekTag<TestTag>() != nullptr);
+
+  this->template removeTag<lp::IncomingFaceIdTag>();
+  BOOST_CHECK(this->template getTag<lp::IncomingFaceIdTag>() == nullptr);
+  BOOST_CHECK_EQUAL(this->template peekTag<lp::NextHopFaceIdTag>()->get(), 2);
+}
+
+BOOST_FIXTURE_TEST_CASE_TEMPLATE(Emplace, T, Fixtures, T)
+{
+  this->template emplaceTag<lp::IncomingFaceIdTag>(1);
+  this->template emplaceTag<lp::CachePolicyTag>(lp::CachePolicy().setPolicy(lp::CachePolicyType::NO_CACHE));
+  this->template emplaceTag<TestTag>();
+
+  BOOST_REQUIRE(this->template peekTag<lp::IncomingFaceIdTag>() != nullptr);
+  BOOST_CHECK_EQUAL(this->template peekTag<lp::IncomingFaceIdTag>()->get(), 1);
+  BOOST_CHECK(this->template peekTag<lp::CachePolicyTag>()->get().getPolicy() ==
+              lp::CachePolicyType::NO_CACHE);
+  BOOST_CHECK(this->template peekTag<TestTag>() != nullptr);
+
+  // an inline tag is moved onto the heap once, and stays there
+  shared_ptr<lp::IncomingFaceIdTag> tag = this->template getTag<lp::IncomingFaceIdTag>();
+  BOOST_REQUIRE(tag != nullptr);
+  BOOST_CHECK_EQUAL(tag->get(), 1);
+  BOOST_CHECK_EQUAL(this->template getTag<lp::IncomingFaceIdTag>(), tag);
+  BOOST_CHECK_EQUAL(this->template peekTag<lp::IncomingFaceIdTag>(), tag.get());
+
+  this->template emplaceTag<lp::IncomingFaceIdTag>(2);
+  BOOST_CHECK_EQUAL(this->template peekTag<lp::IncomingFaceIdTag>()->get(), 2);
+  BOOST_CHECK_EQUAL(tag->get(), 1);
+
+  this->template removeTag<lp::IncomingFaceIdTag>();
+  BOOST_CHECK(this->template peekTag<lp::IncomingFaceIdTag>() == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(Copy)
+{
+  Interest interest("/A");
+  auto shared = make_shared<lp::NextHopFaceIdTag>(2);
+  interest.emplaceTag<lp::IncomingFaceIdTag>(1);
+  interest.setTag(shared);
+  interest.setTag(make_shared<TestTag>());
+
+  Interest copy(interest);
+  interest.emplaceTag<lp::IncomingFaceIdTag>(3);
+  interest.removeTag<TestTag>();
+
+  BOOST_REQUIRE(copy.peekTag<lp::IncomingFaceIdTag>() != nullptr);
+  BOOST_CHECK_EQUAL(copy.peekTag<lp::IncomingFaceIdTag>()->get(), 1);
+  BOOST_CHECK_EQUAL(copy.getTag<lp::NextHopFaceIdTag>(), shared);
+  BOOST_CHECK(copy.peekTag<TestTag>() != nullptr);
+
+  copy = interest;
+  BOOST_CHECK_EQUAL(copy.peekTag<lp::IncomingFaceIdTag>()->get(), 3);
+  BOOST_CHECK(copy.peekTag<TestTag>() == nullptr);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace tests
@@ -235,6 +235,32 @@ BOOST_AUTO_TEST_CASE(CancelAllWithScopedEventId) // Bug 3691
   eid.cancel(); // should not crash
 }
 
+BOOST_AUTO_TEST_CASE(CancelOnOtherScheduler)
+{
+  Scheduler other(io);
+
+  size_t count = 0;
+  scheduler.scheduleEvent(time::milliseconds(10), [&] { ++count; });
+  EventId i = other.scheduleEvent(time::milliseconds(20), [&] {
+      BOOST_ERROR("This event should not have been fired");
+    });
+  other.scheduleEvent(time::milliseconds(30), [&] { ++count; });
+  scheduler.scheduleEvent(time::milliseconds(40), [&] { ++count; });
+
+  scheduler.cancelEvent(i);
+  BOOST_CHECK(!i);
+
+  advanceClocks(time::milliseconds(5), 10);
+  BOOST_CHECK_EQUAL(count, 3);
+
+  // pending lists of both schedulers are intact
+  other.scheduleEvent(time::milliseconds(10), [&] { ++count; });
+  scheduler.scheduleEvent(time::milliseconds(10), [&] { ++count; });
+  other.cancelAllEvents();
+  advanceClocks(time::milliseconds(5), 4);
+  BOOST_CHECK_EQUAL(count, 4);
+}
+
 BOOST_AUTO_TEST_SUITE(EventId)
 
 using scheduler::EventId;
@@ -0,0 +1,146 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-block-header-benchmark.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include "ns3/ndnSIM/model/ndn-block-header.hpp"
+
+#include <ndn-cxx/lp/packet.hpp>
+
+#include <boost/iostreams/concepts.hpp>
+#include <boost/iostreams/stream.hpp>
+
+namespace ns3 {
+
+/**
+ * Compares BlockHeader::Deserialize against the byte-at-a-time std::istream path that
+ * was used previously, for LpPackets carrying Data of several payload sizes.
+ *
+ *     ./waf --run ndn-block-header-benchmark --command-template="%s --iterations=100000"
+ */
+
+namespace io = boost::iostreams;
+
+class Ns3BufferIteratorSource : public io::source {
+public:
+  Ns3BufferIteratorSource(ns3::Buffer::Iterator& is)
+    : m_is(is)
+  {
+  }
+
+  std::streamsize
+  read(char* buf, std::streamsize nMaxRead)
+  {
+    std::streamsize i = 0;
+    for (; i < nMaxRead && !m_is.IsEnd(); ++i) {
+      buf[i] = m_is.ReadU8();
+    }
+    if (i == 0) {
+      return -1;
+    }
+    else {
+      return i;
+    }
+  }
+
+private:
+  ns3::Buffer::Iterator& m_is;
+};
+
+static ::ndn::Block
+deserializeFromStream(ns3::Buffer::Iterator start)
+{
+  io::stream<Ns3BufferIteratorSource> is(start);
+  return ::ndn::Block::fromStream(is);
+}
+
+static ns3::Buffer
+makeBuffer(size_t payloadSize)
+{
+  ndn::Data data("/benchmark/block-header");
+  data.setContent(std::make_shared< ::ndn::Buffer>(payloadSize));
+  ndn::StackHelper::getKeyChain().sign(data);
+
+  ndn::BlockHeader header(nfd::face::Transport::Packet(::ndn::lp::Packet(data.wireEncode()).wireEncode()));
+
+  ns3::Buffer buffer;
+  buffer.AddAtStart(header.GetSerializedSize());
+  header.Serialize(buffer.Begin());
+  return buffer;
+}
+
+template<typename F>
+static double
+timedRun(uint32_t nIterations, const F& f)
+{
+  auto t1 = ::ndn::time::steady_clock::now();
+  for (uint32_t i = 0; i < nIterations; ++i) {
+    f();
+  }
+  auto t2 = ::ndn::time::steady_clock::now();
+  return ::ndn::time::duration_cast<::ndn::time::nanoseconds>(t2 - t1).count() / 1e9;
+}
+
+int
+main(int argc, char* argv[])
+{
+  uint32_t nIterations = 100000;
+
+  CommandLine cmd;
+  cmd.AddValue("iterations", "Number of deserializations per packet size", nIterations);
+  cmd.Parse(argc, argv);
+
+  std::cout << "PayloadSize\tWireSize\tStream(pkt/s)\tDirect(pkt/s)\tSpeedup\n";
+
+  for (size_t payloadSize : {100, 1024, 8192}) {
+    ns3::Buffer buffer = makeBuffer(payloadSize);
+
+    size_t wireSize = 0;
+    double streamTime = timedRun(nIterations, [&] {
+        wireSize = deserializeFromStream(buffer.Begin()).size();
+      });
+
+    ndn::BlockHeader header;
+    double directTime = timedRun(nIterations, [&] {
+        header.Deserialize(buffer.Begin());
+      });
+
+    NS_ABORT_MSG_UNLESS(header.getBlock().size() == wireSize, "Deserialization paths disagree");
+
+    std::cout << payloadSize << "\t"
+              << wireSize << "\t"
+              << nIterations / streamTime << "\t"
+              << nIterations / directTime << "\t"
+              << streamTime / directTime << "\n";
+  }
+
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  return ns3::main(argc, argv);
+}
@@ -0,0 +1,102 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-fib-install-benchmark.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/point-to-point-layout-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include <chrono>
+
+namespace ns3 {
+
+/**
+ * Measures wall-clock time of GlobalRoutingHelper::CalculateRoutes on a grid where every
+ * node originates its own prefix, installing routes straight into FIB and through command
+ * Interests (NdnFibDirectInstall=false), and reports the time saved by the former.
+ *
+ *     ./waf --run ndn-fib-install-benchmark --command-template="%s --size=30"
+ */
+
+struct Result
+{
+  double totalSeconds;
+  ndn::FibHelper::InstallStats stats;
+};
+
+static Result
+run(uint32_t size, bool isDirect)
+{
+  Config::SetGlobal("NdnFibDirectInstall", BooleanValue(isDirect));
+
+  PointToPointHelper p2p;
+  PointToPointGridHelper grid(size, size, p2p);
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.InstallAll();
+
+  ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
+  ndnGlobalRoutingHelper.InstallAll();
+  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
+    ndnGlobalRoutingHelper.AddOrigin("/node/" + std::to_string((*node)->GetId()), *node);
+  }
+
+  ndn::FibHelper::ResetInstallStats();
+  auto t1 = std::chrono::steady_clock::now();
+  ndn::GlobalRoutingHelper::CalculateRoutes();
+  auto t2 = std::chrono::steady_clock::now();
+
+  Result result{std::chrono::duration<double>(t2 - t1).count(), ndn::FibHelper::GetInstallStats()};
+  Simulator::Destroy();
+  return result;
+}
+
+int
+main(int argc, char* argv[])
+{
+  uint32_t size = 20;
+
+  CommandLine cmd;
+  cmd.AddValue("size", "Side of the square grid", size);
+  cmd.Parse(argc, argv);
+
+  Result direct = run(size, true);
+  Result commands = run(size, false);
+
+  std::cout << "Path\tRoutes\tInstall(s)\tCalculateRoutes(s)\n"
+            << "direct\t" << direct.stats.nDirect << "\t" << direct.stats.directSeconds << "\t"
+            << direct.totalSeconds << "\n"
+            << "commands\t" << commands.stats.nCommands << "\t" << commands.stats.commandSeconds
+            << "\t" << commands.totalSeconds << "\n"
+            << "Saved " << commands.totalSeconds - direct.totalSeconds << " s ("
+            << commands.totalSeconds / direct.totalSeconds << "x)\n";
+
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  return ns3::main(argc, argv);
+}
@@ -0,0 +1,158 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-packet-trace-benchmark.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include "ns3/ndnSIM/NFD/daemon/fw/forwarder.hpp"
+
+#include <chrono>
+
+namespace ns3 {
+
+/**
+ * Measures how many packets per second of wall-clock time are forwarded along a chain of
+ * nodes, without any sinks on the packet trace sources of ndn::L3Protocol and with a no-op
+ * sink connected to all of them on every node.  When ndnSIM is configured with
+ * --disable-packet-traces, both runs measure the build with packet traces compiled out.
+ *
+ *     ./waf --run ndn-packet-trace-benchmark --command-template="%s --length=10 --duration=20"
+ */
+
+static void
+interestSink(const ndn::Interest&, const ndn::Face&)
+{
+}
+
+static void
+dataSink(const ndn::Data&, const ndn::Face&)
+{
+}
+
+static void
+nackSink(const ndn::lp::Nack&, const ndn::Face&)
+{
+}
+
+struct Result
+{
+  uint64_t nPackets;
+  double seconds;
+};
+
+static Result
+run(uint32_t length, double frequency, double duration, bool isSubscribed)
+{
+  PointToPointHelper p2p;
+  p2p.SetDeviceAttribute("DataRate", StringValue("1Gbps"));
+  p2p.SetChannelAttribute("Delay", StringValue("1ms"));
+
+  NodeContainer nodes;
+  nodes.Create(length);
+  for (uint32_t i = 0; i + 1 < length; i++) {
+    p2p.Install(nodes.Get(i), nodes.Get(i + 1));
+  }
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.InstallAll();
+
+  for (uint32_t i = 0; i + 1 < length; i++) {
+    ndn::FibHelper::AddRoute(nodes.Get(i), "/prefix", nodes.Get(i + 1), 1);
+  }
+
+  ndn::AppHelper consumerHelper("ns3::ndn::ConsumerCbr");
+  consumerHelper.SetPrefix("/prefix");
+  consumerHelper.SetAttribute("Frequency", DoubleValue(frequency));
+  consumerHelper.Install(nodes.Get(0));
+
+  ndn::AppHelper producerHelper("ns3::ndn::Producer");
+  producerHelper.SetPrefix("/prefix");
+  producerHelper.SetAttribute("PayloadSize", StringValue("1024"));
+  producerHelper.Install(nodes.Get(length - 1));
+
+  if (isSubscribed) {
+    for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
+      Ptr<ndn::L3Protocol> l3 = (*node)->GetObject<ndn::L3Protocol>();
+      l3->TraceConnectWithoutContext("InInterests", MakeCallback(&interestSink));
+      l3->TraceConnectWithoutContext("OutInterests", MakeCallback(&interestSink));
+      l3->TraceConnectWithoutContext("InData", MakeCallback(&dataSink));
+      l3->TraceConnectWithoutContext("OutData", MakeCallback(&dataSink));
+      l3->TraceConnectWithoutContext("InNack", MakeCallback(&nackSink));
+      l3->TraceConnectWithoutContext("OutNack", MakeCallback(&nackSink));
+    }
+  }
+
+  Simulator::Stop(Seconds(duration));
+
+  auto t1 = std::chrono::steady_clock::now();
+  Simulator::Run();
+  auto t2 = std::chrono::steady_clock::now();
+
+  Result result{0, std::chrono::duration<double>(t2 - t1).count()};
+  for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
+    const auto& counters = (*node)->GetObject<ndn::L3Protocol>()->getForwarder()->getCounters();
+    result.nPackets += counters.nInInterests + counters.nInData;
+  }
+
+  Simulator::Destroy();
+  return result;
+}
+
+int
+main(int argc, char* argv[])
+{
+  uint32_t length = 10;
+  double frequency = 10000;
+  double duration = 10;
+
+  CommandLine cmd;
+  cmd.AddValue("length", "Number of nodes in the chain", length);
+  cmd.AddValue("frequency", "Interests per second sent by the consumer", frequency);
+  cmd.AddValue("duration", "Simulated time, in seconds", duration);
+  cmd.Parse(argc, argv);
+
+#ifdef NDNSIM_DISABLE_PACKET_TRACES
+  const char* unsubscribed = "off";
+  const char* subscribed = "off";
+#else
+  const char* unsubscribed = "unsubscribed";
+  const char* subscribed = "subscribed";
+#endif // NDNSIM_DISABLE_PACKET_TRACES
+
+  std::cout << "Traces\tPackets\tTime(s)\tPackets/s\n";
+  for (bool isSubscribed : {false, true}) {
+    Result result = run(length, frequency, duration, isSubscribed);
+    std::cout << (isSubscribed ? subscribed : unsubscribed) << "\t" << result.nPackets << "\t"
+              << result.seconds << "\t" << result.nPackets / result.seconds << "\n";
+  }
+
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  return ns3::main(argc, argv);
+}
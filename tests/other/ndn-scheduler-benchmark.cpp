@@ -0,0 +1,188 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-scheduler-benchmark.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include <ndn-cxx/util/scheduler.hpp>
+
+#include <set>
+
+namespace ns3 {
+
+/**
+ * Measures events per second of ndn::Scheduler for schedule/cancel churn (the pattern of
+ * PIT unsatisfy and straggler timers) and for schedule/execute, and compares against the
+ * shared_ptr/std::multiset implementation that was used previously.
+ *
+ *     ./waf --run ndn-scheduler-benchmark --command-template="%s --events=1000000"
+ */
+
+class LegacyScheduler
+{
+public:
+  typedef std::shared_ptr<ns3::EventId> EventId;
+
+  ~LegacyScheduler()
+  {
+    for (const EventId& eventId : m_events) {
+      Simulator::Remove(*eventId);
+    }
+  }
+
+  EventId
+  scheduleEvent(const ::ndn::time::nanoseconds& after, const std::function<void()>& event)
+  {
+    EventId eventId = std::make_shared<ns3::EventId>();
+    std::weak_ptr<ns3::EventId> eventWeak = eventId;
+    std::function<void()> eventWithCleanup = [this, event, eventWeak] () {
+      event();
+      EventId eventId = eventWeak.lock();
+      if (eventId != nullptr) {
+        this->m_events.erase(eventId);
+      }
+    };
+
+    *eventId = Simulator::Schedule(NanoSeconds(after.count()), &LegacyScheduler::invoke,
+                                   eventWithCleanup);
+    m_events.insert(eventId);
+    return eventId;
+  }
+
+  void
+  cancelEvent(const EventId& eventId)
+  {
+    if (eventId != nullptr) {
+      Simulator::Remove(*eventId);
+      m_events.erase(eventId);
+    }
+  }
+
+private:
+  static void
+  invoke(std::function<void()> f)
+  {
+    f();
+  }
+
+private:
+  std::multiset<EventId> m_events;
+};
+
+/**
+ * Keeps nActive timers pending; each step cancels one of them and schedules a replacement,
+ * as happens when an Interest is satisfied and another one arrives.
+ */
+template<typename SchedulerT>
+static double
+runChurn(uint32_t nEvents, uint32_t nActive)
+{
+  SchedulerT scheduler;
+  std::vector<typename SchedulerT::EventId> eventIds;
+  uint64_t sink = 0;
+  for (uint32_t i = 0; i < nActive; ++i) {
+    eventIds.push_back(scheduler.scheduleEvent(::ndn::time::seconds(4), [&sink] { ++sink; }));
+  }
+
+  auto t1 = ::ndn::time::steady_clock::now();
+  for (uint32_t i = 0; i < nEvents; ++i) {
+    auto& eventId = eventIds[(i * 7919) % nActive];
+    scheduler.cancelEvent(eventId);
+    eventId = scheduler.scheduleEvent(::ndn::time::milliseconds(4000 + i % 1000),
+                                      [&sink, i] { sink += i; });
+  }
+  auto t2 = ::ndn::time::steady_clock::now();
+
+  for (auto& eventId : eventIds) {
+    scheduler.cancelEvent(eventId);
+  }
+  Simulator::Destroy();
+  return ::ndn::time::duration_cast<::ndn::time::nanoseconds>(t2 - t1).count() / 1e9;
+}
+
+/**
+ * Schedules nEvents events and runs the simulator until all have been executed.
+ */
+template<typename SchedulerT>
+static double
+runExecute(uint32_t nEvents)
+{
+  uint64_t nExecuted = 0;
+  double elapsed = 0;
+  {
+    SchedulerT scheduler;
+    auto t1 = ::ndn::time::steady_clock::now();
+    for (uint32_t i = 0; i < nEvents; ++i) {
+      scheduler.scheduleEvent(::ndn::time::microseconds(i % 10000), [&nExecuted] { ++nExecuted; });
+    }
+    Simulator::Run();
+    auto t2 = ::ndn::time::steady_clock::now();
+    elapsed = ::ndn::time::duration_cast<::ndn::time::nanoseconds>(t2 - t1).count() / 1e9;
+  }
+  Simulator::Destroy();
+
+  NS_ABORT_MSG_UNLESS(nExecuted == nEvents, "Not all events have been executed");
+  return elapsed;
+}
+
+class PooledScheduler : public ::ndn::util::scheduler::Scheduler
+{
+public:
+  typedef ::ndn::util::scheduler::EventId EventId;
+
+  PooledScheduler()
+    : Scheduler(*static_cast<boost::asio::io_service*>(nullptr))
+  {
+  }
+};
+
+int
+main(int argc, char* argv[])
+{
+  uint32_t nEvents = 1000000;
+  uint32_t nActive = 10000;
+
+  CommandLine cmd;
+  cmd.AddValue("events", "Number of schedule/cancel operations and executed events", nEvents);
+  cmd.AddValue("active", "Number of pending timers during churn", nActive);
+  cmd.Parse(argc, argv);
+
+  double legacyChurn = runChurn<LegacyScheduler>(nEvents, nActive);
+  double pooledChurn = runChurn<PooledScheduler>(nEvents, nActive);
+  double legacyExecute = runExecute<LegacyScheduler>(nEvents);
+  double pooledExecute = runExecute<PooledScheduler>(nEvents);
+
+  std::cout << "Test\tLegacy(ev/s)\tPooled(ev/s)\tSpeedup\n"
+            << "churn\t" << nEvents / legacyChurn << "\t" << nEvents / pooledChurn << "\t"
+            << legacyChurn / pooledChurn << "\n"
+            << "execute\t" << nEvents / legacyExecute << "\t" << nEvents / pooledExecute << "\t"
+            << legacyExecute / pooledExecute << "\n";
+
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  return ns3::main(argc, argv);
+}
@@ -0,0 +1,94 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2016  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "apps/ndn-producer.hpp"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_FIXTURE_TEST_SUITE(AppsNdnProducer, ScenarioHelperWithCleanupFixture)
+
+class DataLog
+{
+public:
+  void
+  transmitted(shared_ptr<const Data> data, Ptr<App> app, shared_ptr<Face> face)
+  {
+    times.push_back(Simulator::Now());
+    payloadSizes.push_back(data->getContent().value_size());
+    freshness.push_back(data->getFreshnessPeriod());
+  }
+
+public:
+  std::vector<Time> times;
+  std::vector<size_t> payloadSizes;
+  std::vector<::ndn::time::milliseconds> freshness;
+};
+
+static void
+reconfigure(Ptr<Application> producer)
+{
+  producer->SetAttribute("PayloadSize", UintegerValue(100));
+  producer->SetAttribute("Freshness", TimeValue(Seconds(2)));
+}
+
+BOOST_AUTO_TEST_CASE(AttributesAfterStart)
+{
+  createTopology({
+      {"1", "2"},
+    });
+
+  addRoutes({
+      {"1", "2", "/prefix", 1},
+    });
+
+  addApps({
+      {"1", "ns3::ndn::ConsumerCbr",
+          {{"Prefix", "/prefix"}, {"Frequency", "1"}},
+          "0s", "9.99s"},
+      {"2", "ns3::ndn::Producer",
+          {{"Prefix", "/prefix"}, {"PayloadSize", "1024"}},
+          "0s", "100s"}
+    });
+
+  Ptr<Application> producer = getNode("2")->GetApplication(0);
+  DataLog log;
+  producer->TraceConnectWithoutContext("TransmittedDatas",
+                                       MakeCallback(&DataLog::transmitted, &log));
+
+  // changes made while the producer runs apply to subsequent Data
+  Simulator::Schedule(Seconds(4.5), &reconfigure, producer);
+
+  Simulator::Stop(Seconds(20));
+  Simulator::Run();
+
+  BOOST_REQUIRE_EQUAL(log.times.size(), 10);
+  for (size_t i = 0; i < log.times.size(); ++i) {
+    bool isReconfigured = log.times[i] > Seconds(4.5);
+    BOOST_CHECK_EQUAL(log.payloadSizes[i], isReconfigured ? 100 : 1024);
+    BOOST_CHECK_EQUAL(log.freshness[i], ::ndn::time::milliseconds(isReconfigured ? 2000 : 0));
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END() // AppsNdnProducer
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,203 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2016  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "apps/ndn-request-generator.hpp"
+#include "utils/ndn-request-trace.hpp"
+
+#include <boost/filesystem.hpp>
+#include <fstream>
+#include <map>
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+const std::string TRACE_FILE =
+  (boost::filesystem::path(TEST_CONFIG_PATH) / "request-trace.bin").string();
+
+class RequestGeneratorFixture : public ScenarioHelperWithCleanupFixture
+{
+public:
+  RequestGeneratorFixture()
+  {
+    boost::filesystem::create_directories(TEST_CONFIG_PATH);
+  }
+
+  ~RequestGeneratorFixture()
+  {
+    boost::filesystem::remove(TRACE_FILE);
+  }
+};
+
+BOOST_FIXTURE_TEST_SUITE(AppsNdnRequestGenerator, RequestGeneratorFixture)
+
+static void
+writeTrace(const std::vector<std::pair<uint64_t, uint32_t>>& records)
+{
+  std::ofstream os(TRACE_FILE, std::ios::binary | std::ios::trunc);
+  RequestTrace::writeHeader(os);
+  for (const auto& record : records) {
+    RequestTrace::writeRecord(os, record.first, record.second);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(TraceFile)
+{
+  std::vector<std::pair<uint64_t, uint32_t>> records;
+  for (uint32_t i = 0; i < 10000; i++) {
+    records.push_back({1000000000000ULL + i * 12345ULL, i * 2654435761U});
+  }
+  writeTrace(records);
+
+  RequestTrace trace(TRACE_FILE);
+  BOOST_REQUIRE_EQUAL(trace.size(), records.size());
+  for (size_t i = 0; i < records.size(); i++) {
+    BOOST_CHECK_EQUAL(trace.get(i).timestamp, records[i].first);
+    BOOST_CHECK_EQUAL(trace.get(i).nameId, records[i].second);
+
+    if (i % 1000 == 0) {
+      trace.release(i);
+    }
+  }
+  // released records can still be read
+  BOOST_CHECK_EQUAL(trace.get(0).nameId, records[0].second);
+
+  BOOST_CHECK(RequestTrace::open(TRACE_FILE) == RequestTrace::open(TRACE_FILE));
+
+  {
+    std::ofstream os(TRACE_FILE, std::ios::binary | std::ios::app);
+    os.put(0);
+  }
+  BOOST_CHECK_THROW(RequestTrace trace2(TRACE_FILE), RequestTrace::Error);
+
+  {
+    std::ofstream os(TRACE_FILE, std::ios::binary | std::ios::trunc);
+    os << "NDNRATE1";
+  }
+  BOOST_CHECK_THROW(RequestTrace trace3(TRACE_FILE), RequestTrace::Error);
+
+  BOOST_CHECK_THROW(RequestTrace trace4("/nonexistent/trace.bin"), RequestTrace::Error);
+}
+
+class InterestLog
+{
+public:
+  void
+  transmitted(shared_ptr<const Interest> interest, Ptr<App> app, shared_ptr<Face> face)
+  {
+    times.push_back(Simulator::Now());
+    seqs.push_back(interest->getName().at(-1).toSequenceNumber());
+  }
+
+public:
+  std::vector<Time> times;
+  std::vector<uint64_t> seqs;
+};
+
+BOOST_AUTO_TEST_CASE(TraceReplay)
+{
+  writeTrace({{5000000000ULL, 7}, {5500000000ULL, 3}, {5500000000ULL, 3}, {6200000000ULL, 42}});
+
+  createTopology({
+      {"1", "2"},
+    });
+
+  addRoutes({
+      {"1", "2", "/prefix", 1},
+    });
+
+  addApps({
+      {"1", "ns3::ndn::ConsumerCbr",
+          {{"Prefix", "/prefix"},
+           {"RequestGenerator", std::string("ns3::ndn::TraceRequestGenerator[File=") +
+                                TRACE_FILE + "]"}},
+          "1s", "10s"},
+      {"2", "ns3::ndn::Producer",
+          {{"Prefix", "/prefix"}, {"PayloadSize", "100"}},
+          "0s", "10s"}
+    });
+
+  InterestLog log;
+  getNode("1")->GetApplication(0)->TraceConnectWithoutContext("TransmittedInterests",
+                                                              MakeCallback(&InterestLog::transmitted,
+                                                                           &log));
+
+  Simulator::Stop(Seconds(10));
+  Simulator::Run();
+
+  std::vector<uint64_t> expectedSeqs{7, 3, 3, 42};
+  BOOST_CHECK_EQUAL_COLLECTIONS(log.seqs.begin(), log.seqs.end(),
+                                expectedSeqs.begin(), expectedSeqs.end());
+
+  std::vector<Time> expectedTimes{Seconds(1), Seconds(1.5), Seconds(1.5), Seconds(2.2)};
+  BOOST_CHECK_EQUAL_COLLECTIONS(log.times.begin(), log.times.end(),
+                                expectedTimes.begin(), expectedTimes.end());
+}
+
+BOOST_AUTO_TEST_CASE(ShotNoise)
+{
+  Ptr<ShotNoiseRequestGenerator> generator = CreateObject<ShotNoiseRequestGenerator>();
+  generator->SetAttribute("ContentRate", DoubleValue(10.0));
+  generator->SetAttribute("Volume", StringValue("ns3::ConstantRandomVariable[Constant=5.0]"));
+  generator->SetAttribute("Lifetime", StringValue("ns3::ConstantRandomVariable[Constant=2.0]"));
+  generator->AssignStreams(1);
+
+  std::map<uint32_t, uint32_t> counts;
+  Time last = Seconds(0);
+  size_t nRequests = 0;
+  RequestGenerator::Request request;
+  while (generator->GetNextRequest(request) && request.time < Seconds(100)) {
+    BOOST_REQUIRE(request.time >= last);
+    last = request.time;
+    counts[request.seq]++;
+    nRequests++;
+  }
+
+  // ~10 contents per second with 5 requests each
+  BOOST_CHECK_GT(nRequests, 4000);
+  BOOST_CHECK_LT(nRequests, 6000);
+
+  // contents are numbered in order of appearance; all but the latest got all their requests
+  uint32_t nComplete = 0;
+  for (const auto& item : counts) {
+    BOOST_CHECK_LE(item.second, 5);
+    if (item.second == 5) {
+      nComplete++;
+    }
+  }
+  BOOST_CHECK_EQUAL(counts.begin()->first, 0);
+  BOOST_CHECK_GT(nComplete, counts.size() - 100);
+}
+
+BOOST_AUTO_TEST_CASE(ShotNoiseZeroVolume)
+{
+  Ptr<ShotNoiseRequestGenerator> generator = CreateObject<ShotNoiseRequestGenerator>();
+  generator->SetAttribute("Volume", StringValue("ns3::ConstantRandomVariable[Constant=0]"));
+
+  // must give up instead of adding contents forever
+  RequestGenerator::Request request;
+  BOOST_CHECK(!generator->GetNextRequest(request));
+  BOOST_CHECK(!generator->GetNextRequest(request));
+}
+
+BOOST_AUTO_TEST_SUITE_END() // AppsNdnRequestGenerator
+
+} // namespace ndn
+} // namespace ns3
@@ -18,6 +18,9 @@
  **/
 
 #include "helper/ndn-fib-helper.hpp"
+#include "model/ndn-l3-protocol.hpp"
+
+#include "ns3/ndnSIM/NFD/daemon/fw/forwarder.hpp"
 
 #include "../tests-common.hpp"
 
@@ -97,8 +100,60 @@ BOOST_AUTO_TEST_CASE(Helper4)
   FibHelper::AddRoute(getNode("1"), Name("/prefix"), getNode("2"), 10);
 }
 
+// static void
+// AddRoutes(Ptr<Node> node, const std::vector<Route>& routes);
+BOOST_AUTO_TEST_CASE(Bulk)
+{
+  FibHelper::ResetInstallStats();
+  FibHelper::AddRoutes(getNode("1"), {std::make_tuple(Name("/prefix"), getFace("1", "2"), 1),
+                                      std::make_tuple(Name("/other"), getFace("1", "2"), 2)});
+
+  BOOST_CHECK_EQUAL(FibHelper::GetInstallStats().nDirect, 2);
+  BOOST_CHECK_EQUAL(FibHelper::GetInstallStats().nCommands, 0);
+}
+
+BOOST_AUTO_TEST_CASE(BulkViaCommands)
+{
+  Config::SetGlobal("NdnFibDirectInstall", BooleanValue(false));
+  FibHelper::ResetInstallStats();
+  FibHelper::AddRoutes(getNode("1"), {std::make_tuple(Name("/prefix"), getFace("1", "2"), 1)});
+  Config::SetGlobal("NdnFibDirectInstall", BooleanValue(true));
+
+  BOOST_CHECK_EQUAL(FibHelper::GetInstallStats().nDirect, 0);
+  BOOST_CHECK_EQUAL(FibHelper::GetInstallStats().nCommands, 1);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // AddRoute
 
+BOOST_FIXTURE_TEST_CASE(RemoveRoutes, ScenarioHelperWithCleanupFixture)
+{
+  createTopology({
+      {"1", "2"},
+      {"1", "3"}
+    });
+
+  auto& fib = getNode("1")->GetObject<L3Protocol>()->getForwarder()->getFib();
+
+  FibHelper::AddRoutes(getNode("1"), {std::make_tuple(Name("/a"), getFace("1", "2"), 1),
+                                      std::make_tuple(Name("/a"), getFace("1", "3"), 2),
+                                      std::make_tuple(Name("/b"), getFace("1", "2"), 3)});
+  BOOST_REQUIRE(fib.findExactMatch("/a") != nullptr);
+  BOOST_CHECK_EQUAL(fib.findExactMatch("/a")->getNextHops().size(), 2);
+  BOOST_REQUIRE(fib.findExactMatch("/b") != nullptr);
+  BOOST_CHECK_EQUAL(fib.findExactMatch("/b")->getNextHops().front().getCost(), 3);
+
+  // metric of an existing next hop is updated
+  FibHelper::AddRoutes(getNode("1"), {std::make_tuple(Name("/b"), getFace("1", "2"), 4)});
+  BOOST_CHECK_EQUAL(fib.findExactMatch("/b")->getNextHops().size(), 1);
+  BOOST_CHECK_EQUAL(fib.findExactMatch("/b")->getNextHops().front().getCost(), 4);
+
+  FibHelper::RemoveRoutes(getNode("1"), {std::make_tuple(Name("/a"), getFace("1", "2"), 0),
+                                         std::make_tuple(Name("/b"), getFace("1", "2"), 0)});
+  BOOST_REQUIRE(fib.findExactMatch("/a") != nullptr);
+  BOOST_CHECK_EQUAL(fib.findExactMatch("/a")->getNextHops().size(), 1);
+  BOOST_CHECK(fib.findExactMatch("/b") == nullptr);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // HelperNdnFibHelper
 
 } // namespace ndn
@@ -18,6 +18,8 @@
  **/
 
 #include "helper/ndn-global-routing-helper.hpp"
+#include "helper/ndn-global-routing-engine.hpp"
+#include "helper/ndn-link-control-helper.hpp"
 
 #include "model/ndn-global-router.hpp"
 #include "model/ndn-l3-protocol.hpp"
@@ -147,6 +149,153 @@ BOOST_AUTO_TEST_CASE(CalculateRouteCase2)
   }
 }
 
+BOOST_AUTO_TEST_CASE(RecalculateRoutesAfterLinkFailure)
+{
+  ofstream file1(TEST_TOPO_TXT.string().c_str());
+  file1 << "router\n\n"
+        << "#node city  y x mpi-partition\n"
+        << "A3  NA  1 1 1\n"
+        << "B3  NA  80  -40 1\n"
+        << "C3  NA  80  40  1\n\n"
+        << "link\n\n"
+        << "# from  to  capacity  metric  delay queue\n"
+        << "A3      B3  10Mbps    1 1ms 100\n"
+        << "A3      C3  10Mbps    10  1ms 100\n"
+        << "B3      C3  10Mbps    1 1ms 100\n";
+  file1.close();
+
+  AnnotatedTopologyReader topologyReader("");
+  topologyReader.SetFileName(TEST_TOPO_TXT.string().c_str());
+  topologyReader.Read();
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.InstallAll();
+
+  topologyReader.ApplyOspfMetric();
+
+  ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
+  ndnGlobalRoutingHelper.InstallAll();
+
+  ndnGlobalRoutingHelper.AddOrigins("/prefix", Names::Find<Node>("C3"));
+  ndn::GlobalRoutingHelper::CalculateRoutes();
+  BOOST_CHECK_EQUAL(GlobalRoutingEngine::Get().GetNRecomputed(), 3);
+
+  auto getNextHops = [] {
+    auto ndn = Names::Find<Node>("A3")->GetObject<ndn::L3Protocol>();
+    std::vector<std::pair<std::string, uint64_t>> nextHops;
+    nfd::fib::Entry* entry = ndn->getForwarder()->getFib().findExactMatch("/prefix");
+    if (entry == nullptr)
+      return nextHops;
+
+    for (const auto& nextHop : entry->getNextHops()) {
+      auto transport = dynamic_cast<NetDeviceTransport*>(nextHop.getFace().getTransport());
+      BOOST_REQUIRE(transport != nullptr);
+      nextHops.emplace_back(Names::FindName(transport->GetNetDevice()->GetChannel()->GetDevice(1)->GetNode()),
+                            nextHop.getCost());
+    }
+    return nextHops;
+  };
+
+  auto nextHops = getNextHops();
+  BOOST_REQUIRE_EQUAL(nextHops.size(), 1);
+  BOOST_CHECK_EQUAL(nextHops[0].first, "B3");
+  BOOST_CHECK_EQUAL(nextHops[0].second, 2);
+
+  // routes only change when explicitly recalculated
+  LinkControlHelper::FailLinkByName("A3", "B3");
+  BOOST_CHECK_EQUAL(getNextHops().size(), 1);
+
+  // only A3 routes through the failed link
+  ndn::GlobalRoutingHelper::RecalculateRoutes();
+  BOOST_CHECK_EQUAL(GlobalRoutingEngine::Get().GetNRecomputed(), 1);
+
+  nextHops = getNextHops();
+  BOOST_REQUIRE_EQUAL(nextHops.size(), 1);
+  BOOST_CHECK_EQUAL(nextHops[0].first, "C3");
+  BOOST_CHECK_EQUAL(nextHops[0].second, 10);
+
+  LinkControlHelper::UpLinkByName("A3", "B3");
+  ndn::GlobalRoutingHelper::RecalculateRoutes();
+  BOOST_CHECK_EQUAL(GlobalRoutingEngine::Get().GetNRecomputed(), 1);
+
+  nextHops = getNextHops();
+  BOOST_REQUIRE_EQUAL(nextHops.size(), 1);
+  BOOST_CHECK_EQUAL(nextHops[0].first, "B3");
+  BOOST_CHECK_EQUAL(nextHops[0].second, 2);
+}
+
+BOOST_AUTO_TEST_CASE(CalculateAllPossibleRoutes)
+{
+  ofstream file1(TEST_TOPO_TXT.string().c_str());
+  file1 << "router\n\n"
+        << "#node city  y x mpi-partition\n"
+        << "A4  NA  1 1 1\n"
+        << "B4  NA  80  -40 1\n"
+        << "C4  NA  80  40  1\n"
+        << "D4  NA  1  80  1\n\n"
+        << "link\n\n"
+        << "# from  to  capacity  metric  delay queue\n"
+        << "A4      B4  10Mbps    1 1ms 100\n"
+        << "B4      C4  10Mbps    1 1ms 100\n"
+        << "A4      D4  10Mbps    1 1ms 100\n"
+        << "D4      C4  10Mbps    5 1ms 100\n";
+  file1.close();
+
+  AnnotatedTopologyReader topologyReader("");
+  topologyReader.SetFileName(TEST_TOPO_TXT.string().c_str());
+  topologyReader.Read();
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.InstallAll();
+
+  topologyReader.ApplyOspfMetric();
+
+  ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
+  ndnGlobalRoutingHelper.InstallAll();
+  ndnGlobalRoutingHelper.AddOrigins("/prefix", Names::Find<Node>("C4"));
+
+  auto getNextHops = [] (const std::string& nodeName) {
+    Ptr<Node> node = Names::Find<Node>(nodeName);
+    std::map<std::string, uint64_t> nextHops;
+    nfd::fib::Entry* entry = node->GetObject<ndn::L3Protocol>()->getForwarder()->getFib().findExactMatch("/prefix");
+    if (entry == nullptr)
+      return nextHops;
+
+    for (const auto& nextHop : entry->getNextHops()) {
+      auto transport = dynamic_cast<NetDeviceTransport*>(nextHop.getFace().getTransport());
+      BOOST_REQUIRE(transport != nullptr);
+      Ptr<Channel> channel = transport->GetNetDevice()->GetChannel();
+      Ptr<Node> other = channel->GetDevice(0)->GetNode();
+      if (other == node)
+        other = channel->GetDevice(1)->GetNode();
+      nextHops[Names::FindName(other)] = nextHop.getCost();
+    }
+    return nextHops;
+  };
+
+  ndn::GlobalRoutingHelper::CalculateAllPossibleRoutes();
+
+  // the shortest path of A4 runs through B4, so B4's route via A4 has to detour over D4
+  auto nextHops = getNextHops("B4");
+  BOOST_CHECK_EQUAL(nextHops.size(), 2);
+  BOOST_CHECK_EQUAL(nextHops["C4"], 1);
+  BOOST_CHECK_EQUAL(nextHops["A4"], 7);
+
+  nextHops = getNextHops("A4");
+  BOOST_CHECK_EQUAL(nextHops.size(), 2);
+  BOOST_CHECK_EQUAL(nextHops["B4"], 2);
+  BOOST_CHECK_EQUAL(nextHops["D4"], 6);
+
+  // only the cheapest face; the other route is removed
+  Config::SetGlobal("NdnGlobalRoutingMaxPaths", UintegerValue(1));
+  ndn::GlobalRoutingHelper::CalculateAllPossibleRoutes();
+  Config::SetGlobal("NdnGlobalRoutingMaxPaths", UintegerValue(0));
+
+  nextHops = getNextHops("A4");
+  BOOST_CHECK_EQUAL(nextHops.size(), 1);
+  BOOST_CHECK_EQUAL(nextHops["B4"], 2);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace ndn
@@ -155,6 +155,63 @@ BOOST_AUTO_TEST_CASE(PrintLpPacket)
   }
 }
 
+BOOST_AUTO_TEST_CASE(DeserializeRoundTrip)
+{
+  // payload sizes chosen to exercise 1-, 3-, and 5-octet TLV-LENGTH encodings
+  for (size_t payloadSize : {10, 1024, 8192, 70000}) {
+    Data data("/round/trip");
+    data.setContent(std::make_shared< ::ndn::Buffer>(payloadSize));
+    ndn::StackHelper::getKeyChain().sign(data);
+    lp::Packet lpPacket(data.wireEncode());
+    Block wire = lpPacket.wireEncode();
+
+    Ptr<Packet> packet = Create<Packet>();
+    packet->AddHeader(BlockHeader(nfd::face::Transport::Packet(Block(wire))));
+
+    BlockHeader header;
+    BOOST_CHECK_EQUAL(packet->RemoveHeader(header), wire.size());
+    BOOST_CHECK_EQUAL(packet->GetSize(), 0);
+    BOOST_CHECK_EQUAL(header.getBlock().type(), wire.type());
+    BOOST_CHECK_EQUAL(header.getBlock().value_size(), wire.value_size());
+    BOOST_CHECK_EQUAL_COLLECTIONS(header.getBlock().begin(), header.getBlock().end(),
+                                  wire.begin(), wire.end());
+
+    lp::Packet decoded(header.getBlock());
+    BOOST_CHECK_EQUAL(decoded.get<lp::FragmentField>().second -
+                      decoded.get<lp::FragmentField>().first,
+                      static_cast<ptrdiff_t>(data.wireEncode().size()));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(DeserializeTrailingBytes)
+{
+  Interest interest("/prefix");
+  interest.setNonce(10);
+  Block wire = lp::Packet(interest.wireEncode()).wireEncode();
+
+  Ptr<Packet> packet = Create<Packet>(16); // e.g., link-layer padding after the TLV element
+  packet->AddHeader(BlockHeader(nfd::face::Transport::Packet(Block(wire))));
+
+  BlockHeader header;
+  BOOST_CHECK_EQUAL(packet->RemoveHeader(header), wire.size());
+  BOOST_CHECK_EQUAL(packet->GetSize(), 16);
+  BOOST_CHECK(header.getBlock() == wire);
+}
+
+BOOST_AUTO_TEST_CASE(DeserializeTruncated)
+{
+  Interest interest("/prefix");
+  interest.setNonce(10);
+  Block wire = lp::Packet(interest.wireEncode()).wireEncode();
+
+  Ptr<Packet> packet = Create<Packet>(wire.wire(), wire.size() - 1);
+  BlockHeader header;
+  BOOST_CHECK_THROW(packet->RemoveHeader(header), ::ndn::tlv::Error);
+
+  packet = Create<Packet>(wire.wire(), 1);
+  BOOST_CHECK_THROW(packet->RemoveHeader(header), ::ndn::tlv::Error);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace ndn
@@ -149,6 +149,82 @@ BOOST_AUTO_TEST_CASE(DisabledForwarderStatusManager)
 
 BOOST_AUTO_TEST_SUITE_END() // ManagerCheck
 
+#ifndef NDNSIM_DISABLE_PACKET_TRACES
+
+class PacketCounter
+{
+public:
+  void
+  inInterest(const Interest&, const Face&)
+  {
+    ++nInInterests;
+  }
+
+  void
+  outInterest(const Interest&, const Face&)
+  {
+    ++nOutInterests;
+  }
+
+  void
+  inData(const Data&, const Face&)
+  {
+    ++nInData;
+  }
+
+public:
+  size_t nInInterests = 0;
+  size_t nOutInterests = 0;
+  size_t nInData = 0;
+};
+
+BOOST_AUTO_TEST_CASE(PacketTracesOnDemand)
+{
+  createTopology({
+      {"1", "2"},
+    });
+
+  addRoutes({
+      {"1", "2", "/prefix", 1},
+    });
+
+  addApps({
+      {"1", "ns3::ndn::ConsumerCbr",
+          {{"Prefix", "/prefix"}, {"Frequency", "10"}},
+          "0s", "10s"},
+      {"2", "ns3::ndn::Producer",
+          {{"Prefix", "/prefix"}, {"PayloadSize", "100"}},
+          "0s", "10s"}
+    });
+
+  // net device faces already exist, the app face is added when the consumer starts
+  Ptr<L3Protocol> l3 = getNode("1")->GetObject<L3Protocol>();
+  PacketCounter counter;
+  l3->TraceConnectWithoutContext("InInterests", MakeCallback(&PacketCounter::inInterest, &counter));
+  l3->TraceConnectWithoutContext("OutInterests", MakeCallback(&PacketCounter::outInterest, &counter));
+  l3->TraceConnectWithoutContext("InData", MakeCallback(&PacketCounter::inData, &counter));
+
+  Simulator::Stop(Seconds(1.08)); // Interests at 0s, 0.1s, ..., 1s and their Data
+  Simulator::Run();
+
+  BOOST_CHECK_EQUAL(counter.nInInterests, 11);
+  BOOST_CHECK_EQUAL(counter.nOutInterests, 11);
+  BOOST_CHECK_EQUAL(counter.nInData, 11);
+
+  l3->TraceDisconnectWithoutContext("InInterests", MakeCallback(&PacketCounter::inInterest, &counter));
+  l3->TraceDisconnectWithoutContext("OutInterests", MakeCallback(&PacketCounter::outInterest, &counter));
+  l3->TraceDisconnectWithoutContext("InData", MakeCallback(&PacketCounter::inData, &counter));
+
+  Simulator::Stop(Seconds(1.0));
+  Simulator::Run();
+
+  BOOST_CHECK_EQUAL(counter.nInInterests, 11);
+  BOOST_CHECK_EQUAL(counter.nOutInterests, 11);
+  BOOST_CHECK_EQUAL(counter.nInData, 11);
+}
+
+#endif // NDNSIM_DISABLE_PACKET_TRACES
+
 BOOST_AUTO_TEST_SUITE_END() // ModelNdnL3Protocol
 
 } // namespace ndn
@@ -0,0 +1,117 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "model/ndn-spatial-index.hpp"
+
+#include "ns3/constant-velocity-mobility-model.h"
+#include "ns3/node.h"
+
+#include "../tests-common.hpp"
+
+#include <algorithm>
+
+namespace ns3 {
+namespace ndn {
+
+class SpatialIndexFixture : public CleanupFixture
+{
+public:
+  Ptr<Node>
+  addNode(const Vector& position, const Vector& velocity = Vector(0, 0, 0))
+  {
+    Ptr<Node> node = CreateObject<Node>();
+    Ptr<ConstantVelocityMobilityModel> mobility = CreateObject<ConstantVelocityMobilityModel>();
+    mobility->SetPosition(position);
+    mobility->SetVelocity(velocity);
+    node->AggregateObject(mobility);
+    return node;
+  }
+
+  std::vector<uint32_t>
+  getSortedNeighbors(const Vector& center, double radius)
+  {
+    std::vector<uint32_t> nodeIds;
+    index.GetNeighbors(center, radius, nodeIds);
+    std::sort(nodeIds.begin(), nodeIds.end());
+    return nodeIds;
+  }
+
+public:
+  SpatialIndex& index = SpatialIndex::Get();
+};
+
+BOOST_FIXTURE_TEST_SUITE(ModelNdnSpatialIndex, SpatialIndexFixture)
+
+BOOST_AUTO_TEST_CASE(Static)
+{
+  index.SetCellSize(100);
+  Ptr<Node> a = addNode(Vector(0, 0, 0));
+  Ptr<Node> b = addNode(Vector(30, 40, 0));
+  Ptr<Node> c = addNode(Vector(-250, 10, 0));
+  Ptr<Node> d = addNode(Vector(1000, 1000, 0));
+  index.AddAll();
+  BOOST_CHECK_EQUAL(index.GetN(), 4);
+
+  BOOST_CHECK_EQUAL(index.GetDistance(a, b), 50);
+  BOOST_CHECK_EQUAL(index.GetProgress(b, Vector(0, 0, 0), Vector(60, 80, 0)), 50);
+
+  std::vector<uint32_t> expected = {a->GetId(), b->GetId()};
+  BOOST_CHECK(getSortedNeighbors(Vector(0, 0, 0), 50) == expected);
+
+  expected = {a->GetId(), b->GetId(), c->GetId()};
+  BOOST_CHECK(getSortedNeighbors(Vector(-100, 0, 0), 160) == expected);
+
+  expected = {b->GetId()};
+  BOOST_CHECK(index.GetNeighbors(a, 100) == expected);
+  BOOST_CHECK(index.GetNeighbors(d, 500).empty());
+}
+
+BOOST_AUTO_TEST_CASE(Moving)
+{
+  index.SetCellSize(50);
+  Ptr<Node> a = addNode(Vector(0, 0, 0));
+  Ptr<Node> b = addNode(Vector(10, 0, 0), Vector(20, 0, 0));
+  index.Add(a);
+  index.Add(b);
+
+  std::vector<std::vector<uint32_t>> results;
+  for (int t = 1; t <= 10; ++t) {
+    Simulator::Schedule(Seconds(t), [&] {
+        results.push_back(getSortedNeighbors(Vector(0, 0, 0), 100));
+      });
+  }
+  // course change: b reverses
+  Simulator::Schedule(Seconds(7.5), [&] {
+      b->GetObject<ConstantVelocityMobilityModel>()->SetVelocity(Vector(-20, 0, 0));
+    });
+  Simulator::Stop(Seconds(11));
+  Simulator::Run();
+
+  // b is at 30, 50, ..., 150 for t = 1..7, turns at 160, then 150, 130, 110 for t = 8..10
+  BOOST_REQUIRE_EQUAL(results.size(), 10);
+  for (size_t i = 0; i < results.size(); ++i) {
+    BOOST_CHECK_EQUAL(results[i].size(), i < 4 ? 2 : 1);
+  }
+  BOOST_CHECK_EQUAL(index.GetPosition(b).x, 90);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
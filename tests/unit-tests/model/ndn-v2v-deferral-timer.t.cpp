@@ -0,0 +1,166 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "model/ndn-v2v-deferral-timer.hpp"
+
+#include "ns3/double.h"
+#include "ns3/uinteger.h"
+
+#include <limits>
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_FIXTURE_TEST_SUITE(ModelNdnV2VDeferralTimer, CleanupFixture)
+
+static const Vector origin(0, 0, 0);
+
+BOOST_AUTO_TEST_CASE(Default)
+{
+  Ptr<V2VDeferralTimer> timer = V2VDeferralTimer::CreateDefault();
+  BOOST_CHECK(DynamicCast<V2VLinearDistanceTimer>(timer) != nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(LocalJitter)
+{
+  Ptr<V2VDeferralTimer> timer = CreateObject<V2VSectorTimer>();
+  timer->SetAttribute("LocalJitter", TimeValue(MilliSeconds(1)));
+
+  for (int i = 0; i < 100; ++i) {
+    Time delay = timer->GetWaitingTime(origin, Vector(10, 0, 0), true);
+    BOOST_CHECK_GE(delay, Seconds(0));
+    BOOST_CHECK_LE(delay, MilliSeconds(1));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(LinearDistance)
+{
+  Ptr<V2VDeferralTimer> timer = CreateObject<V2VLinearDistanceTimer>();
+  timer->SetAttribute("MaxDelay", TimeValue(MilliSeconds(10)));
+  timer->SetAttribute("MaxDistance", DoubleValue(100));
+
+  BOOST_CHECK_CLOSE(timer->GetWaitingTime(origin, origin, false).GetSeconds(), 0.010, 0.01);
+  BOOST_CHECK_CLOSE(timer->GetWaitingTime(origin, Vector(50, 0, 0), false).GetSeconds(), 0.005, 0.01);
+  BOOST_CHECK_CLOSE(timer->GetWaitingTime(origin, Vector(0, 75, 0), false).GetSeconds(), 0.0025, 0.01);
+
+  // beyond MaxDistance only the local jitter applies
+  Time delay = timer->GetWaitingTime(origin, Vector(200, 0, 0), false);
+  BOOST_CHECK_LE(delay, MilliSeconds(2));
+}
+
+BOOST_AUTO_TEST_CASE(Sector)
+{
+  Ptr<V2VDeferralTimer> timer = CreateObject<V2VSectorTimer>();
+  timer->SetAttribute("MaxDistance", DoubleValue(100));
+  timer->SetAttribute("NumSectors", UintegerValue(4));
+  timer->SetAttribute("SlotTime", TimeValue(MilliSeconds(1)));
+
+  for (int i = 0; i < 100; ++i) {
+    // outermost sector (and beyond) uses the first slot
+    Time outer = timer->GetWaitingTime(origin, Vector(90, 0, 0), false);
+    BOOST_CHECK_LE(outer, MilliSeconds(1));
+    BOOST_CHECK_LE(timer->GetWaitingTime(origin, Vector(500, 0, 0), false), MilliSeconds(1));
+
+    Time second = timer->GetWaitingTime(origin, Vector(60, 0, 0), false);
+    BOOST_CHECK_GE(second, MilliSeconds(1));
+    BOOST_CHECK_LE(second, MilliSeconds(2));
+
+    Time inner = timer->GetWaitingTime(origin, Vector(10, 0, 0), false);
+    BOOST_CHECK_GE(inner, MilliSeconds(3));
+    BOOST_CHECK_LE(inner, MilliSeconds(4));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(ContentionWindow)
+{
+  Ptr<V2VDeferralTimer> timer = CreateObject<V2VContentionWindowTimer>();
+  timer->SetAttribute("MaxDistance", DoubleValue(100));
+  timer->SetAttribute("CwMin", UintegerValue(2));
+  timer->SetAttribute("CwMax", UintegerValue(10));
+  timer->SetAttribute("SlotTime", TimeValue(MicroSeconds(100)));
+  timer->SetAttribute("Jitter", TimeValue(MicroSeconds(10)));
+
+  for (int i = 0; i < 100; ++i) {
+    BOOST_CHECK_LE(timer->GetWaitingTime(origin, Vector(100, 0, 0), false), MicroSeconds(210));
+    BOOST_CHECK_LE(timer->GetWaitingTime(origin, Vector(50, 0, 0), false), MicroSeconds(610));
+    BOOST_CHECK_LE(timer->GetWaitingTime(origin, origin, false), MicroSeconds(1010));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(MaxDistanceBoundary)
+{
+  Ptr<V2VDeferralTimer> sector = CreateObject<V2VSectorTimer>();
+  Ptr<V2VDeferralTimer> cw = CreateObject<V2VContentionWindowTimer>();
+  Ptr<V2VDeferralTimer> linear = CreateObject<V2VLinearDistanceTimer>();
+
+  // zero and negative distances would divide by zero
+  for (Ptr<V2VDeferralTimer> timer : {sector, cw, linear}) {
+    BOOST_CHECK(!timer->SetAttributeFailSafe("MaxDistance", DoubleValue(0)));
+    BOOST_CHECK(!timer->SetAttributeFailSafe("MaxDistance", DoubleValue(-1)));
+    BOOST_CHECK(timer->SetAttributeFailSafe("MaxDistance", DoubleValue(100)));
+  }
+
+  sector->SetAttribute("NumSectors", UintegerValue(4));
+  sector->SetAttribute("SlotTime", TimeValue(MilliSeconds(1)));
+  cw->SetAttribute("CwMin", UintegerValue(2));
+  cw->SetAttribute("CwMax", UintegerValue(10));
+  cw->SetAttribute("SlotTime", TimeValue(MicroSeconds(100)));
+  cw->SetAttribute("Jitter", TimeValue(MicroSeconds(10)));
+
+  for (int i = 0; i < 100; ++i) {
+    // exactly at MaxDistance and far beyond it, the first slot / smallest window applies
+    for (const Vector& pos : {Vector(100, 0, 0), Vector(1e12, 0, 0), Vector(1e300, 0, 0)}) {
+      Time delay = sector->GetWaitingTime(origin, pos, false);
+      BOOST_CHECK_GE(delay, Seconds(0));
+      BOOST_CHECK_LE(delay, MilliSeconds(1));
+
+      delay = cw->GetWaitingTime(origin, pos, false);
+      BOOST_CHECK_GE(delay, Seconds(0));
+      BOOST_CHECK_LE(delay, MicroSeconds(210));
+    }
+  }
+
+  // smallest accepted MaxDistance puts every forwarder in the outermost sector
+  sector->SetAttribute("MaxDistance", DoubleValue(std::numeric_limits<double>::min()));
+  cw->SetAttribute("MaxDistance", DoubleValue(std::numeric_limits<double>::min()));
+  for (int i = 0; i < 100; ++i) {
+    BOOST_CHECK_LE(sector->GetWaitingTime(origin, Vector(1, 0, 0), false), MilliSeconds(1));
+    BOOST_CHECK_LE(cw->GetWaitingTime(origin, Vector(1, 0, 0), false), MicroSeconds(210));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(AssignStreams)
+{
+  Ptr<V2VDeferralTimer> a = CreateObject<V2VContentionWindowTimer>();
+  Ptr<V2VDeferralTimer> b = CreateObject<V2VContentionWindowTimer>();
+  BOOST_CHECK_EQUAL(a->AssignStreams(42), 1);
+  BOOST_CHECK_EQUAL(b->AssignStreams(42), 1);
+
+  for (int i = 0; i < 10; ++i) {
+    BOOST_CHECK_EQUAL(a->GetWaitingTime(origin, Vector(30, 0, 0), false),
+                      b->GetWaitingTime(origin, Vector(30, 0, 0), false));
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
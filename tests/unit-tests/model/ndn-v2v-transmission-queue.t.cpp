@@ -0,0 +1,135 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "model/ndn-v2v-transmission-queue.hpp"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_AUTO_TEST_SUITE(ModelNdnV2VTransmissionQueue)
+
+static V2VPendingTransmission
+makeItem(const Name& name, uint32_t type = ::ndn::tlv::Interest)
+{
+  V2VPendingTransmission item;
+  item.name = name;
+  item.type = type;
+  item.nTransmissions = 0;
+  item.isLocal = false;
+  return item;
+}
+
+BOOST_AUTO_TEST_CASE(Order)
+{
+  V2VTransmissionQueue queue;
+  BOOST_CHECK(queue.empty());
+
+  auto a = queue.enqueue(NanoSeconds(2000), makeItem("/a"));
+  auto b = queue.enqueue(NanoSeconds(1000), makeItem("/b"));
+  // same due time as /a, but within the same millisecond; must not be merged with /a
+  auto c = queue.enqueue(NanoSeconds(2000), makeItem("/c"));
+  auto d = queue.enqueue(NanoSeconds(2001), makeItem("/d"));
+  BOOST_CHECK_EQUAL(queue.size(), 4);
+
+  BOOST_CHECK_EQUAL(queue.front(), b);
+  BOOST_CHECK_EQUAL(queue.getNextDue(), NanoSeconds(1000));
+  queue.erase(b);
+
+  BOOST_CHECK_EQUAL(queue.front(), a);
+  BOOST_CHECK_EQUAL(queue.get(a).name, Name("/a"));
+  queue.reschedule(a, NanoSeconds(5000));
+
+  BOOST_CHECK_EQUAL(queue.front(), c); // ties are served in insertion order
+  queue.erase(c);
+  BOOST_CHECK_EQUAL(queue.front(), d);
+  queue.erase(d);
+
+  BOOST_CHECK_EQUAL(queue.front(), a);
+  BOOST_CHECK_EQUAL(queue.getNextDue(), NanoSeconds(5000));
+  queue.erase(a);
+  BOOST_CHECK(queue.empty());
+}
+
+BOOST_AUTO_TEST_CASE(Cancel)
+{
+  V2VTransmissionQueue queue;
+
+  queue.enqueue(MilliSeconds(1), makeItem("/a"));
+  queue.enqueue(MilliSeconds(2), makeItem("/a", ::ndn::tlv::Data));
+  queue.enqueue(MilliSeconds(3), makeItem("/a"));
+  auto b = queue.enqueue(MilliSeconds(4), makeItem("/b"));
+
+  BOOST_CHECK(queue.contains("/a", ::ndn::tlv::Interest));
+  BOOST_CHECK(!queue.contains("/b", ::ndn::tlv::Data));
+
+  BOOST_CHECK_EQUAL(queue.cancel("/a", ::ndn::tlv::Interest), 2);
+  BOOST_CHECK_EQUAL(queue.cancel("/a", ::ndn::tlv::Interest), 0);
+  BOOST_CHECK(!queue.contains("/a", ::ndn::tlv::Interest));
+  BOOST_CHECK_EQUAL(queue.size(), 2);
+  BOOST_CHECK_EQUAL(queue.getNextDue(), MilliSeconds(2));
+
+  BOOST_CHECK_EQUAL(queue.cancel("/a", ::ndn::tlv::Data), 1);
+  BOOST_CHECK_EQUAL(queue.front(), b);
+
+  queue.erase(b);
+  BOOST_CHECK(queue.empty());
+  BOOST_CHECK(!queue.contains("/b", ::ndn::tlv::Interest));
+}
+
+BOOST_AUTO_TEST_CASE(CancelFiltered)
+{
+  V2VTransmissionQueue queue;
+
+  V2VPendingTransmission near = makeItem("/a");
+  near.previousHop = Vector(10, 0, 0);
+  queue.enqueue(MilliSeconds(1), std::move(near));
+
+  V2VPendingTransmission far = makeItem("/a");
+  far.previousHop = Vector(100, 0, 0);
+  queue.enqueue(MilliSeconds(2), std::move(far));
+
+  BOOST_CHECK_EQUAL(queue.cancel("/a", ::ndn::tlv::Interest, [] (const V2VPendingTransmission& item) {
+        return item.previousHop.x > 50;
+      }), 1);
+  BOOST_CHECK_EQUAL(queue.size(), 1);
+  BOOST_CHECK_EQUAL(queue.get(queue.front()).previousHop.x, 10);
+}
+
+BOOST_AUTO_TEST_CASE(ManyReschedules)
+{
+  V2VTransmissionQueue queue;
+
+  auto a = queue.enqueue(Seconds(1), makeItem("/a"));
+  auto b = queue.enqueue(Seconds(2), makeItem("/b"));
+  for (int i = 0; i < 1000; ++i) {
+    queue.reschedule(a, Seconds(3) + NanoSeconds(i));
+  }
+
+  BOOST_CHECK_EQUAL(queue.size(), 2);
+  BOOST_CHECK_EQUAL(queue.front(), b);
+  queue.erase(b);
+  BOOST_CHECK_EQUAL(queue.getNextDue(), Seconds(3) + NanoSeconds(999));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,103 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2016  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/ndn-consumer-seq-table.hpp"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_AUTO_TEST_SUITE(UtilsNdnConsumerSeqTable)
+
+BOOST_AUTO_TEST_CASE(InsertFindErase)
+{
+  ConsumerSeqTable table;
+
+  // a sliding window of sequential numbers, plus numbers colliding in any ring size
+  for (uint32_t seq = 0; seq < 1000; seq++) {
+    ConsumerSeqTable::Record& record = table.insert(seq);
+    BOOST_CHECK_EQUAL(record.nSent, 0);
+    record.nSent = seq + 1;
+
+    ConsumerSeqTable::Record& collision = table.insert(seq << 16);
+    collision.nSent = 1;
+
+    if (seq >= 100) {
+      table.erase(seq - 100);
+    }
+  }
+  BOOST_CHECK_EQUAL(table.size(), 100 + 1000 - 1); // seq 0 << 16 is the same as seq 0
+
+  BOOST_CHECK(table.find(899) == nullptr);
+  for (uint32_t seq = 900; seq < 1000; seq++) {
+    ConsumerSeqTable::Record* record = table.find(seq);
+    BOOST_REQUIRE(record != nullptr);
+    BOOST_CHECK_EQUAL(record->seq, seq);
+    BOOST_CHECK_EQUAL(record->nSent, seq + 1);
+    BOOST_CHECK_EQUAL(table.insert(seq).nSent, seq + 1);
+  }
+  for (uint32_t seq = 100; seq < 1000; seq++) {
+    BOOST_CHECK(table.find(seq << 16) != nullptr);
+    table.erase(seq << 16);
+    BOOST_CHECK(table.find(seq << 16) == nullptr);
+  }
+  BOOST_CHECK_EQUAL(table.size(), 100 + 100 - 1);
+}
+
+BOOST_AUTO_TEST_CASE(Timeouts)
+{
+  ConsumerSeqTable table;
+  uint32_t seq = 0;
+
+  for (uint32_t i = 0; i < 5; i++) {
+    table.startTimeout(table.insert(i), Seconds(i));
+  }
+  // already pending, keeps counting from 0s
+  table.startTimeout(table.insert(0), Seconds(10));
+  BOOST_CHECK(table.hasTimeouts());
+
+  table.erase(1);
+
+  BOOST_CHECK(table.popExpiredTimeout(Seconds(2.5), Seconds(0.5), seq));
+  BOOST_CHECK_EQUAL(seq, 0);
+  BOOST_CHECK(table.popExpiredTimeout(Seconds(2.5), Seconds(0.5), seq));
+  BOOST_CHECK_EQUAL(seq, 2);
+  BOOST_CHECK(!table.popExpiredTimeout(Seconds(2.5), Seconds(0.5), seq));
+
+  // retransmitted after it expired
+  table.startTimeout(*table.find(2), Seconds(5));
+
+  BOOST_CHECK(table.popExpiredTimeout(Seconds(10), Seconds(1), seq));
+  BOOST_CHECK_EQUAL(seq, 3);
+  BOOST_CHECK(table.popExpiredTimeout(Seconds(10), Seconds(1), seq));
+  BOOST_CHECK_EQUAL(seq, 4);
+  BOOST_CHECK(table.popExpiredTimeout(Seconds(10), Seconds(1), seq));
+  BOOST_CHECK_EQUAL(seq, 2);
+  BOOST_CHECK(!table.popExpiredTimeout(Seconds(10), Seconds(1), seq));
+  BOOST_CHECK(!table.hasTimeouts());
+
+  // records stay until erased
+  BOOST_CHECK_EQUAL(table.size(), 4);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // UtilsNdnConsumerSeqTable
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,91 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/ndn-data-template.hpp"
+
+#include <ndn-cxx/encoding/block-helpers.hpp>
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_AUTO_TEST_SUITE(UtilsNdnDataTemplate)
+
+static shared_ptr<Data>
+makeReferenceData(const Name& name, size_t payloadSize, const ::ndn::time::milliseconds& freshness,
+                  uint32_t signatureValue, const Name& keyLocator)
+{
+  auto data = make_shared<Data>(name);
+  data->setFreshnessPeriod(freshness);
+  data->setContent(make_shared< ::ndn::Buffer>(payloadSize));
+
+  SignatureInfo signatureInfo(static_cast< ::ndn::tlv::SignatureTypeValue>(255));
+  if (keyLocator.size() > 0) {
+    signatureInfo.setKeyLocator(keyLocator);
+  }
+  Signature signature;
+  signature.setInfo(signatureInfo);
+  signature.setValue(::ndn::makeNonNegativeIntegerBlock(::ndn::tlv::SignatureValue, signatureValue));
+  data->setSignature(signature);
+
+  data->wireEncode();
+  return data;
+}
+
+BOOST_AUTO_TEST_CASE(SameAsEncoder)
+{
+  for (size_t payloadSize : {0, 10, 1024, 70000}) {
+    DataTemplate dataTemplate(payloadSize, ::ndn::time::milliseconds(1000), 7, Name());
+    shared_ptr<Data> data = dataTemplate.makeData("/prefix/A/%00%01");
+    shared_ptr<Data> expected = makeReferenceData("/prefix/A/%00%01", payloadSize,
+                                                  ::ndn::time::milliseconds(1000), 7, Name());
+
+    BOOST_CHECK_EQUAL(data->getName(), expected->getName());
+    BOOST_CHECK_EQUAL(data->getContent().value_size(), payloadSize);
+    BOOST_CHECK_EQUAL(data->getFreshnessPeriod(), ::ndn::time::milliseconds(1000));
+    BOOST_CHECK_EQUAL_COLLECTIONS(data->wireEncode().begin(), data->wireEncode().end(),
+                                  expected->wireEncode().begin(), expected->wireEncode().end());
+  }
+}
+
+BOOST_AUTO_TEST_CASE(KeyLocator)
+{
+  DataTemplate dataTemplate(100, ::ndn::time::milliseconds(0), 0, "/key");
+  shared_ptr<Data> data = dataTemplate.makeData("/a");
+  shared_ptr<Data> expected = makeReferenceData("/a", 100, ::ndn::time::milliseconds(0), 0, "/key");
+
+  BOOST_REQUIRE(data->getSignature().hasKeyLocator());
+  BOOST_CHECK_EQUAL(data->getSignature().getKeyLocator().getName(), Name("/key"));
+  BOOST_CHECK(data->wireEncode() == expected->wireEncode());
+}
+
+BOOST_AUTO_TEST_CASE(VirtualPayload)
+{
+  ::ndn::ConstBufferPtr a = DataTemplate::getVirtualPayload(1024);
+  BOOST_CHECK_EQUAL(a->size(), 1024);
+  BOOST_CHECK(std::all_of(a->begin(), a->end(), [] (uint8_t b) { return b == 0; }));
+  BOOST_CHECK_EQUAL(a, DataTemplate::getVirtualPayload(1024));
+  BOOST_CHECK_NE(a, DataTemplate::getVirtualPayload(100));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
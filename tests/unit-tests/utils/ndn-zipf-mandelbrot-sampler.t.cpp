@@ -0,0 +1,106 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/ndn-zipf-mandelbrot-sampler.hpp"
+
+#include <cmath>
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_AUTO_TEST_SUITE(UtilsNdnZipfMandelbrotSampler)
+
+// rank chosen by the original linear scan over the cumulative distribution
+static uint32_t
+linearScan(uint32_t n, double q, double s, double u)
+{
+  std::vector<double> cdf(n + 1);
+  cdf[0] = 0.0;
+  for (uint32_t i = 1; i <= n; i++) {
+    cdf[i] = cdf[i - 1] + 1.0 / std::pow(i + q, s);
+  }
+  for (uint32_t i = 1; i <= n; i++) {
+    cdf[i] = cdf[i] / cdf[n];
+  }
+
+  for (uint32_t i = 1; i <= n; i++) {
+    if (u <= cdf[i]) {
+      return i;
+    }
+  }
+  return 1;
+}
+
+BOOST_AUTO_TEST_CASE(CdfSameAsLinearScan)
+{
+  ZipfMandelbrotSampler sampler(1000, 0.7, 0.7, ZipfMandelbrotSampler::CDF);
+
+  for (uint32_t i = 1; i <= 10000; i++) {
+    double u = i / 10000.0;
+    BOOST_CHECK_EQUAL(sampler.sample(u), linearScan(1000, 0.7, 0.7, u));
+  }
+  BOOST_CHECK_EQUAL(sampler.sample(1.0), 1000);
+}
+
+BOOST_AUTO_TEST_CASE(AliasFollowsDistribution)
+{
+  const uint32_t n = 50;
+  const uint32_t nSamples = 200000;
+  ZipfMandelbrotSampler sampler(n, 5.0, 1.2, ZipfMandelbrotSampler::ALIAS);
+
+  double total = 0;
+  for (uint32_t rank = 1; rank <= n; rank++) {
+    total += sampler.getProbability(rank);
+  }
+  BOOST_CHECK_CLOSE(total, 1.0, 1e-9);
+
+  // a fine uniform grid instead of random variates keeps the test deterministic
+  std::vector<uint32_t> counts(n + 1);
+  for (uint32_t i = 1; i <= nSamples; i++) {
+    uint32_t rank = sampler.sample(static_cast<double>(i) / nSamples);
+    BOOST_REQUIRE(rank >= 1 && rank <= n);
+    counts[rank]++;
+  }
+
+  for (uint32_t rank = 1; rank <= n; rank++) {
+    BOOST_CHECK_SMALL(static_cast<double>(counts[rank]) / nSamples - sampler.getProbability(rank),
+                      0.001);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(Shared)
+{
+  auto a = ZipfMandelbrotSampler::get(100, 0.7, 0.7, ZipfMandelbrotSampler::CDF);
+  auto b = ZipfMandelbrotSampler::get(100, 0.7, 0.7, ZipfMandelbrotSampler::CDF);
+  auto c = ZipfMandelbrotSampler::get(100, 0.7, 0.7, ZipfMandelbrotSampler::ALIAS);
+  auto d = ZipfMandelbrotSampler::get(200, 0.7, 0.7, ZipfMandelbrotSampler::CDF);
+
+  BOOST_CHECK_EQUAL(a, b);
+  BOOST_CHECK_NE(a, c);
+  BOOST_CHECK_NE(a, d);
+  BOOST_CHECK_EQUAL(d->getN(), 200);
+  BOOST_CHECK_EQUAL(c->getMethod(), ZipfMandelbrotSampler::ALIAS);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -19,6 +19,9 @@
 
 #include "utils/tracers/ndn-l3-rate-tracer.hpp"
 
+#include <fstream>
+#include <iterator>
+
 #include <boost/filesystem.hpp>
 #include <boost/test/output_test_stream.hpp>
 
@@ -28,6 +31,17 @@ namespace ns3 {
 namespace ndn {
 
 const boost::filesystem::path TEST_TRACE = boost::filesystem::path(TEST_CONFIG_PATH) / "trace.txt";
+const boost::filesystem::path TEST_BINARY_TRACE =
+  boost::filesystem::path(TEST_CONFIG_PATH) / "trace.bin";
+const boost::filesystem::path TEST_CONVERTED_TRACE =
+  boost::filesystem::path(TEST_CONFIG_PATH) / "trace-converted.txt";
+
+static std::string
+readFile(const boost::filesystem::path& path)
+{
+  std::ifstream is(path.string().c_str(), std::ios_base::in | std::ios_base::binary);
+  return std::string(std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>());
+}
 
 class L3RateTracerFixture : public ScenarioHelperWithCleanupFixture
 {
@@ -55,6 +69,8 @@ public:
   ~L3RateTracerFixture()
   {
     boost::filesystem::remove(TEST_TRACE);
+    boost::filesystem::remove(TEST_BINARY_TRACE);
+    boost::filesystem::remove(TEST_CONVERTED_TRACE);
     L3RateTracer::Destroy(); // additional cleanup
   }
 };
@@ -119,6 +135,30 @@ BOOST_AUTO_TEST_CASE(NackTracing)
   BOOST_CHECK(os.match_pattern());
 }
 
+BOOST_AUTO_TEST_CASE(BinaryOutput)
+{
+  NodeContainer nodes;
+  nodes.Add(getNode("1"));
+
+  L3RateTracer::Install(nodes, TEST_TRACE.string(), Seconds(1));
+
+  Config::SetGlobal("NdnL3RateTracerFormat", StringValue("binary"));
+  L3RateTracer::Install(nodes, TEST_BINARY_TRACE.string(), Seconds(1));
+  Config::SetGlobal("NdnL3RateTracerFormat", StringValue("tsv"));
+
+  Simulator::Stop(Seconds(3.5));
+  Simulator::Run();
+
+  L3RateTracer::Destroy(); // to force logs to be written
+
+  BOOST_REQUIRE(L3RateTracer::ConvertToTsv(TEST_BINARY_TRACE.string(),
+                                           TEST_CONVERTED_TRACE.string()));
+
+  std::string expected = readFile(TEST_TRACE);
+  BOOST_CHECK_GT(expected.size(), 0);
+  BOOST_CHECK_EQUAL(readFile(TEST_CONVERTED_TRACE), expected);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace ndn
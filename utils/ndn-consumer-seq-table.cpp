@@ -0,0 +1,160 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2016  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-consumer-seq-table.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+static const size_t INITIAL_CAPACITY = 16;
+
+ConsumerSeqTable::ConsumerSeqTable()
+  : m_ring(INITIAL_CAPACITY)
+  , m_mask(INITIAL_CAPACITY - 1)
+  , m_size(0)
+  , m_nTimeouts(0)
+{
+}
+
+ConsumerSeqTable::Record*
+ConsumerSeqTable::find(uint32_t seq)
+{
+  Record& slot = m_ring[seq & m_mask];
+  if (slot.isUsed && slot.seq == seq) {
+    return &slot;
+  }
+
+  if (m_overflow.empty()) {
+    return nullptr;
+  }
+  auto it = m_overflow.find(seq);
+  return it != m_overflow.end() ? &it->second : nullptr;
+}
+
+ConsumerSeqTable::Record&
+ConsumerSeqTable::insert(uint32_t seq)
+{
+  Record* record = find(seq);
+  if (record != nullptr) {
+    return *record;
+  }
+
+  if (2 * (m_size + 1) > m_ring.size()) {
+    grow();
+  }
+
+  Record& newRecord = allocate(seq);
+  newRecord = Record();
+  newRecord.seq = seq;
+  newRecord.isUsed = true;
+  ++m_size;
+  return newRecord;
+}
+
+ConsumerSeqTable::Record&
+ConsumerSeqTable::allocate(uint32_t seq)
+{
+  Record& slot = m_ring[seq & m_mask];
+  if (!slot.isUsed) {
+    return slot;
+  }
+  return m_overflow[seq];
+}
+
+void
+ConsumerSeqTable::erase(uint32_t seq)
+{
+  Record* record = find(seq);
+  if (record == nullptr) {
+    return;
+  }
+
+  if (record->hasTimeout && --m_nTimeouts == 0) {
+    m_timeouts.clear(); // only stale entries are left
+  }
+  --m_size;
+
+  if (record == &m_ring[seq & m_mask]) {
+    record->isUsed = false;
+  }
+  else {
+    m_overflow.erase(seq);
+  }
+}
+
+void
+ConsumerSeqTable::grow()
+{
+  std::vector<Record> ring(2 * m_ring.size());
+  std::swap(m_ring, ring);
+  m_mask = m_ring.size() - 1;
+
+  std::unordered_map<uint32_t, Record> overflow;
+  std::swap(m_overflow, overflow);
+
+  for (const Record& record : ring) {
+    if (record.isUsed) {
+      allocate(record.seq) = record;
+    }
+  }
+  for (const auto& item : overflow) {
+    allocate(item.first) = item.second;
+  }
+}
+
+void
+ConsumerSeqTable::startTimeout(Record& record, Time now)
+{
+  if (record.hasTimeout) {
+    return;
+  }
+
+  record.hasTimeout = true;
+  record.timeoutBase = now;
+  ++m_nTimeouts;
+  m_timeouts.emplace_back(now, record.seq);
+}
+
+bool
+ConsumerSeqTable::popExpiredTimeout(Time now, Time rto, uint32_t& seq)
+{
+  while (!m_timeouts.empty()) {
+    const std::pair<Time, uint32_t>& entry = m_timeouts.front();
+
+    Record* record = find(entry.second);
+    if (record == nullptr || !record->hasTimeout || record->timeoutBase != entry.first) {
+      m_timeouts.pop_front(); // record erased or timeout restarted since
+      continue;
+    }
+
+    if (entry.first + rto > now) {
+      return false;
+    }
+
+    record->hasTimeout = false;
+    --m_nTimeouts;
+    seq = entry.second;
+    m_timeouts.pop_front();
+    return true;
+  }
+  return false;
+}
+
+} // namespace ndn
+} // namespace ns3
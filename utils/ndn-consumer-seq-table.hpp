@@ -0,0 +1,135 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2016  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDNSIM_UTILS_NDN_CONSUMER_SEQ_TABLE_HPP
+#define NDNSIM_UTILS_NDN_CONSUMER_SEQ_TABLE_HPP
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ns3/nstime.h"
+
+#include <deque>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-apps
+ * @brief Records of the Interests a Consumer is waiting Data for, and their retransmission
+ *        timeouts
+ *
+ * Records are kept in a ring indexed by sequence number modulo its capacity, which is a
+ * power of two and at least twice the number of records, so the outstanding sequence
+ * numbers of window- and rate-driven consumers never collide.  Records that do collide
+ * (e.g., with randomly drawn sequence numbers) are kept in an overflow hash table.
+ *
+ * Pending timeouts are kept in send time order.  As Interests are sent in time order and
+ * the same RTO applies to all of them, timeouts expire in the same order, so a FIFO queue is
+ * enough; entries of records erased or restarted in the meantime are skipped when they reach
+ * the front.
+ *
+ * Record references are invalidated by insert() and erase().
+ */
+class ConsumerSeqTable : boost::noncopyable
+{
+public:
+  struct Record
+  {
+    uint32_t seq;
+    uint32_t nSent;   ///< number of times the Interest was sent
+    Time firstSent;
+    Time lastSent;
+    Time timeoutBase; ///< time the pending timeout counts from
+    bool hasTimeout;  ///< whether a timeout is pending
+    bool isUsed;
+  };
+
+  ConsumerSeqTable();
+
+  /**
+   * @return record of @p seq, or nullptr if there is none
+   */
+  Record*
+  find(uint32_t seq);
+
+  /**
+   * @brief Get the record of @p seq, creating an empty one (nSent == 0) if there is none
+   */
+  Record&
+  insert(uint32_t seq);
+
+  /**
+   * @brief Erase the record of @p seq, if any, along with its pending timeout
+   */
+  void
+  erase(uint32_t seq);
+
+  size_t
+  size() const
+  {
+    return m_size;
+  }
+
+  /**
+   * @brief Start the timeout of @p record, counting from @p now, unless one is already pending
+   */
+  void
+  startTimeout(Record& record, Time now);
+
+  /**
+   * @brief Whether any record has a pending timeout
+   */
+  bool
+  hasTimeouts() const
+  {
+    return m_nTimeouts > 0;
+  }
+
+  /**
+   * @brief Remove the earliest pending timeout if it has expired, i.e., started at least
+   *        @p rto before @p now
+   * @param[out] seq sequence number of the record whose timeout expired
+   * @return false if no pending timeout has expired
+   */
+  bool
+  popExpiredTimeout(Time now, Time rto, uint32_t& seq);
+
+private:
+  Record&
+  allocate(uint32_t seq);
+
+  void
+  grow();
+
+private:
+  std::vector<Record> m_ring;
+  uint32_t m_mask;
+  std::unordered_map<uint32_t, Record> m_overflow;
+  size_t m_size;
+
+  std::deque<std::pair<Time, uint32_t>> m_timeouts;
+  size_t m_nTimeouts;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDNSIM_UTILS_NDN_CONSUMER_SEQ_TABLE_HPP
@@ -0,0 +1,85 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-data-template.hpp"
+
+#include <ndn-cxx/encoding/block-helpers.hpp>
+#include <ndn-cxx/encoding/encoding-buffer.hpp>
+
+#include <unordered_map>
+
+namespace ns3 {
+namespace ndn {
+
+DataTemplate::DataTemplate(size_t payloadSize, const ::ndn::time::milliseconds& freshness,
+                           uint32_t signature, const Name& keyLocator)
+{
+  ::ndn::MetaInfo metaInfo;
+  metaInfo.setFreshnessPeriod(freshness);
+
+  SignatureInfo signatureInfo(static_cast< ::ndn::tlv::SignatureTypeValue>(255));
+  if (keyLocator.size() > 0) {
+    signatureInfo.setKeyLocator(keyLocator);
+  }
+
+  ::ndn::ConstBufferPtr payload = getVirtualPayload(payloadSize);
+
+  ::ndn::EncodingBuffer encoder;
+  encoder.prependBlock(::ndn::makeNonNegativeIntegerBlock(::ndn::tlv::SignatureValue, signature));
+  encoder.prependBlock(signatureInfo.wireEncode());
+  encoder.prependByteArrayBlock(::ndn::tlv::Content, payload->buf(), payload->size());
+  metaInfo.wireEncode(encoder);
+
+  m_suffix.assign(encoder.buf(), encoder.buf() + encoder.size());
+}
+
+shared_ptr<Data>
+DataTemplate::makeData(const Name& name) const
+{
+  const Block& nameWire = name.wireEncode();
+
+  size_t valueLength = nameWire.size() + m_suffix.size();
+  size_t totalLength = ::ndn::tlv::sizeOfVarNumber(::ndn::tlv::Data) +
+                       ::ndn::tlv::sizeOfVarNumber(valueLength) + valueLength;
+
+  ::ndn::EncodingBuffer encoder(totalLength, 0);
+  encoder.prependByteArray(m_suffix.buf(), m_suffix.size());
+  encoder.prependByteArray(nameWire.wire(), nameWire.size());
+  encoder.prependVarNumber(valueLength);
+  encoder.prependVarNumber(::ndn::tlv::Data);
+
+  auto data = make_shared<Data>();
+  data->wireDecode(encoder.block());
+  return data;
+}
+
+::ndn::ConstBufferPtr
+DataTemplate::getVirtualPayload(size_t size)
+{
+  static std::unordered_map<size_t, ::ndn::ConstBufferPtr> payloads;
+
+  ::ndn::ConstBufferPtr& payload = payloads[size];
+  if (payload == nullptr) {
+    payload = make_shared< ::ndn::Buffer>(size);
+  }
+  return payload;
+}
+
+} // namespace ndn
+} // namespace ns3
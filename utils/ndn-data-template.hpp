@@ -0,0 +1,77 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDNSIM_UTILS_NDN_DATA_TEMPLATE_HPP
+#define NDNSIM_UTILS_NDN_DATA_TEMPLATE_HPP
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include <ndn-cxx/encoding/buffer.hpp>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-apps
+ * @brief Pre-encoded Data packet whose only variable part is the name
+ *
+ * MetaInfo, Content, SignatureInfo, and SignatureValue are encoded once when the template
+ * is created; makeData() then builds the wire encoding of a Data packet by splicing the
+ * name in front of them, in a single allocation, without encoding or signing anything.
+ */
+class DataTemplate
+{
+public:
+  /**
+   * @brief Create template for Data packets with a virtual (zero-filled) payload and a fake
+   *        signature
+   * @param payloadSize size of the virtual payload
+   * @param freshness FreshnessPeriod of the Data
+   * @param signature value of the fake signature (SignatureValue is a nonNegativeInteger)
+   * @param keyLocator name used as KeyLocator; if empty, KeyLocator is omitted
+   */
+  DataTemplate(size_t payloadSize, const ::ndn::time::milliseconds& freshness,
+               uint32_t signature, const Name& keyLocator);
+
+  /**
+   * @brief Create Data packet named @p name
+   *
+   * The returned Data has wire encoding, equal to what encoding a Data with the same fields
+   * would produce.
+   */
+  shared_ptr<Data>
+  makeData(const Name& name) const;
+
+  /**
+   * @brief Get a read-only, zero-filled buffer of @p size octets
+   *
+   * Buffers are shared by all callers asking for the same size, which makes them suitable as
+   * virtual payload in Data::setContent.
+   */
+  static ::ndn::ConstBufferPtr
+  getVirtualPayload(size_t size);
+
+private:
+  ::ndn::Buffer m_suffix; // MetaInfo, Content, SignatureInfo, SignatureValue
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDNSIM_UTILS_NDN_DATA_TEMPLATE_HPP
@@ -0,0 +1,165 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2016  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-request-trace.hpp"
+
+#include "ns3/assert.h"
+
+#include <boost/throw_exception.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <map>
+#include <ostream>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace ns3 {
+namespace ndn {
+
+static const char MAGIC[] = "NDNREQ01";
+
+shared_ptr<const RequestTrace>
+RequestTrace::open(const std::string& fileName)
+{
+  static std::map<std::string, weak_ptr<const RequestTrace>> traces;
+
+  shared_ptr<const RequestTrace> trace = traces[fileName].lock();
+  if (trace == nullptr) {
+    // forget traces that are no longer used by anyone
+    for (auto i = traces.begin(); i != traces.end();) {
+      if (i->second.expired()) {
+        i = traces.erase(i);
+      }
+      else {
+        ++i;
+      }
+    }
+
+    trace = make_shared<RequestTrace>(fileName);
+    traces[fileName] = trace;
+  }
+  return trace;
+}
+
+RequestTrace::RequestTrace(const std::string& fileName)
+  : m_data(nullptr)
+  , m_length(0)
+  , m_size(0)
+{
+  int fd = ::open(fileName.c_str(), O_RDONLY);
+  if (fd < 0) {
+    BOOST_THROW_EXCEPTION(Error("Cannot open request trace " + fileName + ": " +
+                                std::strerror(errno)));
+  }
+
+  struct stat st;
+  if (::fstat(fd, &st) != 0) {
+    int error = errno;
+    ::close(fd);
+    BOOST_THROW_EXCEPTION(Error("Cannot stat request trace " + fileName + ": " +
+                                std::strerror(error)));
+  }
+
+  m_length = static_cast<size_t>(st.st_size);
+  if (m_length < HEADER_SIZE || (m_length - HEADER_SIZE) % RECORD_SIZE != 0) {
+    ::close(fd);
+    BOOST_THROW_EXCEPTION(Error(fileName + " is not a valid request trace (truncated)"));
+  }
+
+  void* data = ::mmap(nullptr, m_length, PROT_READ, MAP_PRIVATE, fd, 0);
+  int error = errno;
+  ::close(fd); // the mapping stays valid
+  if (data == MAP_FAILED) {
+    BOOST_THROW_EXCEPTION(Error("Cannot map request trace " + fileName + ": " +
+                                std::strerror(error)));
+  }
+  m_data = static_cast<const uint8_t*>(data);
+
+  if (std::memcmp(m_data, MAGIC, HEADER_SIZE) != 0) {
+    ::munmap(data, m_length);
+    BOOST_THROW_EXCEPTION(Error(fileName + " is not a valid request trace (bad magic)"));
+  }
+
+  // records are read front to back
+  ::madvise(data, m_length, MADV_SEQUENTIAL);
+
+  m_size = (m_length - HEADER_SIZE) / RECORD_SIZE;
+}
+
+RequestTrace::~RequestTrace()
+{
+  ::munmap(const_cast<uint8_t*>(m_data), m_length);
+}
+
+RequestTrace::Record
+RequestTrace::get(size_t index) const
+{
+  NS_ASSERT(index < m_size);
+  const uint8_t* p = m_data + HEADER_SIZE + index * RECORD_SIZE;
+
+  Record record;
+  record.timestamp = 0;
+  for (int i = 7; i >= 0; i--) {
+    record.timestamp = (record.timestamp << 8) | p[i];
+  }
+  record.nameId = 0;
+  for (int i = 11; i >= 8; i--) {
+    record.nameId = (record.nameId << 8) | p[i];
+  }
+  return record;
+}
+
+void
+RequestTrace::release(size_t index) const
+{
+  static const size_t pageSize = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+
+  size_t end = HEADER_SIZE + std::min(index, m_size) * RECORD_SIZE;
+  end -= end % pageSize; // keep the page that still holds records at or after index
+  if (end > 0) {
+    ::madvise(const_cast<uint8_t*>(m_data), end, MADV_DONTNEED);
+  }
+}
+
+void
+RequestTrace::writeHeader(std::ostream& os)
+{
+  os.write(MAGIC, HEADER_SIZE);
+}
+
+void
+RequestTrace::writeRecord(std::ostream& os, uint64_t timestamp, uint32_t nameId)
+{
+  char buffer[RECORD_SIZE];
+  for (int i = 0; i < 8; i++) {
+    buffer[i] = static_cast<char>(timestamp >> (8 * i));
+  }
+  for (int i = 0; i < 4; i++) {
+    buffer[8 + i] = static_cast<char>(nameId >> (8 * i));
+  }
+  os.write(buffer, RECORD_SIZE);
+}
+
+} // namespace ndn
+} // namespace ns3
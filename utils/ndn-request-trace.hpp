@@ -0,0 +1,132 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2016  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDNSIM_UTILS_NDN_REQUEST_TRACE_HPP
+#define NDNSIM_UTILS_NDN_REQUEST_TRACE_HPP
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include <iosfwd>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-apps
+ * @brief Read-only view of a binary request trace, mapped into memory
+ *
+ * A request trace is a sequence of (timestamp, name ID) records, for example converted from
+ * CDN access logs.  File layout (integers little-endian):
+ *
+ *     "NDNREQ01" record...
+ *
+ * where a record is
+ *
+ *     timestamp:uint64 nameId:uint32
+ *
+ * with the timestamp in nanoseconds.  Timestamps are expected to be non-decreasing.
+ *
+ * The file is mapped, not read: pages are brought in by the OS as records are accessed and
+ * can be given back with release(), so traces much larger than the available memory can be
+ * replayed.  open() returns one instance shared by all users of the same file for as long as
+ * any of them holds it.
+ */
+class RequestTrace : boost::noncopyable
+{
+public:
+  class Error : public std::runtime_error
+  {
+  public:
+    explicit
+    Error(const std::string& what)
+      : std::runtime_error(what)
+    {
+    }
+  };
+
+  struct Record
+  {
+    uint64_t timestamp; ///< nanoseconds
+    uint32_t nameId;
+  };
+
+  static const size_t HEADER_SIZE = 8;
+  static const size_t RECORD_SIZE = 12;
+
+  /**
+   * @brief Get the shared trace for @p fileName, mapping it if necessary
+   * @throw Error the file cannot be mapped or is not a valid request trace
+   */
+  static shared_ptr<const RequestTrace>
+  open(const std::string& fileName);
+
+  /**
+   * @throw Error the file cannot be mapped or is not a valid request trace
+   */
+  explicit
+  RequestTrace(const std::string& fileName);
+
+  ~RequestTrace();
+
+  /**
+   * @brief Number of records
+   */
+  size_t
+  size() const
+  {
+    return m_size;
+  }
+
+  /**
+   * @brief Get record number @p index (< size())
+   */
+  Record
+  get(size_t index) const;
+
+  /**
+   * @brief Hint that records before @p index will not be accessed soon
+   *
+   * Resident pages holding only such records are dropped; accessing the records again
+   * is still valid and maps the pages back in.
+   */
+  void
+  release(size_t index) const;
+
+  /**
+   * @brief Write the file header of a request trace to @p os
+   */
+  static void
+  writeHeader(std::ostream& os);
+
+  /**
+   * @brief Append a record to a request trace being written to @p os
+   */
+  static void
+  writeRecord(std::ostream& os, uint64_t timestamp, uint32_t nameId);
+
+private:
+  const uint8_t* m_data;
+  size_t m_length; ///< length of the mapping
+  size_t m_size;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDNSIM_UTILS_NDN_REQUEST_TRACE_HPP
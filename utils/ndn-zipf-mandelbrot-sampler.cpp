@@ -0,0 +1,157 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-zipf-mandelbrot-sampler.hpp"
+
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <tuple>
+
+NS_LOG_COMPONENT_DEFINE("ndn.ZipfMandelbrotSampler");
+
+namespace ns3 {
+namespace ndn {
+
+shared_ptr<const ZipfMandelbrotSampler>
+ZipfMandelbrotSampler::get(uint32_t n, double q, double s, Method method)
+{
+  typedef std::tuple<uint32_t, double, double, Method> Key;
+  static std::map<Key, weak_ptr<const ZipfMandelbrotSampler>> samplers;
+
+  Key key(n, q, s, method);
+  shared_ptr<const ZipfMandelbrotSampler> sampler = samplers[key].lock();
+  if (sampler == nullptr) {
+    // forget samplers that are no longer used by anyone
+    for (auto i = samplers.begin(); i != samplers.end();) {
+      if (i->second.expired()) {
+        i = samplers.erase(i);
+      }
+      else {
+        ++i;
+      }
+    }
+
+    sampler = make_shared<ZipfMandelbrotSampler>(n, q, s, method);
+    samplers[key] = sampler;
+  }
+  return sampler;
+}
+
+ZipfMandelbrotSampler::ZipfMandelbrotSampler(uint32_t n, double q, double s, Method method)
+  : m_n(n)
+  , m_q(q)
+  , m_s(s)
+  , m_method(method)
+  , m_total(0.0)
+{
+  NS_ASSERT_MSG(n > 0, "Number of contents must be positive");
+  NS_LOG_DEBUG("Building " << (method == CDF ? "CDF" : "alias") << " table for N=" << n
+               << ", q=" << q << ", s=" << s);
+
+  // Same arithmetic as the original linear-scan implementation, so that CDF sampling
+  // reproduces its sequences exactly
+  std::vector<double> cdf(n + 1);
+  cdf[0] = 0.0;
+  for (uint32_t i = 1; i <= n; i++) {
+    cdf[i] = cdf[i - 1] + 1.0 / std::pow(i + q, s);
+  }
+  m_total = cdf[n];
+
+  if (method == CDF) {
+    for (uint32_t i = 1; i <= n; i++) {
+      cdf[i] = cdf[i] / m_total;
+    }
+    m_cdf.swap(cdf);
+  }
+  else {
+    std::vector<double>& probabilities = cdf;
+    for (uint32_t i = n; i >= 1; i--) {
+      probabilities[i] = (probabilities[i] - probabilities[i - 1]) / m_total;
+    }
+    buildAliasTable(probabilities);
+  }
+}
+
+void
+ZipfMandelbrotSampler::buildAliasTable(const std::vector<double>& probabilities)
+{
+  // Vose's variant of Walker's alias method; probabilities[k] is the probability of rank k
+  m_prob.resize(m_n);
+  m_alias.resize(m_n);
+
+  std::vector<uint32_t> small;
+  std::vector<uint32_t> large;
+  for (uint32_t column = 0; column < m_n; ++column) {
+    m_prob[column] = probabilities[column + 1] * m_n;
+    (m_prob[column] < 1.0 ? small : large).push_back(column);
+  }
+
+  while (!small.empty() && !large.empty()) {
+    uint32_t less = small.back();
+    small.pop_back();
+    uint32_t more = large.back();
+
+    m_alias[less] = more;
+    m_prob[more] = (m_prob[more] + m_prob[less]) - 1.0;
+    if (m_prob[more] < 1.0) {
+      large.pop_back();
+      small.push_back(more);
+    }
+  }
+
+  // leftovers are 1 up to rounding errors
+  for (uint32_t column : large) {
+    m_prob[column] = 1.0;
+    m_alias[column] = column;
+  }
+  for (uint32_t column : small) {
+    m_prob[column] = 1.0;
+    m_alias[column] = column;
+  }
+}
+
+uint32_t
+ZipfMandelbrotSampler::sample(double u) const
+{
+  if (m_method == CDF) {
+    // the first rank whose cumulative probability is not below u
+    auto rank = std::lower_bound(m_cdf.begin() + 1, m_cdf.end(), u);
+    if (rank == m_cdf.end()) {
+      return m_n;
+    }
+    return rank - m_cdf.begin();
+  }
+
+  double x = u * m_n;
+  uint32_t column = std::min(static_cast<uint32_t>(x), m_n - 1);
+  return (x - column < m_prob[column] ? column : m_alias[column]) + 1;
+}
+
+double
+ZipfMandelbrotSampler::getProbability(uint32_t rank) const
+{
+  NS_ASSERT(rank >= 1 && rank <= m_n);
+  return 1.0 / std::pow(rank + m_q, m_s) / m_total;
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,103 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDNSIM_UTILS_NDN_ZIPF_MANDELBROT_SAMPLER_HPP
+#define NDNSIM_UTILS_NDN_ZIPF_MANDELBROT_SAMPLER_HPP
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-apps
+ * @brief Sampler of ranks 1..N following the Zipf-Mandelbrot distribution
+ *        p(k) ~ 1 / (k + q)^s
+ *
+ * Two methods are available:
+ *  - CDF keeps the cumulative distribution and finds the sampled rank with a binary search
+ *    (O(log N) per sample, 8 bytes per rank).  For the same uniform variate it yields the
+ *    same rank as a linear scan of the CDF.
+ *  - ALIAS uses Walker's alias method (O(1) per sample, 12 bytes per rank).
+ *
+ * Samplers are immutable; get() returns one instance shared by all users of the same
+ * (N, q, s, method) for as long as any of them holds it.
+ */
+class ZipfMandelbrotSampler : boost::noncopyable
+{
+public:
+  enum Method {
+    CDF,
+    ALIAS
+  };
+
+  /**
+   * @brief Get the shared sampler for the given parameters, building it if necessary
+   */
+  static shared_ptr<const ZipfMandelbrotSampler>
+  get(uint32_t n, double q, double s, Method method);
+
+  ZipfMandelbrotSampler(uint32_t n, double q, double s, Method method);
+
+  /**
+   * @brief Map uniform variate @p u in (0, 1] to a rank in [1, N]
+   */
+  uint32_t
+  sample(double u) const;
+
+  /**
+   * @brief Probability of rank @p rank in [1, N]
+   */
+  double
+  getProbability(uint32_t rank) const;
+
+  uint32_t
+  getN() const
+  {
+    return m_n;
+  }
+
+  Method
+  getMethod() const
+  {
+    return m_method;
+  }
+
+private:
+  void
+  buildAliasTable(const std::vector<double>& probabilities);
+
+private:
+  uint32_t m_n;
+  double m_q;
+  double m_s;
+  Method m_method;
+  double m_total; ///< sum of 1 / (k + q)^s
+
+  std::vector<double> m_cdf;   ///< CDF: m_cdf[k] = P(rank <= k), m_cdf[0] = 0
+  std::vector<double> m_prob;  ///< ALIAS: probability of keeping column k (0-based)
+  std::vector<uint32_t> m_alias; ///< ALIAS: 0-based alias of column k
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDNSIM_UTILS_NDN_ZIPF_MANDELBROT_SAMPLER_HPP
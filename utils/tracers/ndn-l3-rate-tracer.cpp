@@ -18,6 +18,7 @@
  **/
 
 #include "ndn-l3-rate-tracer.hpp"
+#include "ndn-rate-trace-writer.hpp"
 #include "ns3/node.h"
 #include "ns3/packet.h"
 #include "ns3/config.h"
@@ -25,11 +26,16 @@
 #include "ns3/simulator.h"
 #include "ns3/log.h"
 #include "ns3/node-list.h"
+#include "ns3/global-value.h"
+#include "ns3/string.h"
 #include "ns3/ndnSIM/model/ndn-l3-protocol.hpp"
 
 #include "daemon/table/pit-entry.hpp"
 
 #include <fstream>
+#include <limits>
+#include <list>
+#include <sstream>
 #include <boost/lexical_cast.hpp>
 
 NS_LOG_COMPONENT_DEFINE("ndn.L3RateTracer");
@@ -37,121 +43,184 @@ NS_LOG_COMPONENT_DEFINE("ndn.L3RateTracer");
 namespace ns3 {
 namespace ndn {
 
-static std::list<std::tuple<shared_ptr<std::ostream>, std::list<Ptr<L3RateTracer>>>>
-  g_tracers;
+static GlobalValue g_l3RateTracerFormat("NdnL3RateTracerFormat",
+                                        "Format of trace files written by L3RateTracer: "
+                                        "tsv (tab-separated values) or binary",
+                                        StringValue("tsv"), MakeStringChecker());
 
-void
-L3RateTracer::Destroy()
-{
-  g_tracers.clear();
-}
+const L3RateTracer::RateType L3RateTracer::RATE_TYPES[] = {
+  {"InInterests", &Stats::m_inInterests},
+  {"OutInterests", &Stats::m_outInterests},
 
-void
-L3RateTracer::InstallAll(const std::string& file, Time averagingPeriod /* = Seconds (0.5)*/)
-{
-  std::list<Ptr<L3RateTracer>> tracers;
-  shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
-
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
-      return;
-    }
+  {"InData", &Stats::m_inData},
+  {"OutData", &Stats::m_outData},
 
-    outputStream = os;
-  }
-  else {
-    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+  {"InNacks", &Stats::m_inNack},
+  {"OutNacks", &Stats::m_outNack},
+
+  {"InSatisfiedInterests", &Stats::m_satisfiedInterests},
+  {"InTimedOutInterests", &Stats::m_timedOutInterests},
+
+  {"OutSatisfiedInterests", &Stats::m_outSatisfiedInterests},
+  {"OutTimedOutInterests", &Stats::m_outTimedOutInterests},
+
+  // totals for all faces
+  {"SatisfiedInterests", &Stats::m_satisfiedInterests},
+  {"TimedOutInterests", &Stats::m_timedOutInterests},
+};
+
+static const size_t N_FACE_RATE_TYPES = 10;
+static const size_t N_RATE_TYPES = 12;
+
+static const uint32_t NO_SERIES = std::numeric_limits<uint32_t>::max();
+
+/**
+ * @brief Tracers writing into the same file, printed by one event per averaging period
+ */
+class L3RateTraceFile : boost::noncopyable
+{
+public:
+  L3RateTraceFile(shared_ptr<std::ostream> os, bool isBinary, Time averagingPeriod)
+    : m_os(os)
+    , m_isBinary(isBinary)
+    , m_period(averagingPeriod)
+  {
   }
 
-  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
-    Ptr<L3RateTracer> trace = Install(*node, outputStream, averagingPeriod);
-    tracers.push_back(trace);
+  ~L3RateTraceFile()
+  {
+    m_printEvent.Cancel();
   }
 
-  if (tracers.size() > 0) {
-    // *m_l3RateTrace << "# "; // not necessary for R's read.table
-    tracers.front()->PrintHeader(*outputStream);
-    *outputStream << "\n";
+  void
+  Add(Ptr<L3RateTracer> tracer)
+  {
+    // the tracer is printed by this file instead of its own event
+    tracer->m_printEvent.Cancel();
+    tracer->m_period = m_period;
+    m_tracers.push_back(tracer);
   }
 
-  g_tracers.push_back(std::make_tuple(outputStream, tracers));
-}
+  void
+  Start()
+  {
+    if (m_tracers.empty()) {
+      return;
+    }
 
-void
-L3RateTracer::Install(const NodeContainer& nodes, const std::string& file,
-                      Time averagingPeriod /* = Seconds (0.5)*/)
-{
-  using namespace boost;
-  using namespace std;
+    if (m_isBinary) {
+      std::ostringstream header;
+      m_tracers.front()->PrintHeader(header);
 
-  std::list<Ptr<L3RateTracer>> tracers;
-  shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
+      std::vector<std::string> types;
+      for (size_t type = 0; type < N_RATE_TYPES; ++type) {
+        types.push_back(L3RateTracer::RATE_TYPES[type].name);
+      }
 
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
-      return;
+      m_writer.reset(new RateTraceWriter(m_os, header.str(), types));
+    }
+    else {
+      // *m_l3RateTrace << "# "; // not necessary for R's read.table
+      m_tracers.front()->PrintHeader(*m_os);
+      *m_os << "\n";
     }
 
-    outputStream = os;
-  }
-  else {
-    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+    m_printEvent = Simulator::Schedule(m_period, &L3RateTraceFile::PeriodicPrinter, this);
   }
 
-  for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
-    Ptr<L3RateTracer> trace = Install(*node, outputStream, averagingPeriod);
-    tracers.push_back(trace);
+private:
+  void
+  PeriodicPrinter()
+  {
+    for (const auto& tracer : m_tracers) {
+      if (m_writer != nullptr) {
+        tracer->Write(*m_writer);
+      }
+      else {
+        tracer->Print(*m_os);
+      }
+      tracer->Reset();
+    }
+
+    if (m_writer != nullptr) {
+      m_writer->writePeriod(Simulator::Now().ToDouble(Time::S));
+    }
+
+    m_printEvent = Simulator::Schedule(m_period, &L3RateTraceFile::PeriodicPrinter, this);
   }
 
-  if (tracers.size() > 0) {
-    // *m_l3RateTrace << "# "; // not necessary for R's read.table
-    tracers.front()->PrintHeader(*outputStream);
-    *outputStream << "\n";
+private:
+  shared_ptr<std::ostream> m_os;
+  bool m_isBinary;
+  Time m_period;
+  EventId m_printEvent;
+  std::list<Ptr<L3RateTracer>> m_tracers;
+  std::unique_ptr<RateTraceWriter> m_writer; // destroyed first, flushing pending periods
+};
+
+static std::list<shared_ptr<L3RateTraceFile>> g_tracers;
+
+static shared_ptr<std::ostream>
+openOutput(const std::string& file, std::ios_base::openmode mode = std::ios_base::out)
+{
+  if (file == "-") {
+    return shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
   }
 
-  g_tracers.push_back(std::make_tuple(outputStream, tracers));
+  shared_ptr<std::ofstream> os(new std::ofstream());
+  os->open(file.c_str(), mode | std::ios_base::trunc);
+
+  if (!os->is_open()) {
+    NS_LOG_ERROR("File " << file << " cannot be opened for writing");
+    return nullptr;
+  }
+  return os;
 }
 
 void
-L3RateTracer::Install(Ptr<Node> node, const std::string& file,
-                      Time averagingPeriod /* = Seconds (0.5)*/)
+L3RateTracer::Destroy()
 {
-  using namespace boost;
-  using namespace std;
-
-  std::list<Ptr<L3RateTracer>> tracers;
-  shared_ptr<std::ostream> outputStream;
-  if (file != "-") {
-    shared_ptr<std::ofstream> os(new std::ofstream());
-    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
+  g_tracers.clear();
+}
 
-    if (!os->is_open()) {
-      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
-      return;
-    }
+void
+L3RateTracer::InstallAll(const std::string& file, Time averagingPeriod /* = Seconds (0.5)*/)
+{
+  Install(NodeContainer::GetGlobal(), file, averagingPeriod);
+}
 
-    outputStream = os;
-  }
-  else {
-    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+void
+L3RateTracer::Install(const NodeContainer& nodes, const std::string& file,
+                      Time averagingPeriod /* = Seconds (0.5)*/)
+{
+  StringValue format;
+  g_l3RateTracerFormat.GetValue(format);
+  if (format.Get() != "tsv" && format.Get() != "binary") {
+    NS_FATAL_ERROR("Unknown L3RateTracer format " << format.Get() << " (expected tsv or binary)");
   }
+  bool isBinary = format.Get() == "binary";
 
-  Ptr<L3RateTracer> trace = Install(node, outputStream, averagingPeriod);
-  tracers.push_back(trace);
+  shared_ptr<std::ostream> outputStream =
+    openOutput(file, isBinary ? std::ios_base::out | std::ios_base::binary : std::ios_base::out);
+  if (outputStream == nullptr) {
+    NS_LOG_ERROR("Tracing disabled");
+    return;
+  }
 
-  if (tracers.size() > 0) {
-    // *m_l3RateTrace << "# "; // not necessary for R's read.table
-    tracers.front()->PrintHeader(*outputStream);
-    *outputStream << "\n";
+  auto traceFile = make_shared<L3RateTraceFile>(outputStream, isBinary, averagingPeriod);
+  for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
+    traceFile->Add(Install(*node, outputStream, averagingPeriod));
   }
+  traceFile->Start();
 
-  g_tracers.push_back(std::make_tuple(outputStream, tracers));
+  g_tracers.push_back(traceFile);
+}
+
+void
+L3RateTracer::Install(Ptr<Node> node, const std::string& file,
+                      Time averagingPeriod /* = Seconds (0.5)*/)
+{
+  Install(NodeContainer(node), file, averagingPeriod);
 }
 
 Ptr<L3RateTracer>
@@ -166,17 +235,46 @@ L3RateTracer::Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream,
   return trace;
 }
 
+bool
+L3RateTracer::ConvertToTsv(const std::string& binaryFile, const std::string& file)
+{
+  std::ifstream is(binaryFile.c_str(), std::ios_base::in | std::ios_base::binary);
+  if (!is.is_open()) {
+    NS_LOG_ERROR("File " << binaryFile << " cannot be opened for reading");
+    return false;
+  }
+
+  shared_ptr<std::ostream> os = openOutput(file);
+  if (os == nullptr) {
+    return false;
+  }
+
+  return RateTraceWriter::convertToTsv(is, *os);
+}
+
 L3RateTracer::L3RateTracer(shared_ptr<std::ostream> os, Ptr<Node> node)
   : L3Tracer(node)
   , m_os(os)
+  , m_totalStats()
+  , m_hasTotalStats(false)
 {
+  m_totalStats.faceId = nfd::face::INVALID_FACEID;
+  m_totalStats.info = "all";
+  m_totalStats.series = NO_SERIES;
+
   SetAveragingPeriod(Seconds(1.0));
 }
 
 L3RateTracer::L3RateTracer(shared_ptr<std::ostream> os, const std::string& node)
   : L3Tracer(node)
   , m_os(os)
+  , m_totalStats()
+  , m_hasTotalStats(false)
 {
+  m_totalStats.faceId = nfd::face::INVALID_FACEID;
+  m_totalStats.info = "all";
+  m_totalStats.series = NO_SERIES;
+
   SetAveragingPeriod(Seconds(1.0));
 }
 
@@ -229,175 +327,209 @@ L3RateTracer::PrintHeader(std::ostream& os) const
 void
 L3RateTracer::Reset()
 {
-  for (auto& stats : m_stats) {
-    std::get<0>(stats.second).Reset();
-    std::get<1>(stats.second).Reset();
+  for (auto& stats : m_faceStats) {
+    stats.packets.Reset();
+    stats.bytes.Reset();
   }
+  m_totalStats.packets.Reset();
+  m_totalStats.bytes.Reset();
 }
 
 const double alpha = 0.8;
 
-#define STATS(INDEX) std::get<INDEX>(stats.second)
-#define RATE(INDEX, fieldName) STATS(INDEX).fieldName / m_period.ToDouble(Time::S)
-
-#define PRINTER(printName, fieldName)                                                              \
-  STATS(2).fieldName =                                                                             \
-    /*new value*/ alpha * RATE(0, fieldName) + /*old value*/ (1 - alpha) * STATS(2).fieldName;     \
-  STATS(3).fieldName = /*new value*/ alpha * RATE(1, fieldName) / 1024.0                           \
-                       + /*old value*/ (1 - alpha) * STATS(3).fieldName;                           \
-                                                                                                   \
-  os << time.ToDouble(Time::S) << "\t" << m_node << "\t";                                          \
-  if (stats.first != nfd::face::INVALID_FACEID) {                                                  \
-    os << stats.first << "\t";                                                                     \
-    NS_ASSERT(m_faceInfos.find(stats.first) != m_faceInfos.end());                                 \
-    os << m_faceInfos.find(stats.first)->second << "\t";                                           \
-  }                                                                                                \
-  else {                                                                                           \
-    os << "-1\tall\t";                                                                             \
-  }                                                                                                \
-  os << printName << "\t" << STATS(2).fieldName << "\t" << STATS(3).fieldName << "\t"              \
-     << STATS(0).fieldName << "\t" << STATS(1).fieldName / 1024.0 << "\n";
+void
+L3RateTracer::UpdateRates(FaceStats& stats) const
+{
+  double period = m_period.ToDouble(Time::S);
+
+  for (size_t type = 0; type < N_FACE_RATE_TYPES; ++type) {
+    double Stats::*field = RATE_TYPES[type].field;
+
+    stats.packetRate.*field = /*new value*/ alpha * stats.packets.*field / period
+                              + /*old value*/ (1 - alpha) * stats.packetRate.*field;
+    stats.kilobyteRate.*field = /*new value*/ alpha * stats.bytes.*field / period / 1024.0
+                                + /*old value*/ (1 - alpha) * stats.kilobyteRate.*field;
+  }
+}
 
 void
 L3RateTracer::Print(std::ostream& os) const
 {
   Time time = Simulator::Now();
 
-  for (auto& stats : m_stats) {
-    if (stats.first == nfd::face::INVALID_FACEID)
-      continue;
+  auto print = [&] (FaceStats& stats, size_t firstType, size_t lastType) {
+    UpdateRates(stats);
+
+    for (size_t type = firstType; type < lastType; ++type) {
+      double Stats::*field = RATE_TYPES[type].field;
+
+      os << time.ToDouble(Time::S) << "\t" << m_node << "\t";
+      if (stats.faceId != nfd::face::INVALID_FACEID) {
+        os << stats.faceId << "\t" << stats.info << "\t";
+      }
+      else {
+        os << "-1\tall\t";
+      }
+      os << RATE_TYPES[type].name << "\t" << stats.packetRate.*field << "\t"
+         << stats.kilobyteRate.*field << "\t" << stats.packets.*field << "\t"
+         << stats.bytes.*field / 1024.0 << "\n";
+    }
+  };
 
-    PRINTER("InInterests", m_inInterests);
-    PRINTER("OutInterests", m_outInterests);
+  // faces in the order of their IDs
+  for (uint32_t slot : m_slots) {
+    if (slot != 0) {
+      print(m_faceStats[slot - 1], 0, N_FACE_RATE_TYPES);
+    }
+  }
 
-    PRINTER("InData", m_inData);
-    PRINTER("OutData", m_outData);
+  if (m_hasTotalStats) {
+    print(m_totalStats, N_FACE_RATE_TYPES, N_RATE_TYPES);
+  }
+}
+
+void
+L3RateTracer::Write(RateTraceWriter& writer)
+{
+  auto write = [&] (FaceStats& stats, size_t firstType, size_t lastType) {
+    if (stats.series == NO_SERIES) {
+      int64_t faceId = stats.faceId != nfd::face::INVALID_FACEID ?
+                         static_cast<int64_t>(stats.faceId) : -1;
+      stats.series = writer.addSeries(m_node, faceId, stats.info);
+    }
 
-    PRINTER("InNacks", m_inNack);
-    PRINTER("OutNacks", m_outNack);
+    UpdateRates(stats);
 
-    PRINTER("InSatisfiedInterests", m_satisfiedInterests);
-    PRINTER("InTimedOutInterests", m_timedOutInterests);
+    for (size_t type = firstType; type < lastType; ++type) {
+      double Stats::*field = RATE_TYPES[type].field;
+      writer.addRow(stats.series, type, stats.packetRate.*field, stats.kilobyteRate.*field,
+                    stats.packets.*field, stats.bytes.*field / 1024.0);
+    }
+  };
 
-    PRINTER("OutSatisfiedInterests", m_outSatisfiedInterests);
-    PRINTER("OutTimedOutInterests", m_outTimedOutInterests);
+  for (uint32_t slot : m_slots) {
+    if (slot != 0) {
+      write(m_faceStats[slot - 1], 0, N_FACE_RATE_TYPES);
+    }
   }
 
-  {
-    auto i = m_stats.find(nfd::face::INVALID_FACEID);
-    if (i != m_stats.end()) {
-      auto& stats = *i;
-      PRINTER("SatisfiedInterests", m_satisfiedInterests);
-      PRINTER("TimedOutInterests", m_timedOutInterests);
-    }
+  if (m_hasTotalStats) {
+    write(m_totalStats, N_FACE_RATE_TYPES, N_RATE_TYPES);
   }
 }
 
+L3RateTracer::FaceStats&
+L3RateTracer::AddFace(const Face& face)
+{
+  nfd::FaceId id = face.getId();
+  if (id >= m_slots.size()) {
+    m_slots.resize(id + 1, 0);
+  }
+
+  m_faceStats.push_back(FaceStats());
+  m_slots[id] = m_faceStats.size();
+
+  FaceStats& stats = m_faceStats.back();
+  stats.faceId = id;
+  stats.info = boost::lexical_cast<std::string>(face.getLocalUri());
+  stats.series = NO_SERIES;
+  return stats;
+}
+
+L3RateTracer::FaceStats&
+L3RateTracer::GetTotalStats()
+{
+  m_hasTotalStats = true;
+  return m_totalStats;
+}
+
 void
 L3RateTracer::OutInterests(const Interest& interest, const Face& face)
 {
-  AddInfo(face);
-  std::get<0>(m_stats[face.getId()]).m_outInterests++;
+  FaceStats& stats = GetStats(face);
+  stats.packets.m_outInterests++;
   if (interest.hasWire()) {
-    std::get<1>(m_stats[face.getId()]).m_outInterests +=
-      interest.wireEncode().size();
+    stats.bytes.m_outInterests += interest.wireEncode().size();
   }
 }
 
 void
 L3RateTracer::InInterests(const Interest& interest, const Face& face)
 {
-  AddInfo(face);
-  std::get<0>(m_stats[face.getId()]).m_inInterests++;
+  FaceStats& stats = GetStats(face);
+  stats.packets.m_inInterests++;
   if (interest.hasWire()) {
-    std::get<1>(m_stats[face.getId()]).m_inInterests +=
-      interest.wireEncode().size();
+    stats.bytes.m_inInterests += interest.wireEncode().size();
   }
 }
 
 void
 L3RateTracer::OutData(const Data& data, const Face& face)
 {
-  AddInfo(face);
-  std::get<0>(m_stats[face.getId()]).m_outData++;
+  FaceStats& stats = GetStats(face);
+  stats.packets.m_outData++;
   if (data.hasWire()) {
-    std::get<1>(m_stats[face.getId()]).m_outData +=
-      data.wireEncode().size();
+    stats.bytes.m_outData += data.wireEncode().size();
   }
 }
 
 void
 L3RateTracer::InData(const Data& data, const Face& face)
 {
-  AddInfo(face);
-  std::get<0>(m_stats[face.getId()]).m_inData++;
+  FaceStats& stats = GetStats(face);
+  stats.packets.m_inData++;
   if (data.hasWire()) {
-    std::get<1>(m_stats[face.getId()]).m_inData +=
-      data.wireEncode().size();
+    stats.bytes.m_inData += data.wireEncode().size();
   }
 }
 
 void
 L3RateTracer::OutNack(const lp::Nack& nack, const Face& face)
 {
-  AddInfo(face);
-  std::get<0>(m_stats[face.getId()]).m_outNack++;
+  FaceStats& stats = GetStats(face);
+  stats.packets.m_outNack++;
   if (nack.getInterest().hasWire()) {
-    std::get<1>(m_stats[face.getId()]).m_outNack +=
-      nack.getInterest().wireEncode().size();
+    stats.bytes.m_outNack += nack.getInterest().wireEncode().size();
   }
 }
 
 void
 L3RateTracer::InNack(const lp::Nack& nack, const Face& face)
 {
-  AddInfo(face);
-  std::get<0>(m_stats[face.getId()]).m_inNack++;
+  FaceStats& stats = GetStats(face);
+  stats.packets.m_inNack++;
   if (nack.getInterest().hasWire()) {
-    std::get<1>(m_stats[face.getId()]).m_inNack +=
-      nack.getInterest().wireEncode().size();
+    stats.bytes.m_inNack += nack.getInterest().wireEncode().size();
   }
 }
 
 void
 L3RateTracer::SatisfiedInterests(const nfd::pit::Entry& entry, const Face&, const Data&)
 {
-  std::get<0>(m_stats[nfd::face::INVALID_FACEID]).m_satisfiedInterests++;
+  GetTotalStats().packets.m_satisfiedInterests++;
   // no "size" stats
 
   for (const auto& in : entry.getInRecords()) {
-    AddInfo(in.getFace());
-    std::get<0>(m_stats[(in.getFace()).getId()]).m_satisfiedInterests ++;
+    GetStats(in.getFace()).packets.m_satisfiedInterests++;
   }
 
   for (const auto& out : entry.getOutRecords()) {
-    AddInfo(out.getFace());
-    std::get<0>(m_stats[(out.getFace()).getId()]).m_outSatisfiedInterests ++;
+    GetStats(out.getFace()).packets.m_outSatisfiedInterests++;
   }
 }
 
 void
 L3RateTracer::TimedOutInterests(const nfd::pit::Entry& entry)
 {
-  std::get<0>(m_stats[nfd::face::INVALID_FACEID]).m_timedOutInterests++;
+  GetTotalStats().packets.m_timedOutInterests++;
   // no "size" stats
 
   for (const auto& in : entry.getInRecords()) {
-    AddInfo(in.getFace());
-    std::get<0>(m_stats[(in.getFace()).getId()]).m_timedOutInterests++;
+    GetStats(in.getFace()).packets.m_timedOutInterests++;
   }
 
   for (const auto& out : entry.getOutRecords()) {
-    AddInfo(out.getFace());
-    std::get<0>(m_stats[(out.getFace()).getId()]).m_outTimedOutInterests++;
-  }
-}
-
-void
-L3RateTracer::AddInfo(const Face& face)
-{
-  if (m_faceInfos.find(face.getId()) == m_faceInfos.end()) {
-    m_faceInfos.insert(make_pair(face.getId(), boost::lexical_cast<std::string>(face.getLocalUri())));
+    GetStats(out.getFace()).packets.m_outTimedOutInterests++;
   }
 }
 
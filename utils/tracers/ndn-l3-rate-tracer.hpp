@@ -28,16 +28,25 @@
 #include "ns3/event-id.h"
 #include "ns3/node-container.h"
 
-#include <tuple>
-#include <map>
-#include <list>
+#include <vector>
 
 namespace ns3 {
 namespace ndn {
 
+class L3RateTraceFile;
+class RateTraceWriter;
+
 /**
  * @ingroup ndn-tracers
  * @brief NDN network-layer rate tracer
+ *
+ * Counters are kept in a dense array indexed by face slot, so accounting a packet does not
+ * involve any map lookups.  Tracers installed into the same file are printed together by a
+ * single event per averaging period.
+ *
+ * Files are written as tab-separated values, or, if the global value NdnL3RateTracerFormat
+ * is set to "binary", in the compact format of RateTraceWriter from a background thread.
+ * Binary traces can be turned into the text format with ConvertToTsv.
  */
 class L3RateTracer : public L3Tracer {
 public:
@@ -83,6 +92,18 @@ public:
   static void
   Destroy();
 
+  /**
+   * @brief Convert a binary trace into tab-separated values, as if it were written in the
+   *        text format
+   *
+   * @param binaryFile binary trace written with NdnL3RateTracerFormat set to "binary"
+   * @param file File to which the converted trace will be written.  If filename is -, then
+   *        std::out is used
+   * @returns false if binary trace could not be read completely
+   */
+  static bool
+  ConvertToTsv(const std::string& binaryFile, const std::string& file);
+
   /**
    * @brief Trace constructor that attaches to the node using node pointer
    * @param os    reference to the output stream
@@ -152,6 +173,26 @@ protected:
   TimedOutInterests(const nfd::pit::Entry&);
 
 private:
+  struct FaceStats
+  {
+    nfd::FaceId faceId;
+    std::string info; // needed, because face may no longer exists at the time of stat printing
+    uint32_t series;  // series number in binary output
+
+    Stats packets;
+    Stats bytes;
+    Stats packetRate;
+    Stats kilobyteRate;
+  };
+
+  struct RateType
+  {
+    const char* name;
+    double Stats::*field;
+  };
+
+  static const RateType RATE_TYPES[]; // per-face types first, followed by totals
+
   void
   SetAveragingPeriod(const Time& period);
 
@@ -161,16 +202,42 @@ private:
   void
   Reset();
 
+  /**
+   * @brief Update rates and write current trace data into the binary trace
+   */
+  void
+  Write(RateTraceWriter& writer);
+
   void
-  AddInfo(const Face& face);
+  UpdateRates(FaceStats& stats) const;
+
+  FaceStats&
+  GetStats(const Face& face)
+  {
+    nfd::FaceId id = face.getId();
+    if (id < m_slots.size() && m_slots[id] != 0) {
+      return m_faceStats[m_slots[id] - 1];
+    }
+    return AddFace(face);
+  }
+
+  FaceStats&
+  AddFace(const Face& face);
+
+  FaceStats&
+  GetTotalStats();
+
+  friend class L3RateTraceFile;
 
 private:
   shared_ptr<std::ostream> m_os;
   Time m_period;
   EventId m_printEvent;
 
-  mutable std::map<nfd::FaceId, std::tuple<Stats, Stats, Stats, Stats>> m_stats;
-  std::map<nfd::FaceId, std::string> m_faceInfos; // needed, because face may no longer exists at the time of stat printing
+  mutable std::vector<FaceStats> m_faceStats; // by slot
+  std::vector<uint32_t> m_slots;              // face ID -> slot + 1, or 0 if face is not known
+  mutable FaceStats m_totalStats;             // combined metrics, valid if m_hasTotalStats
+  bool m_hasTotalStats;
 };
 
 } // namespace ndn
@@ -0,0 +1,295 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2016  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-rate-trace-writer.hpp"
+
+#include "ns3/log.h"
+
+#include <cstring>
+#include <istream>
+#include <ostream>
+
+NS_LOG_COMPONENT_DEFINE("ndn.RateTraceWriter");
+
+namespace ns3 {
+namespace ndn {
+
+static const char MAGIC[] = "NDNRATE1";
+static const size_t MAGIC_LENGTH = sizeof(MAGIC) - 1;
+
+enum : uint8_t {
+  RECORD_SERIES = 1,
+  RECORD_PERIOD = 2
+};
+
+// periods waiting for the background thread before the simulation is held back
+static const size_t MAX_QUEUED_PERIODS = 16;
+
+template<typename T>
+static void
+append(std::vector<uint8_t>& buffer, const T* values, size_t n)
+{
+  const uint8_t* bytes = reinterpret_cast<const uint8_t*>(values);
+  buffer.insert(buffer.end(), bytes, bytes + n * sizeof(T));
+}
+
+template<typename T>
+static void
+append(std::vector<uint8_t>& buffer, const T& value)
+{
+  append(buffer, &value, 1);
+}
+
+static void
+append(std::vector<uint8_t>& buffer, const std::string& value)
+{
+  append(buffer, static_cast<uint32_t>(value.size()));
+  append(buffer, value.data(), value.size());
+}
+
+template<typename T>
+static bool
+read(std::istream& is, T* values, size_t n)
+{
+  is.read(reinterpret_cast<char*>(values), n * sizeof(T));
+  return static_cast<bool>(is);
+}
+
+template<typename T>
+static bool
+read(std::istream& is, T& value)
+{
+  return read(is, &value, 1);
+}
+
+static bool
+read(std::istream& is, std::string& value)
+{
+  uint32_t length = 0;
+  if (!read(is, length)) {
+    return false;
+  }
+  value.resize(length);
+  return read(is, &value[0], length);
+}
+
+RateTraceWriter::RateTraceWriter(shared_ptr<std::ostream> os, const std::string& header,
+                                 const std::vector<std::string>& types)
+  : m_os(os)
+  , m_nSeries(0)
+  , m_isStopping(false)
+{
+  append(m_buffer, MAGIC, MAGIC_LENGTH);
+  append(m_buffer, header);
+  append(m_buffer, static_cast<uint32_t>(types.size()));
+  for (const auto& type : types) {
+    append(m_buffer, type);
+  }
+
+  m_thread = std::thread(&RateTraceWriter::run, this);
+}
+
+RateTraceWriter::~RateTraceWriter()
+{
+  submit();
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_isStopping = true;
+  }
+  m_hasWork.notify_one();
+  m_thread.join();
+
+  m_os->flush();
+}
+
+uint32_t
+RateTraceWriter::addSeries(const std::string& node, int64_t faceId, const std::string& description)
+{
+  append(m_buffer, RECORD_SERIES);
+  append(m_buffer, node);
+  append(m_buffer, faceId);
+  append(m_buffer, description);
+  return m_nSeries++;
+}
+
+void
+RateTraceWriter::addRow(uint32_t series, uint8_t type,
+                        double packets, double kilobytes, double packetsRaw, double kilobytesRaw)
+{
+  m_series.push_back(series);
+  m_types.push_back(type);
+  m_packets.push_back(packets);
+  m_kilobytes.push_back(kilobytes);
+  m_packetsRaw.push_back(packetsRaw);
+  m_kilobytesRaw.push_back(kilobytesRaw);
+}
+
+void
+RateTraceWriter::writePeriod(double time)
+{
+  size_t nRows = m_series.size();
+
+  append(m_buffer, RECORD_PERIOD);
+  append(m_buffer, time);
+  append(m_buffer, static_cast<uint32_t>(nRows));
+  append(m_buffer, m_series.data(), nRows);
+  append(m_buffer, m_types.data(), nRows);
+  append(m_buffer, m_packets.data(), nRows);
+  append(m_buffer, m_kilobytes.data(), nRows);
+  append(m_buffer, m_packetsRaw.data(), nRows);
+  append(m_buffer, m_kilobytesRaw.data(), nRows);
+
+  m_series.clear();
+  m_types.clear();
+  m_packets.clear();
+  m_kilobytes.clear();
+  m_packetsRaw.clear();
+  m_kilobytesRaw.clear();
+
+  submit();
+}
+
+void
+RateTraceWriter::submit()
+{
+  if (m_buffer.empty()) {
+    return;
+  }
+
+  std::vector<uint8_t> buffer;
+  buffer.reserve(m_buffer.size());
+  buffer.swap(m_buffer);
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_hasRoom.wait(lock, [this] { return m_queue.size() < MAX_QUEUED_PERIODS; });
+    m_queue.push_back(std::move(buffer));
+  }
+  m_hasWork.notify_one();
+}
+
+void
+RateTraceWriter::run()
+{
+  while (true) {
+    std::vector<uint8_t> buffer;
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_hasWork.wait(lock, [this] { return !m_queue.empty() || m_isStopping; });
+      if (m_queue.empty()) {
+        return;
+      }
+      buffer = std::move(m_queue.front());
+      m_queue.pop_front();
+    }
+    m_hasRoom.notify_one();
+
+    m_os->write(reinterpret_cast<const char*>(buffer.data()), buffer.size());
+  }
+}
+
+bool
+RateTraceWriter::convertToTsv(std::istream& is, std::ostream& os)
+{
+  char magic[MAGIC_LENGTH];
+  std::string header;
+  uint32_t nTypes = 0;
+  if (!read(is, magic, MAGIC_LENGTH) || std::memcmp(magic, MAGIC, MAGIC_LENGTH) != 0 ||
+      !read(is, header) || !read(is, nTypes)) {
+    NS_LOG_ERROR("Not a binary rate trace");
+    return false;
+  }
+
+  std::vector<std::string> types(nTypes);
+  for (auto& type : types) {
+    if (!read(is, type)) {
+      return false;
+    }
+  }
+
+  os << header << "\n";
+
+  struct Series
+  {
+    std::string node;
+    int64_t faceId;
+    std::string description;
+  };
+  std::vector<Series> series;
+
+  std::vector<uint32_t> rowSeries;
+  std::vector<uint8_t> rowTypes;
+  std::vector<double> packets, kilobytes, packetsRaw, kilobytesRaw;
+
+  bool isTruncated = false;
+  uint8_t record = 0;
+  while (read(is, record)) {
+    if (record == RECORD_SERIES) {
+      Series s;
+      if (!read(is, s.node) || !read(is, s.faceId) || !read(is, s.description)) {
+        isTruncated = true;
+        break;
+      }
+      series.push_back(std::move(s));
+    }
+    else if (record == RECORD_PERIOD) {
+      double time = 0;
+      uint32_t nRows = 0;
+      if (!read(is, time) || !read(is, nRows)) {
+        isTruncated = true;
+        break;
+      }
+      rowSeries.resize(nRows);
+      rowTypes.resize(nRows);
+      packets.resize(nRows);
+      kilobytes.resize(nRows);
+      packetsRaw.resize(nRows);
+      kilobytesRaw.resize(nRows);
+      if (!read(is, rowSeries.data(), nRows) || !read(is, rowTypes.data(), nRows) ||
+          !read(is, packets.data(), nRows) || !read(is, kilobytes.data(), nRows) ||
+          !read(is, packetsRaw.data(), nRows) || !read(is, kilobytesRaw.data(), nRows)) {
+        isTruncated = true;
+        break;
+      }
+
+      for (uint32_t i = 0; i < nRows; ++i) {
+        if (rowSeries[i] >= series.size() || rowTypes[i] >= types.size()) {
+          NS_LOG_ERROR("Corrupted binary rate trace");
+          return false;
+        }
+        const Series& s = series[rowSeries[i]];
+        os << time << "\t" << s.node << "\t" << s.faceId << "\t" << s.description << "\t"
+           << types[rowTypes[i]] << "\t" << packets[i] << "\t" << kilobytes[i] << "\t"
+           << packetsRaw[i] << "\t" << kilobytesRaw[i] << "\n";
+      }
+    }
+    else {
+      NS_LOG_ERROR("Unknown record " << static_cast<int>(record) << " in binary rate trace");
+      return false;
+    }
+  }
+
+  if (isTruncated) {
+    NS_LOG_ERROR("Truncated binary rate trace");
+    return false;
+  }
+  return true;
+}
+
+} // namespace ndn
+} // namespace ns3
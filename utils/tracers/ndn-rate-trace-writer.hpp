@@ -0,0 +1,140 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2016  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDNSIM_UTILS_TRACERS_NDN_RATE_TRACE_WRITER_HPP
+#define NDNSIM_UTILS_TRACERS_NDN_RATE_TRACE_WRITER_HPP
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include <condition_variable>
+#include <deque>
+#include <iosfwd>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Writer of rate traces in a compact binary format
+ *
+ * A trace is a sequence of periods, each being a table of rows (series, type, packets,
+ * kilobytes, packetsRaw, kilobytesRaw).  A series is a (node, face ID, face description)
+ * triple, registered once with addSeries and referred to by its number afterwards.  Rows
+ * of a period are stored column by column.
+ *
+ * Records are serialized on the simulation thread into a buffer that is handed over to a
+ * background thread once per period, which does the actual writing.
+ *
+ * File layout (integers and doubles in host byte order, strings as uint32 length followed
+ * by the characters):
+ *
+ *     "NDNRATE1" header:string nTypes:uint32 type:string...
+ *     record...
+ *
+ * where a record is either a series definition
+ *
+ *     1:uint8 node:string faceId:int64 description:string
+ *
+ * or a period
+ *
+ *     2:uint8 time:double nRows:uint32 series:uint32[nRows] type:uint8[nRows]
+ *     packets:double[nRows] kilobytes:double[nRows] packetsRaw:double[nRows]
+ *     kilobytesRaw:double[nRows]
+ *
+ * convertToTsv turns such a trace back into the text format of the tracer that wrote it.
+ */
+class RateTraceWriter : boost::noncopyable
+{
+public:
+  /**
+   * @param os output stream, written only from the background thread
+   * @param header column header line of the equivalent text trace
+   * @param types names of row types, referred to by index in addRow
+   */
+  RateTraceWriter(shared_ptr<std::ostream> os, const std::string& header,
+                  const std::vector<std::string>& types);
+
+  /**
+   * @brief Write out all pending records and stop the background thread
+   */
+  ~RateTraceWriter();
+
+  /**
+   * @brief Register a new series
+   * @return number of the series
+   */
+  uint32_t
+  addSeries(const std::string& node, int64_t faceId, const std::string& description);
+
+  /**
+   * @brief Add a row to the current period
+   */
+  void
+  addRow(uint32_t series, uint8_t type,
+         double packets, double kilobytes, double packetsRaw, double kilobytesRaw);
+
+  /**
+   * @brief Finish the current period and hand it over to the background thread
+   * @param time simulation time of the period, in seconds
+   */
+  void
+  writePeriod(double time);
+
+  /**
+   * @brief Convert binary trace read from @p is into tab-separated values
+   * @return false if @p is is not a valid trace; rows decoded until then are written anyway
+   */
+  static bool
+  convertToTsv(std::istream& is, std::ostream& os);
+
+private:
+  void
+  submit();
+
+  void
+  run();
+
+private:
+  shared_ptr<std::ostream> m_os;
+  uint32_t m_nSeries;
+  std::vector<uint8_t> m_buffer; ///< serialized records not yet submitted
+
+  // columns of the current period
+  std::vector<uint32_t> m_series;
+  std::vector<uint8_t> m_types;
+  std::vector<double> m_packets;
+  std::vector<double> m_kilobytes;
+  std::vector<double> m_packetsRaw;
+  std::vector<double> m_kilobytesRaw;
+
+  std::mutex m_mutex;
+  std::condition_variable m_hasWork;
+  std::condition_variable m_hasRoom;
+  std::deque<std::vector<uint8_t>> m_queue;
+  bool m_isStopping;
+  std::thread m_thread;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDNSIM_UTILS_TRACERS_NDN_RATE_TRACE_WRITER_HPP